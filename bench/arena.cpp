@@ -0,0 +1,131 @@
+/**
+ * @file bench/arena.cpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#include "bench.hpp"
+
+#include "engine/engine.hpp"
+
+#include <memory>
+#include <unordered_map>
+
+namespace uni {
+namespace bench {
+
+/*
+ * Chunk mesh churn: every frame a few meshes are rebuilt with a new size,
+ * the way they are while players build and dig.
+ */
+static constexpr u32 ARENA_MESHES = 4096;
+static constexpr u32 ARENA_CHURN_PER_FRAME = 64;
+static constexpr u32 ARENA_FRAMES = 256;
+static constexpr u32 VERTEX_STRIDE = 16;
+
+static u32 mesh_vertices(Rng& rng){ return 256 + rng.below(4096); }
+
+void register_arena(Suite& suite){
+	// Allocator only, compaction budget of 1 MiB of vertices per frame. The
+	// range is filled to ~92% first so churn scatters the free space enough
+	// to cross the compaction threshold
+	suite.add("arena/allocator_churn", 1, 10, [&suite](){
+		Rng rng(suite.get_seed());
+		eng::FreeListAllocator allocator(u64(ARENA_MESHES) * 2500);
+		std::vector<u64> offsets(ARENA_MESHES, ~0ull);
+		std::unordered_map<u64, u32> owner;
+		std::vector<u64> retired;
+		auto place = [&](u32 mesh){
+			auto offset = allocator.allocate(mesh_vertices(rng));
+			offsets[mesh] = offset ? *offset : ~0ull;
+			if(offset){ owner[*offset] = mesh; }
+		};
+		for(u32 mesh = 0; mesh < ARENA_MESHES; mesh++){ place(mesh); }
+
+		u64 moved = 0;
+		f32 fragmentation = 0.0f;
+		for(u32 frame = 0; frame < ARENA_FRAMES; frame++){
+			for(u64 offset : retired){ allocator.free(offset); }
+			retired.clear();
+
+			for(u32 i = 0; i < ARENA_CHURN_PER_FRAME; i++){
+				u32 mesh = rng.below(ARENA_MESHES);
+				if(offsets[mesh] != ~0ull){
+					owner.erase(offsets[mesh]);
+					retired.push_back(offsets[mesh]);
+				}
+				place(mesh);
+			}
+
+			// Only ranges a mesh still owns move, retired ones are freed next frame
+			if(allocator.fragmentation() > 0.3f){
+				auto live = [&owner](u64 offset){ return owner.count(offset) > 0; };
+				for(const auto& move : allocator.compact((1 << 20) / VERTEX_STRIDE, live)){
+					auto it = owner.find(move.src);
+					u32 mesh = it->second;
+					owner.erase(it);
+					owner[move.dst] = mesh;
+					offsets[mesh] = move.dst;
+					retired.push_back(move.src);
+					moved += move.size * VERTEX_STRIDE;
+				}
+			}
+			fragmentation += allocator.fragmentation();
+		}
+		suite.counter("fragmentation", fragmentation / ARENA_FRAMES);
+		suite.counter("bytes_moved_per_frame", static_cast<f64>(moved) / ARENA_FRAMES);
+	});
+
+	// Full arena on the device, one submit per simulated frame
+	struct State {
+		std::unique_ptr<eng::Window> window;
+		std::unique_ptr<eng::Device> device;
+		std::unique_ptr<eng::StagingRing> staging;
+		std::unique_ptr<eng::MeshArena> arena;
+		std::vector<eng::MeshId> meshes;
+		std::vector<u8> vertices;
+		std::vector<u32> indices;
+		u64 frame = 0;
+	};
+	auto state = std::make_shared<State>();
+
+	suite.add("arena/device_frame", 4, 64, [&suite, state](){
+		Rng rng(suite.get_seed() + state->frame);
+		state->arena->begin_frame(state->frame);
+		state->staging->begin_frame(state->frame);
+
+		for(u32 i = 0; i < ARENA_CHURN_PER_FRAME; i++){
+			eng::MeshId& mesh = state->meshes[rng.below(ARENA_MESHES)];
+			u32 count = mesh_vertices(rng);
+			eng::MeshId id = state->arena->upload(mesh, state->vertices.data(), count, state->indices.data(), count / 4 * 6);
+			if(id != eng::NO_MESH){ mesh = id; }
+		}
+
+		VkCommandBuffer command_buffer = state->device->begin_single_time_commands();
+		state->arena->record(command_buffer);
+		state->device->end_single_time_commands(command_buffer);
+		state->frame++;
+
+		const auto& stats = state->arena->get_stats();
+		suite.counter("fragmentation", std::max(stats.vertex_fragmentation, stats.index_fragmentation));
+		suite.counter("bytes_moved", static_cast<f64>(stats.bytes_moved));
+		suite.counter("bytes_uploaded", static_cast<f64>(stats.bytes_uploaded));
+	}, [state](){
+		state->window = std::make_unique<eng::Window>(100, 100, "bench");
+		state->device = std::make_unique<eng::Device>(*state->window);
+		state->staging = std::make_unique<eng::StagingRing>(*state->device, 64 << 20);
+
+		eng::MeshArenaConfig config;
+		config.vertex_stride = VERTEX_STRIDE;
+		config.vertex_capacity = u64(ARENA_MESHES) * 3000;
+		config.index_capacity = config.vertex_capacity * 3 / 2;
+		state->arena = std::make_unique<eng::MeshArena>(*state->device, *state->staging, config);
+
+		state->vertices.resize(4352 * VERTEX_STRIDE);
+		state->indices.resize(4352 / 4 * 6);
+		state->meshes.assign(ARENA_MESHES, eng::NO_MESH);
+	});
+}
+
+}	// namespace bench
+}	// namespace uni
@@ -0,0 +1,72 @@
+/**
+ * @brief entry for benchmarks
+ * @file bench/bench.cpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ *
+ * Usage: bench.bin [--filter <substring>] [--warmup <n>] [--reps <n>]
+ *                  [--seed <n>] [--json <path>]
+ */
+
+#include "bench.hpp"
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+#ifndef UNI_COMMIT
+#define UNI_COMMIT "unknown"
+#endif
+
+int main(int argc, const char** argv){
+	std::string filter;
+	std::string json_path;
+	u32 warmup = 0;
+	u32 repetitions = 0;
+	u64 seed = 0x756e69637261667full;
+
+	for(int i = 1; i < argc; i++){
+		std::string arg = argv[i];
+		if(i + 1 >= argc){
+			ERROR("BENCH", "Missing value for " << arg);
+			return 1;
+		}
+		if(arg == "--filter"){ filter = argv[++i]; }
+		else if(arg == "--json"){ json_path = argv[++i]; }
+		else if(arg == "--warmup"){ warmup = std::strtoul(argv[++i], nullptr, 10); }
+		else if(arg == "--reps"){ repetitions = std::strtoul(argv[++i], nullptr, 10); }
+		else if(arg == "--seed"){ seed = std::strtoull(argv[++i], nullptr, 10); }
+		else {
+			ERROR("BENCH", "Unknown argument " << arg);
+			return 1;
+		}
+	}
+
+	uni::bench::Suite suite(seed);
+	suite.override_counts(warmup, repetitions);
+
+	uni::bench::register_engine(suite);
+	uni::bench::register_arena(suite);
+	uni::bench::register_world(suite);
+	uni::bench::register_ecs(suite);
+	uni::bench::register_entity(suite);
+	uni::bench::register_net(suite);
+	uni::bench::register_mesh(suite);
+	uni::bench::register_window(suite);
+	uni::bench::register_far(suite);
+	uni::bench::register_targets(suite);
+
+	suite.run(filter, std::cerr);
+
+	if(!json_path.empty()){
+		std::ofstream out(json_path);
+		if(!out){
+			ERROR("BENCH", "Failed to open " << json_path);
+			return 1;
+		}
+		suite.write_json(out, UNI_COMMIT);
+	} else {
+		suite.write_json(std::cout, UNI_COMMIT);
+	}
+	return 0;
+}
@@ -0,0 +1,247 @@
+/**
+ * @file bench/bench.hpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#pragma once
+
+#include "util/util.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace uni {
+namespace bench {
+
+/**
+ * @brief Deterministic random number generator (splitmix64)
+ *
+ * Every workload seeds one of these from the suite seed so the same
+ * commit always benchmarks the same data.
+ */
+class Rng {
+public:
+	explicit Rng(u64 seed) : state{seed} {}
+
+	u64 next(){
+		u64 z = (state += 0x9e3779b97f4a7c15ull);
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+		return z ^ (z >> 31);
+	}
+
+	/**
+	 * @brief Uniform float in [lo, hi)
+	 */
+	f32 uniform(f32 lo, f32 hi){
+		return lo + (hi - lo) * static_cast<f32>(next() >> 40) / static_cast<f32>(1ull << 24);
+	}
+
+	/**
+	 * @brief Uniform integer in [0, n)
+	 */
+	u32 below(u32 n){ return static_cast<u32>(next() % n); }
+
+private:
+	u64 state;
+};
+
+/**
+ * @brief Timings of one benchmark, all durations in nanoseconds
+ */
+struct Result {
+	std::string name;
+	u32 warmup = 0;
+	u32 repetitions = 0;
+	f64 min = 0.0;
+	f64 median = 0.0;
+	f64 p99 = 0.0;
+	f64 max = 0.0;
+	f64 mean = 0.0;
+	std::map<std::string, f64> counters;
+};
+
+/**
+ * @brief A registered workload
+ *
+ * `setup` runs once before warmup and may be empty. `body` is the timed
+ * region and runs once per warmup and once per repetition. `teardown`
+ * runs once after the last repetition, may be empty, and stops whatever
+ * `setup` left running so it does not skew the benchmarks after it.
+ */
+struct Benchmark {
+	std::string name;
+	u32 warmup;
+	u32 repetitions;
+	std::function<void()> setup;
+	std::function<void()> body;
+	std::function<void()> teardown;
+};
+
+/**
+ * @brief Collection of benchmarks with shared settings
+ */
+class Suite {
+public:
+	explicit Suite(u64 seed) : seed{seed} {}
+
+	u64 get_seed() const { return seed; }
+
+	/**
+	 * @brief Registers a benchmark
+	 * @param[in] name Unique name, `group/workload`
+	 * @param[in] warmup Untimed runs before measuring
+	 * @param[in] repetitions Timed runs
+	 * @param[in] body Timed region
+	 * @param[in] setup Untimed preparation, run once
+	 * @param[in] teardown Untimed cleanup, run once after the last repetition
+	 */
+	void add(const std::string& name, u32 warmup, u32 repetitions, std::function<void()> body, std::function<void()> setup = {}, std::function<void()> teardown = {}){
+		benchmarks.push_back({name, warmup, repetitions, std::move(setup), std::move(body), std::move(teardown)});
+	}
+
+	/**
+	 * @brief Attaches a named metric to the benchmark currently running
+	 *
+	 * Used for things that are not durations such as bytes moved or hit rates.
+	 * The last value reported during the timed repetitions wins.
+	 */
+	void counter(const std::string& key, f64 value){
+		if(current != nullptr){ current->counters[key] = value; }
+	}
+
+	/**
+	 * @brief Overrides warmup and repetition counts of every benchmark
+	 * @note Zero keeps the registered value
+	 */
+	void override_counts(u32 warmup, u32 repetitions){
+		forced_warmup = warmup;
+		forced_repetitions = repetitions;
+	}
+
+	/**
+	 * @brief Runs every benchmark whose name contains `filter`
+	 * @param[in] filter Substring to match, empty runs all
+	 * @param[in] log Human readable progress output
+	 */
+	void run(const std::string& filter, std::ostream& log){
+		for(auto& benchmark : benchmarks){
+			if(!filter.empty() && benchmark.name.find(filter) == std::string::npos){ continue; }
+
+			Result result;
+			result.name = benchmark.name;
+			result.warmup = forced_warmup ? forced_warmup : benchmark.warmup;
+			result.repetitions = forced_repetitions ? forced_repetitions : benchmark.repetitions;
+			current = &result;
+
+			if(benchmark.setup){ benchmark.setup(); }
+			for(u32 i = 0; i < result.warmup; i++){ benchmark.body(); }
+
+			std::vector<f64> samples;
+			samples.reserve(result.repetitions);
+			for(u32 i = 0; i < result.repetitions; i++){
+				auto start = std::chrono::steady_clock::now();
+				benchmark.body();
+				auto end = std::chrono::steady_clock::now();
+				samples.push_back(std::chrono::duration<f64, std::nano>(end - start).count());
+			}
+			summarize(samples, result);
+			current = nullptr;
+			if(benchmark.teardown){ benchmark.teardown(); }
+
+			log << result.name << ": median " << result.median / 1e6 << " ms, p99 " << result.p99 / 1e6 << " ms";
+			for(const auto& [key, value] : result.counters){ log << ", " << key << " " << value; }
+			log << '\n';
+			results.push_back(std::move(result));
+		}
+	}
+
+	/**
+	 * @brief Writes all results as a single JSON document
+	 * @param[out] out Stream to write to
+	 * @param[in] commit Revision the binary was built from
+	 */
+	void write_json(std::ostream& out, const std::string& commit) const {
+		out << "{\n  \"commit\": \"" << commit << "\",\n  \"seed\": " << seed << ",\n  \"unit\": \"ns\",\n  \"results\": [";
+		for(size_t i = 0; i < results.size(); i++){
+			const Result& r = results[i];
+			out << (i ? ",\n" : "\n") << "    {\"name\": \"" << r.name << "\""
+				<< ", \"warmup\": " << r.warmup
+				<< ", \"repetitions\": " << r.repetitions
+				<< ", \"min\": " << r.min
+				<< ", \"median\": " << r.median
+				<< ", \"p99\": " << r.p99
+				<< ", \"max\": " << r.max
+				<< ", \"mean\": " << r.mean
+				<< ", \"counters\": {";
+			bool first = true;
+			for(const auto& [key, value] : r.counters){
+				out << (first ? "" : ", ") << "\"" << key << "\": " << value;
+				first = false;
+			}
+			out << "}}";
+		}
+		out << "\n  ]\n}\n";
+	}
+
+private:
+	/**
+	 * @brief Fills the statistics of `result` from raw samples
+	 *
+	 * Percentiles use the nearest-rank method so p99 of fewer than
+	 * 100 samples is the maximum.
+	 */
+	static void summarize(std::vector<f64>& samples, Result& result){
+		if(samples.empty()){ return; }
+		std::sort(samples.begin(), samples.end());
+		auto rank = [&](f64 p){
+			size_t index = static_cast<size_t>(p * samples.size() + 0.999999);
+			return samples[std::min(samples.size(), std::max<size_t>(index, 1)) - 1];
+		};
+		f64 total = 0.0;
+		for(f64 s : samples){ total += s; }
+		result.min = samples.front();
+		result.max = samples.back();
+		result.median = rank(0.5);
+		result.p99 = rank(0.99);
+		result.mean = total / samples.size();
+	}
+
+	u64 seed;
+	u32 forced_warmup = 0;
+	u32 forced_repetitions = 0;
+	Result* current = nullptr;
+	std::vector<Benchmark> benchmarks;
+	std::vector<Result> results;
+};
+
+/**
+ * @brief Prevents the compiler from optimizing away a computed value
+ */
+template<typename T>
+inline void keep(const T& value){
+	asm volatile("" : : "g"(&value) : "memory");
+}
+
+/*
+ * Workload groups, each defined in its own translation unit
+ */
+void register_engine(Suite& suite);
+void register_arena(Suite& suite);
+void register_world(Suite& suite);
+void register_ecs(Suite& suite);
+void register_entity(Suite& suite);
+void register_net(Suite& suite);
+void register_mesh(Suite& suite);
+void register_window(Suite& suite);
+void register_far(Suite& suite);
+void register_targets(Suite& suite);
+
+}	// namespace bench
+}	// namespace uni
@@ -0,0 +1,90 @@
+/**
+ * @file bench/ecs.cpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#include "bench.hpp"
+
+#include "ecs/command_buffer.hpp"
+#include "ecs/components.hpp"
+
+#include <memory>
+
+namespace uni {
+namespace bench {
+
+static constexpr u32 ECS_ENTITIES = 100000;
+static constexpr f32 TICK = 1.0f / 20.0f;
+static constexpr f32 GROUND = 64.0f;
+
+/**
+ * @brief One server tick of movement for everything with a collider
+ *
+ * Gravity, integration and a flat ground plane. Anything that falls out
+ * of the world is despawned through the worker's command buffer.
+ */
+static void tick(u32 count, const ecs::Entity* entities, ecs::Position* p, ecs::Velocity* v, ecs::Collider* c, ecs::CommandBuffer& commands){
+	for(u32 i = 0; i < count; i++){
+		v[i].value.y -= 32.0f * TICK;
+		p[i].value += v[i].value * TICK;
+
+		c[i].on_ground = p[i].value.y <= GROUND;
+		if(c[i].on_ground){
+			p[i].value.y = GROUND;
+			v[i].value.y = 0.0f;
+			v[i].value.x *= 0.6f;
+			v[i].value.z *= 0.6f;
+		}
+		if(p[i].value.x * p[i].value.x + p[i].value.z * p[i].value.z > 1e8f){
+			commands.destroy(entities[i]);
+		}
+	}
+}
+
+void register_ecs(Suite& suite){
+	struct State {
+		ecs::Registry registry;
+		std::unique_ptr<ThreadPool> pool;
+		std::vector<ecs::CommandBuffer> commands;
+	};
+	auto state = std::make_shared<State>();
+
+	auto setup = [&suite, state](){
+		if(state->registry.size() > 0){ return; }
+		state->pool = std::make_unique<ThreadPool>();
+		state->commands.resize(state->pool->size());
+
+		Rng rng(suite.get_seed());
+		for(u32 i = 0; i < ECS_ENTITIES; i++){
+			ecs::Position p{{rng.uniform(-512.0f, 512.0f), rng.uniform(64.0f, 96.0f), rng.uniform(-512.0f, 512.0f)}};
+			ecs::Velocity v{{rng.uniform(-4.0f, 4.0f), rng.uniform(0.0f, 8.0f), rng.uniform(-4.0f, 4.0f)}};
+			// Roughly a third are item drops, the rest mobs
+			if(rng.below(3) == 0){
+				state->registry.create(p, v, ecs::Collider{{0.125f, 0.25f, 0.125f}}, ecs::DroppedItem{world::DIRT, 1, 0.0f});
+			} else {
+				state->registry.create(p, v, ecs::Collider{{0.3f, 0.9f, 0.3f}}, ecs::Mob{0, 20});
+			}
+		}
+	};
+
+	suite.add("ecs/tick_100k_serial", 5, 100, [&suite, state](){
+		state->registry.each_chunk<ecs::Position, ecs::Velocity, ecs::Collider>([&](u32 count, const ecs::Entity* e, ecs::Position* p, ecs::Velocity* v, ecs::Collider* c){
+			tick(count, e, p, v, c, state->commands[0]);
+		});
+		state->commands[0].flush(state->registry);
+		suite.counter("entities", static_cast<f64>(state->registry.size()));
+	}, setup);
+
+	suite.add("ecs/tick_100k_parallel", 5, 100, [&suite, state](){
+		state->registry.par_each_chunk<ecs::Position, ecs::Velocity, ecs::Collider>(*state->pool, [&](u32 worker, u32 count, const ecs::Entity* e, ecs::Position* p, ecs::Velocity* v, ecs::Collider* c){
+			tick(count, e, p, v, c, state->commands[worker]);
+		});
+		for(auto& commands : state->commands){ commands.flush(state->registry); }
+		suite.counter("entities", static_cast<f64>(state->registry.size()));
+		suite.counter("threads", state->pool->size());
+	}, setup);
+}
+
+}	// namespace bench
+}	// namespace uni
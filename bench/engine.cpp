@@ -0,0 +1,29 @@
+/**
+ * @file bench/engine.cpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#include "bench.hpp"
+
+#include "engine/engine.hpp"
+
+namespace uni {
+namespace bench {
+
+void register_engine(Suite& suite){
+	// GLFW init + window creation, the floor of every startup below
+	suite.add("engine/window_create", 1, 10, [](){
+		eng::Window window(100, 100, "bench");
+	});
+
+	// Instance, debug messenger, surface, physical device pick and logical device
+	suite.add("engine/device_startup", 1, 10, [](){
+		eng::Window window(100, 100, "bench");
+		eng::Device device(window);
+		keep(device.get_device());
+	});
+}
+
+}	// namespace bench
+}	// namespace uni
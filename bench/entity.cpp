@@ -0,0 +1,246 @@
+/**
+ * @file bench/entity.cpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#include "bench.hpp"
+
+#include "ecs/components.hpp"
+#include "ecs/ecs.hpp"
+#include "engine/engine.hpp"
+
+#include <memory>
+
+namespace uni {
+namespace bench {
+
+static constexpr u32 VISIBLE_ENTITIES = 50000;
+static constexpr u32 MOB_TYPES = 3;
+static constexpr u32 FRAMES_IN_FLIGHT = 2;
+
+/**
+ * @brief Unit cube around the origin, 4 vertices per face
+ */
+static void cube_mesh(u32 color, std::vector<eng::EntityVertex>& vertices, std::vector<u32>& indices){
+	for(int axis = 0; axis < 3; axis++){
+		for(int side = 0; side < 2; side++){
+			u32 base = static_cast<u32>(vertices.size());
+			int a1 = (axis + 1) % 3, a2 = (axis + 2) % 3;
+			for(int corner = 0; corner < 4; corner++){
+				eng::EntityVertex v = {};
+				v.position[axis] = side ? 0.5f : -0.5f;
+				v.position[a1] = (corner & 1) ? 0.5f : -0.5f;
+				v.position[a2] = (corner & 2) ? 0.5f : -0.5f;
+				v.color = color;
+				vertices.push_back(v);
+			}
+			// Counter clockwise seen from outside the cube
+			static const u32 positive[6] = {0, 1, 3, 0, 3, 2};
+			static const u32 negative[6] = {0, 3, 1, 0, 2, 3};
+			for(u32 i : side ? positive : negative){ indices.push_back(base + i); }
+		}
+	}
+}
+
+/**
+ * @brief Render pass with one color attachment the instance pipeline is built against
+ */
+static VkRenderPass create_render_pass(eng::Device& device){
+	VkAttachmentDescription color = {};
+	color.format = VK_FORMAT_R8G8B8A8_UNORM;
+	color.samples = VK_SAMPLE_COUNT_1_BIT;
+	color.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+	color.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+	color.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+	color.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+	color.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+	color.finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+	VkAttachmentReference reference = {0, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL};
+	VkSubpassDescription subpass = {};
+	subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+	subpass.colorAttachmentCount = 1;
+	subpass.pColorAttachments = &reference;
+
+	VkRenderPassCreateInfo create_info = {};
+	create_info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+	create_info.attachmentCount = 1;
+	create_info.pAttachments = &color;
+	create_info.subpassCount = 1;
+	create_info.pSubpasses = &subpass;
+
+	VkRenderPass render_pass;
+	if(vkCreateRenderPass(device.get_device(), &create_info, nullptr, &render_pass) != VK_SUCCESS){
+		ERROR("BENCH", "Failed to create render pass.");
+		throw std::exception();
+	}
+	return render_pass;
+}
+
+void register_entity(Suite& suite){
+	/*
+	 * One frame of entity rendering as the client would run it: gather
+	 * every mob and item from the ECS into the instance buffer, record and
+	 * submit the cull pass and record the draws. The draws go into a
+	 * secondary command buffer since there is no swapchain to render to,
+	 * which is the same CPU work. Frames overlap the way they do with two
+	 * frames in flight.
+	 */
+	struct State {
+		std::unique_ptr<eng::Window> window;
+		std::unique_ptr<eng::Device> device;
+		std::unique_ptr<eng::StagingRing> staging;
+		std::unique_ptr<eng::MeshArena> arena;
+		std::unique_ptr<eng::InstanceRenderer> renderer;
+		ecs::Registry registry;
+		VkRenderPass render_pass = VK_NULL_HANDLE;
+		VkCommandBuffer primary[FRAMES_IN_FLIGHT];
+		VkCommandBuffer secondary[FRAMES_IN_FLIGHT];
+		VkFence fences[FRAMES_IN_FLIGHT];
+		u32 mob_types[MOB_TYPES];
+		u32 item_type;
+		u64 frame = 0;
+
+		~State(){
+			if(!device){ return; }
+			vkDeviceWaitIdle(device->get_device());
+			for(u32 i = 0; i < FRAMES_IN_FLIGHT; i++){ vkDestroyFence(device->get_device(), fences[i], nullptr); }
+			vkFreeCommandBuffers(device->get_device(), device->get_command_pool(), FRAMES_IN_FLIGHT, primary);
+			vkFreeCommandBuffers(device->get_device(), device->get_command_pool(), FRAMES_IN_FLIGHT, secondary);
+			vkDestroyRenderPass(device->get_device(), render_pass, nullptr);
+		}
+	};
+	auto state = std::make_shared<State>();
+
+	Mat4 view_proj = Mat4::perspective(1.2f, 16.0f / 9.0f, 0.1f, 512.0f) * Mat4::look_at({0.0f, 80.0f, 0.0f}, {0.0f, 80.0f, 1.0f}, {0.0f, 1.0f, 0.0f});
+
+	suite.add("entity/instanced_frame_50k", 8, 128, [&suite, state, view_proj](){
+		u32 slot = state->frame % FRAMES_IN_FLIGHT;
+		VkDevice device = state->device->get_device();
+		vkWaitForFences(device, 1, &state->fences[slot], VK_TRUE, ~0ull);
+		vkResetFences(device, 1, &state->fences[slot]);
+
+		state->staging->begin_frame(state->frame);
+		state->arena->begin_frame(state->frame);
+		state->renderer->begin_frame(state->frame);
+
+		eng::InstanceRenderer& renderer = *state->renderer;
+		f32 time = state->frame / 60.0f;
+		state->registry.each_chunk<ecs::Position, ecs::Velocity, ecs::Mob>([&](u32 count, const ecs::Entity*, ecs::Position* p, ecs::Velocity* v, ecs::Mob* m){
+			for(u32 i = 0; i < count; i++){
+				eng::InstanceData instance;
+				instance.position = p[i].value;
+				instance.yaw = std::atan2(v[i].value.x, v[i].value.z);
+				instance.anim_time = time;
+				instance.anim_state = v[i].value.x != 0.0f || v[i].value.z != 0.0f;
+				instance.type = state->mob_types[m[i].type];
+				renderer.push(instance);
+			}
+		});
+		state->registry.each_chunk<ecs::Position, ecs::DroppedItem>([&](u32 count, const ecs::Entity*, ecs::Position* p, ecs::DroppedItem* item){
+			for(u32 i = 0; i < count; i++){
+				eng::InstanceData instance;
+				instance.position = p[i].value;
+				instance.yaw = item[i].age;
+				instance.scale = 0.25f;
+				instance.type = state->item_type;
+				renderer.push(instance);
+			}
+		});
+
+		VkCommandBufferBeginInfo begin_info = {};
+		begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+		vkResetCommandBuffer(state->primary[slot], 0);
+		vkBeginCommandBuffer(state->primary[slot], &begin_info);
+		state->arena->record(state->primary[slot]);
+		renderer.record_cull(state->primary[slot], Frustum::from(view_proj));
+		vkEndCommandBuffer(state->primary[slot]);
+
+		VkSubmitInfo submit_info = {};
+		submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		submit_info.commandBufferCount = 1;
+		submit_info.pCommandBuffers = &state->primary[slot];
+		vkQueueSubmit(state->device->get_graphics_queue(), 1, &submit_info, state->fences[slot]);
+
+		VkCommandBufferInheritanceInfo inheritance = {};
+		inheritance.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+		inheritance.renderPass = state->render_pass;
+		begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+		begin_info.pInheritanceInfo = &inheritance;
+		vkResetCommandBuffer(state->secondary[slot], 0);
+		vkBeginCommandBuffer(state->secondary[slot], &begin_info);
+		VkViewport viewport = {0.0f, 0.0f, 1920.0f, 1080.0f, 0.0f, 1.0f};
+		VkRect2D scissor = {{0, 0}, {1920, 1080}};
+		vkCmdSetViewport(state->secondary[slot], 0, 1, &viewport);
+		vkCmdSetScissor(state->secondary[slot], 0, 1, &scissor);
+		renderer.record_draw(state->secondary[slot], view_proj);
+		vkEndCommandBuffer(state->secondary[slot]);
+		state->frame++;
+
+		const auto& stats = renderer.get_stats();
+		suite.counter("instances", stats.instances);
+		suite.counter("draw_calls", stats.draw_calls);
+	}, [&suite, state](){
+		state->window = std::make_unique<eng::Window>(100, 100, "bench");
+		state->device = std::make_unique<eng::Device>(*state->window);
+		state->staging = std::make_unique<eng::StagingRing>(*state->device, 4 << 20, FRAMES_IN_FLIGHT);
+
+		eng::MeshArenaConfig arena_config;
+		arena_config.vertex_stride = sizeof(eng::EntityVertex);
+		arena_config.vertex_capacity = 1 << 12;
+		arena_config.index_capacity = 1 << 12;
+		arena_config.frames_in_flight = FRAMES_IN_FLIGHT;
+		state->arena = std::make_unique<eng::MeshArena>(*state->device, *state->staging, arena_config);
+
+		state->render_pass = create_render_pass(*state->device);
+		eng::InstanceRendererConfig config;
+		config.render_pass = state->render_pass;
+		config.frames_in_flight = FRAMES_IN_FLIGHT;
+		state->renderer = std::make_unique<eng::InstanceRenderer>(*state->device, *state->arena, config);
+
+		// One cube per type, a real game has a model per mob
+		const u32 colors[MOB_TYPES + 1] = {0xff3a7a3au, 0xff7a3a3au, 0xff3a3a7au, 0xff6a9ab0u};
+		for(u32 t = 0; t <= MOB_TYPES; t++){
+			std::vector<eng::EntityVertex> vertices;
+			std::vector<u32> indices;
+			cube_mesh(colors[t], vertices, indices);
+			eng::MeshId mesh = state->arena->upload(eng::NO_MESH, vertices.data(), static_cast<u32>(vertices.size()), indices.data(), static_cast<u32>(indices.size()));
+			u32 type = state->renderer->add_mesh_type(mesh, 0.87f);
+			if(t < MOB_TYPES){ state->mob_types[t] = type; } else { state->item_type = type; }
+		}
+
+		// Everything inside the camera's view, 5 to 200 blocks away
+		Rng rng(suite.get_seed());
+		for(u32 i = 0; i < VISIBLE_ENTITIES; i++){
+			f32 z = rng.uniform(5.0f, 200.0f);
+			ecs::Position p{{rng.uniform(-0.5f, 0.5f) * z, 80.0f + rng.uniform(-0.3f, 0.3f) * z, z}};
+			if(rng.below(4) == 0){
+				state->registry.create(p, ecs::DroppedItem{world::DIRT, 1, rng.uniform(0.0f, 6.0f)});
+			} else {
+				ecs::Velocity v{{rng.uniform(-1.0f, 1.0f), 0.0f, rng.uniform(-1.0f, 1.0f)}};
+				state->registry.create(p, v, ecs::Mob{static_cast<u16>(rng.below(MOB_TYPES)), 20});
+			}
+		}
+
+		VkCommandBufferAllocateInfo allocate_info = {};
+		allocate_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+		allocate_info.commandPool = state->device->get_command_pool();
+		allocate_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+		allocate_info.commandBufferCount = FRAMES_IN_FLIGHT;
+		vkAllocateCommandBuffers(state->device->get_device(), &allocate_info, state->primary);
+		allocate_info.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+		vkAllocateCommandBuffers(state->device->get_device(), &allocate_info, state->secondary);
+
+		VkFenceCreateInfo fence_info = {};
+		fence_info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+		fence_info.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+		for(u32 i = 0; i < FRAMES_IN_FLIGHT; i++){
+			vkCreateFence(state->device->get_device(), &fence_info, nullptr, &state->fences[i]);
+		}
+	});
+}
+
+}	// namespace bench
+}	// namespace uni
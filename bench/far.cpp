@@ -0,0 +1,354 @@
+/**
+ * @file bench/far.cpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#include "bench.hpp"
+
+#include "engine/engine.hpp"
+#include "world/world.hpp"
+
+#include <cmath>
+#include <memory>
+
+namespace uni {
+namespace bench {
+
+// 16x16 chunks, 256 by 256 blocks, a block is 1 m
+static constexpr s32 FAR_RADIUS = 8;
+static constexpr u32 WIDTH = 1920;
+static constexpr u32 HEIGHT = 1080;
+
+static f64 area_km2(u32 columns){
+	return columns * f64(world::SECTION_SIZE * world::SECTION_SIZE) / 1e6;
+}
+
+static void generate_far_world(world::ChunkStore& store, u64 seed){
+	world::Generator generator(seed);
+	for(s32 cx = -FAR_RADIUS; cx < FAR_RADIUS; cx++){
+		for(s32 cz = -FAR_RADIUS; cz < FAR_RADIUS; cz++){
+			generator.generate(store.create({cx, cz}));
+		}
+	}
+}
+
+/**
+ * @brief The same terrain at half resolution, one block per far field cell
+ *
+ * What an LOD mesh at the far field's resolution is built from.
+ */
+static void downsample_world(const world::ChunkStore& store, world::ChunkStore& out){
+	for(const auto& [pos, chunk] : store){
+		for(s32 sy = 0; sy < world::CHUNK_SECTIONS; sy++){
+			const world::Section* section = chunk->get_section(sy);
+			if(section == nullptr || section->empty()){ continue; }
+			for(s32 y = 0; y < world::FAR_BRICK_CELLS; y++){
+				for(s32 z = 0; z < world::FAR_BRICK_CELLS; z++){
+					for(s32 x = 0; x < world::FAR_BRICK_CELLS; x++){
+						world::BlockId block = world::downsample_cell(*section, x, y, z);
+						if(block == world::AIR){ continue; }
+						s32 wx = pos.x * world::FAR_BRICK_CELLS + x, wz = pos.z * world::FAR_BRICK_CELLS + z;
+						world::ChunkPos lod = {wx >> 4, wz >> 4};
+						if(out.get_chunk(lod) == nullptr){ out.create(lod); }
+						out.set_block(wx, sy * world::FAR_BRICK_CELLS + y, wz, block);
+					}
+				}
+			}
+		}
+	}
+}
+
+/**
+ * @brief Offscreen 1080p color and depth the near field would draw into
+ */
+struct FarTarget {
+	eng::Device* device = nullptr;
+	VkImage images[2];
+	VkDeviceMemory memory[2];
+	VkImageView views[2];
+	VkRenderPass render_pass = VK_NULL_HANDLE;
+	VkFramebuffer framebuffer = VK_NULL_HANDLE;
+
+	void create(eng::Device& d){
+		device = &d;
+		const VkFormat formats[2] = {VK_FORMAT_R8G8B8A8_UNORM, VK_FORMAT_D32_SFLOAT};
+		const VkImageUsageFlags usages[2] = {
+			VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_STORAGE_BIT,
+			VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT
+		};
+		const VkImageAspectFlags aspects[2] = {VK_IMAGE_ASPECT_COLOR_BIT, VK_IMAGE_ASPECT_DEPTH_BIT};
+		for(int i = 0; i < 2; i++){
+			VkImageCreateInfo info = {};
+			info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+			info.imageType = VK_IMAGE_TYPE_2D;
+			info.format = formats[i];
+			info.extent = {WIDTH, HEIGHT, 1};
+			info.mipLevels = 1;
+			info.arrayLayers = 1;
+			info.samples = VK_SAMPLE_COUNT_1_BIT;
+			info.tiling = VK_IMAGE_TILING_OPTIMAL;
+			info.usage = usages[i];
+			info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+			info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+			d.create_image(info, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, images[i], memory[i]);
+			views[i] = d.create_image_view(images[i], formats[i], aspects[i]);
+		}
+
+		// Left in the layouts the far field reads them in
+		VkAttachmentDescription attachments[2] = {};
+		for(int i = 0; i < 2; i++){
+			attachments[i].format = formats[i];
+			attachments[i].samples = VK_SAMPLE_COUNT_1_BIT;
+			attachments[i].loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+			attachments[i].storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+			attachments[i].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+			attachments[i].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+			attachments[i].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+		}
+		attachments[0].finalLayout = VK_IMAGE_LAYOUT_GENERAL;
+		attachments[1].finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+
+		VkAttachmentReference color_reference = {0, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL};
+		VkAttachmentReference depth_reference = {1, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL};
+		VkSubpassDescription subpass = {};
+		subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+		subpass.colorAttachmentCount = 1;
+		subpass.pColorAttachments = &color_reference;
+		subpass.pDepthStencilAttachment = &depth_reference;
+
+		VkRenderPassCreateInfo create_info = {};
+		create_info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+		create_info.attachmentCount = 2;
+		create_info.pAttachments = attachments;
+		create_info.subpassCount = 1;
+		create_info.pSubpasses = &subpass;
+		if(vkCreateRenderPass(d.get_device(), &create_info, nullptr, &render_pass) != VK_SUCCESS){
+			ERROR("BENCH", "Failed to create render pass.");
+			throw std::exception();
+		}
+
+		VkFramebufferCreateInfo framebuffer_info = {};
+		framebuffer_info.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+		framebuffer_info.renderPass = render_pass;
+		framebuffer_info.attachmentCount = 2;
+		framebuffer_info.pAttachments = views;
+		framebuffer_info.width = WIDTH;
+		framebuffer_info.height = HEIGHT;
+		framebuffer_info.layers = 1;
+		if(vkCreateFramebuffer(d.get_device(), &framebuffer_info, nullptr, &framebuffer) != VK_SUCCESS){
+			ERROR("BENCH", "Failed to create framebuffer.");
+			throw std::exception();
+		}
+	}
+
+	void begin(VkCommandBuffer command_buffer){
+		VkClearValue clears[2] = {};
+		clears[0].color = {{0.62f, 0.75f, 0.90f, 1.0f}};
+		clears[1].depthStencil = {1.0f, 0};
+		VkRenderPassBeginInfo begin_info = {};
+		begin_info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+		begin_info.renderPass = render_pass;
+		begin_info.framebuffer = framebuffer;
+		begin_info.renderArea = {{0, 0}, {WIDTH, HEIGHT}};
+		begin_info.clearValueCount = 2;
+		begin_info.pClearValues = clears;
+		vkCmdBeginRenderPass(command_buffer, &begin_info, VK_SUBPASS_CONTENTS_INLINE);
+		VkViewport viewport = {0.0f, 0.0f, f32(WIDTH), f32(HEIGHT), 0.0f, 1.0f};
+		VkRect2D scissor = {{0, 0}, {WIDTH, HEIGHT}};
+		vkCmdSetViewport(command_buffer, 0, 1, &viewport);
+		vkCmdSetScissor(command_buffer, 0, 1, &scissor);
+	}
+
+	~FarTarget(){
+		if(device == nullptr){ return; }
+		VkDevice d = device->get_device();
+		vkDeviceWaitIdle(d);
+		vkDestroyFramebuffer(d, framebuffer, nullptr);
+		vkDestroyRenderPass(d, render_pass, nullptr);
+		for(int i = 0; i < 2; i++){
+			vkDestroyImageView(d, views[i], nullptr);
+			vkDestroyImage(d, images[i], nullptr);
+			device->free_memory(memory[i]);
+		}
+	}
+};
+
+void register_far(Suite& suite){
+	struct State {
+		world::ChunkStore store;
+		world::ChunkStore lod;
+		std::unique_ptr<world::Brickmap> map;
+		u64 lod_bytes = 0;
+	};
+	auto state = std::make_shared<State>();
+	auto setup = [&suite, state](){
+		if(state->store.size() > 0){ return; }
+		generate_far_world(state->store, suite.get_seed());
+		downsample_world(state->store, state->lod);
+	};
+
+	world::BrickmapConfig map_config;
+	map_config.grid_chunks = 64;
+	map_config.max_bricks = 1 << 14;
+
+	/*
+	 * Memory is per km² of loaded terrain. The LOD mesh is the same terrain
+	 * at the same 2 m resolution meshed with the section mesher, 4 bytes
+	 * per quad plus one indirect draw per section.
+	 */
+	suite.add("far/brickmap_build", 1, 10, [&suite, state, map_config](){
+		state->map = std::make_unique<world::Brickmap>(map_config);
+		for(const auto& [pos, chunk] : state->store){ state->map->update(state->store, pos); }
+		const world::BrickmapStats& stats = state->map->get_stats();
+		suite.counter("bricks", stats.bricks);
+		suite.counter("uniform", stats.uniform);
+		suite.counter("bytes_per_km2", stats.bytes / area_km2(stats.columns));
+	}, setup);
+
+	suite.add("far/lod_mesh_build", 1, 10, [&suite, state](){
+		std::vector<world::ChunkQuad> quads;
+		u64 total = 0, sections = 0;
+		for(const auto& [pos, chunk] : state->lod){
+			for(s32 sy = 0; sy < world::CHUNK_SECTIONS; sy++){
+				world::mesh_section(world::gather_neighbours(state->lod, pos.x, sy, pos.z), quads);
+				total += quads.size();
+				sections += !quads.empty();
+			}
+		}
+		state->lod_bytes = total * sizeof(world::ChunkQuad) + sections * sizeof(eng::SectionDraw);
+		suite.counter("quads", static_cast<f64>(total));
+		suite.counter("bytes_per_km2", state->lod_bytes / area_km2(static_cast<u32>(state->store.size())));
+	}, setup);
+
+	// One block placed in a different chunk every repetition
+	suite.add("far/brickmap_update_chunk", 10, 1000, [&suite, state](){
+		static u32 n = 0;
+		s32 cx = static_cast<s32>(n % (2 * FAR_RADIUS)) - FAR_RADIUS, cz = static_cast<s32>(n / (2 * FAR_RADIUS) % (2 * FAR_RADIUS)) - FAR_RADIUS;
+		n++;
+		state->store.set_block(cx * 16 + 8, 120, cz * 16 + 8, n & 1 ? world::STONE : world::AIR);
+		state->map->update(state->store, {cx, cz});
+		std::vector<u32> dirty;
+		state->map->take_dirty_bricks(dirty, ~size_t(0));
+		suite.counter("bricks_uploaded", static_cast<f64>(dirty.size()));
+		dirty.clear();
+		state->map->take_dirty_columns(dirty, ~size_t(0));
+	}, [&suite, state, setup, map_config](){
+		setup();
+		if(state->map){ return; }
+		state->map = std::make_unique<world::Brickmap>(map_config);
+		for(const auto& [pos, chunk] : state->store){ state->map->update(state->store, pos); }
+	});
+
+	/*
+	 * GPU frame time over the whole world from one corner, the far field
+	 * marching every pixel against LOD meshes drawn into the same 1080p
+	 * target. The LOD world is half scale, so is the camera. One submit
+	 * per repetition and waited on.
+	 */
+	struct GpuState {
+		std::unique_ptr<eng::Window> window;
+		std::unique_ptr<eng::Device> device;
+		std::unique_ptr<eng::StagingRing> staging;
+		std::unique_ptr<FarTarget> target;
+		std::unique_ptr<eng::FarField> far;
+		std::unique_ptr<eng::GpuMesher> mesher;
+		std::unique_ptr<world::Brickmap> map;
+		u64 frame = 0;
+	};
+	auto gpu = std::make_shared<GpuState>();
+
+	const Vec3 eye = {-128.0f, 110.0f, -128.0f};
+	const Vec3 target = {128.0f, 40.0f, 128.0f};
+	const f32 fov = 1.2f, aspect = f32(WIDTH) / HEIGHT, near = 0.1f, far = 512.0f;
+
+	auto gpu_setup = [&suite, state, gpu, setup, map_config, eye, target](){
+		setup();
+		if(gpu->device){ return; }
+		gpu->window = std::make_unique<eng::Window>(100, 100, "bench");
+		gpu->device = std::make_unique<eng::Device>(*gpu->window);
+		gpu->staging = std::make_unique<eng::StagingRing>(*gpu->device, 32 << 20, 1);
+		gpu->target = std::make_unique<FarTarget>();
+		gpu->target->create(*gpu->device);
+
+		world::BrickmapConfig gpu_config = map_config;
+		gpu_config.deferred_reuse = true;
+		gpu->map = std::make_unique<world::Brickmap>(gpu_config);
+		for(const auto& [pos, chunk] : state->store){ gpu->map->update(state->store, pos); }
+		eng::FarFieldConfig far_config;
+		far_config.bricks_per_frame = map_config.max_bricks;
+		far_config.columns_per_frame = map_config.grid_chunks * map_config.grid_chunks;
+		far_config.frames_in_flight = 1;
+		gpu->far = std::make_unique<eng::FarField>(*gpu->device, *gpu->staging, *gpu->map, far_config);
+
+		eng::GpuMesherConfig mesher_config;
+		mesher_config.render_pass = gpu->target->render_pass;
+		mesher_config.max_sections = 4096;
+		mesher_config.quad_capacity = 1 << 22;
+		mesher_config.jobs_per_frame = 4096;
+		mesher_config.upload_bytes = 24 << 20;
+		mesher_config.frames_in_flight = 1;
+		gpu->mesher = std::make_unique<eng::GpuMesher>(*gpu->device, *gpu->staging, mesher_config);
+
+		// Everything uploaded and meshed once, the frames only draw
+		gpu->staging->begin_frame(gpu->frame);
+		gpu->far->begin_frame(gpu->frame);
+		gpu->mesher->begin_frame(gpu->frame);
+		gpu->far->upload(*gpu->map);
+		for(const auto& [pos, chunk] : state->lod){
+			for(s32 sy = 0; sy < world::CHUNK_SECTIONS; sy++){
+				eng::MeshId id = eng::NO_MESH;
+				gpu->mesher->mesh(id, world::gather_neighbours(state->lod, pos.x, sy, pos.z), pos.x, sy, pos.z);
+			}
+		}
+		VkCommandBuffer command_buffer = gpu->device->begin_single_time_commands();
+		gpu->mesher->record(command_buffer);
+		gpu->device->end_single_time_commands(command_buffer);
+		gpu->frame++;
+	};
+
+	suite.add("far/gpu_march_1080p", 2, 20, [&suite, gpu, eye, target, fov, aspect, near, far](){
+		gpu->staging->begin_frame(gpu->frame);
+		gpu->far->begin_frame(gpu->frame);
+		gpu->far->upload(*gpu->map);
+
+		eng::FarFieldView view;
+		view.eye = eye;
+		view.forward = (target - eye).normalized();
+		view.right = cross(view.forward, {0.0f, 1.0f, 0.0f}).normalized() * (std::tan(fov * 0.5f) * aspect);
+		view.up = cross(view.right, view.forward).normalized() * std::tan(fov * 0.5f);
+		view.near = near;
+		view.far = far;
+		view.start = 0.0f;
+		view.end = far;
+		view.width = WIDTH;
+		view.height = HEIGHT;
+
+		VkCommandBuffer command_buffer = gpu->device->begin_single_time_commands();
+		gpu->target->begin(command_buffer);
+		vkCmdEndRenderPass(command_buffer);
+		gpu->far->record(command_buffer, view, gpu->target->views[1], gpu->target->views[0]);
+		gpu->device->end_single_time_commands(command_buffer);
+		gpu->frame++;
+
+		suite.counter("gpu_bytes", static_cast<f64>(gpu->far->get_stats().gpu_bytes));
+		suite.counter("bytes_per_km2", gpu->map->get_stats().bytes / area_km2(gpu->map->get_stats().columns));
+	}, gpu_setup);
+
+	suite.add("far/gpu_lod_mesh_1080p", 2, 20, [&suite, state, gpu, eye, target, fov, aspect, near, far](){
+		Mat4 view_proj = Mat4::perspective(fov, aspect, near * 0.5f, far * 0.5f) * Mat4::look_at(eye * 0.5f, target * 0.5f, {0.0f, 1.0f, 0.0f});
+
+		VkCommandBuffer command_buffer = gpu->device->begin_single_time_commands();
+		gpu->target->begin(command_buffer);
+		gpu->mesher->record_draw(command_buffer, view_proj);
+		vkCmdEndRenderPass(command_buffer);
+		gpu->device->end_single_time_commands(command_buffer);
+		gpu->frame++;
+
+		suite.counter("draw_calls", gpu->mesher->get_stats().draw_calls);
+		suite.counter("bytes_per_km2", state->lod_bytes / area_km2(static_cast<u32>(state->store.size())));
+	}, gpu_setup);
+}
+
+}	// namespace bench
+}	// namespace uni
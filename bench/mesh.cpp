@@ -0,0 +1,196 @@
+/**
+ * @file bench/mesh.cpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#include "bench.hpp"
+
+#include "engine/engine.hpp"
+#include "util/thread_pool.hpp"
+#include "world/world.hpp"
+
+#include <filesystem>
+#include <memory>
+
+namespace uni {
+namespace bench {
+
+// 4x4 chunks of terrain, every non empty section is meshed each repetition
+static constexpr s32 MESH_RADIUS = 2;
+
+struct MeshWorld {
+	world::ChunkStore store;
+	std::vector<world::SectionNeighbours> sections;
+	std::vector<s32> coords;    // sx, sy, sz per section
+};
+
+static void generate_sections(MeshWorld& out, u64 seed){
+	world::Generator generator(seed);
+	for(s32 cx = -MESH_RADIUS - 1; cx <= MESH_RADIUS; cx++){
+		for(s32 cz = -MESH_RADIUS - 1; cz <= MESH_RADIUS; cz++){
+			generator.generate(out.store.create({cx, cz}));
+		}
+	}
+	// Only the inner chunks, the ring around them is there for neighbours
+	for(s32 sx = -MESH_RADIUS; sx < MESH_RADIUS; sx++){
+		for(s32 sz = -MESH_RADIUS; sz < MESH_RADIUS; sz++){
+			for(s32 sy = 0; sy < world::CHUNK_SECTIONS; sy++){
+				world::SectionNeighbours n = world::gather_neighbours(out.store, sx, sy, sz);
+				if(n.center == nullptr || n.center->empty()){ continue; }
+				out.sections.push_back(n);
+				out.coords.insert(out.coords.end(), {sx, sy, sz});
+			}
+		}
+	}
+}
+
+void register_mesh(Suite& suite){
+	auto cpu = std::make_shared<MeshWorld>();
+	auto cpu_setup = [&suite, cpu](){
+		if(cpu->sections.empty()){ generate_sections(*cpu, suite.get_seed()); }
+	};
+
+	// Reference mesher on the calling thread
+	suite.add("mesh/cpu_sections", 2, 20, [&suite, cpu](){
+		std::vector<world::ChunkQuad> quads;
+		u64 total = 0;
+		for(const auto& section : cpu->sections){
+			world::mesh_section(section, quads);
+			total += quads.size();
+		}
+		suite.counter("sections", static_cast<f64>(cpu->sections.size()));
+		suite.counter("quads", static_cast<f64>(total));
+	}, cpu_setup);
+
+	// Same work spread over every core
+	auto pool = std::make_shared<ThreadPool>();
+	suite.add("mesh/cpu_sections_parallel", 2, 20, [&suite, cpu, pool](){
+		std::vector<std::vector<world::ChunkQuad>> quads(pool->size());
+		pool->parallel_for(cpu->sections.size(), [&](size_t i, u32 worker){
+			world::mesh_section(cpu->sections[i], quads[worker]);
+		});
+		suite.counter("sections", static_cast<f64>(cpu->sections.size()));
+		suite.counter("threads", pool->size());
+	}, cpu_setup);
+
+	/*
+	 * Compute shader mesher, one submit per repetition and waited on. The
+	 * time covers palette encoding and staging on the CPU plus the GPU
+	 * pass, every section replaces its previous mesh.
+	 */
+	struct State {
+		MeshWorld world;
+		std::unique_ptr<eng::Window> window;
+		std::unique_ptr<eng::Device> device;
+		std::unique_ptr<eng::StagingRing> staging;
+		std::unique_ptr<eng::GpuMesher> mesher;
+		std::unique_ptr<eng::MemoryBudget> budget;
+		std::vector<eng::MeshId> ids;
+		u64 frame = 0;
+	};
+	auto state = std::make_shared<State>();
+
+	auto gpu_sections = [&suite, state](){
+		state->staging->begin_frame(state->frame);
+		state->mesher->begin_frame(state->frame);
+		state->budget->begin_frame();
+		const auto& coords = state->world.coords;
+		for(size_t i = 0; i < state->world.sections.size(); i++){
+			state->mesher->mesh(state->ids[i], state->world.sections[i], coords[i * 3], coords[i * 3 + 1], coords[i * 3 + 2]);
+		}
+		VkCommandBuffer command_buffer = state->device->begin_single_time_commands();
+		state->mesher->record(command_buffer);
+		state->device->end_single_time_commands(command_buffer);
+		state->frame++;
+
+		const auto& stats = state->mesher->get_stats();
+		suite.counter("sections", stats.jobs);
+		suite.counter("bytes_uploaded", static_cast<f64>(stats.bytes_uploaded));
+		suite.counter("quads_reserved", static_cast<f64>(stats.quads_reserved));
+		suite.counter("deferred", stats.deferred);
+		suite.counter("evicted_bytes", static_cast<f64>(state->budget->get_stats().evicted));
+	};
+	auto gpu_setup = [&suite, state](){
+		if(state->device){ return; }
+		generate_sections(state->world, suite.get_seed());
+		state->ids.assign(state->world.sections.size(), eng::NO_MESH);
+
+		state->window = std::make_unique<eng::Window>(100, 100, "bench");
+		state->device = std::make_unique<eng::Device>(*state->window);
+		state->staging = std::make_unique<eng::StagingRing>(*state->device, 16 << 20, 1);
+
+		eng::GpuMesherConfig config;
+		config.max_sections = 1024;
+		config.quad_capacity = 1 << 22;
+		config.jobs_per_frame = 1024;
+		config.upload_bytes = 16 << 20;
+		config.frames_in_flight = 1;
+		state->mesher = std::make_unique<eng::GpuMesher>(*state->device, *state->staging, config);
+
+		// Far sections go first when over budget, from the middle of the world.
+		// The budget lives in the state, a raw pointer keeps it from owning it
+		State* raw = state.get();
+		u32 max_sections = config.max_sections;
+		state->budget = std::make_unique<eng::MemoryBudget>(*state->device, eng::MemoryBudgetConfig{});
+		state->budget->add_pool([raw](){ return raw->mesher->get_free_bytes(); });
+		state->budget->add_evictor([raw, max_sections](VkDeviceSize bytes){
+			std::vector<eng::MeshId> evicted;
+			VkDeviceSize freed = raw->mesher->evict(bytes, 0, world::CHUNK_SECTIONS / 2, 0, evicted);
+			std::vector<bool> gone(max_sections, false);
+			for(eng::MeshId id : evicted){ gone[id] = true; }
+			for(eng::MeshId& id : raw->ids){
+				if(id != eng::NO_MESH && gone[id]){ id = eng::NO_MESH; }
+			}
+			return freed;
+		});
+	};
+	suite.add("mesh/gpu_sections", 2, 20, gpu_sections, gpu_setup);
+
+	/*
+	 * Joining a world, every section goes through the on disk mesh cache
+	 * and is uploaded already meshed. Cold starts from no cache files and
+	 * meshes every miss on the CPU, warm reopens the files a cold join
+	 * left behind. Both include opening the cache.
+	 */
+	world::MeshCacheConfig cache_config;
+	cache_config.path = (std::filesystem::temp_directory_path() / "unicraft_bench_meshes.pack").string();
+	cache_config.max_bytes = 256 << 20;
+	auto join = [&suite, state, cache_config](){
+		world::MeshCache cache(cache_config);
+		state->staging->begin_frame(state->frame);
+		state->mesher->begin_frame(state->frame);
+		const auto& coords = state->world.coords;
+		for(size_t i = 0; i < state->world.sections.size(); i++){
+			world::CachedMesh mesh = cache.mesh(state->world.sections[i]);
+			state->mesher->upload(state->ids[i], mesh.quads, mesh.count, coords[i * 3], coords[i * 3 + 1], coords[i * 3 + 2]);
+		}
+		VkCommandBuffer command_buffer = state->device->begin_single_time_commands();
+		state->mesher->record(command_buffer);
+		state->device->end_single_time_commands(command_buffer);
+		state->frame++;
+
+		suite.counter("sections", static_cast<f64>(state->world.sections.size()));
+		suite.counter("hit_rate", cache.get_stats().hit_rate());
+		suite.counter("pack_bytes", static_cast<f64>(cache.get_stats().bytes));
+		suite.counter("bytes_uploaded", static_cast<f64>(state->mesher->get_stats().bytes_uploaded));
+	};
+	auto remove_cache = [cache_config](){
+		std::filesystem::remove(cache_config.path);
+		std::filesystem::remove(cache_config.path + ".idx");
+	};
+
+	suite.add("mesh/join_cache_cold", 1, 10, [join, remove_cache](){
+		remove_cache();
+		join();
+	}, gpu_setup);
+
+	suite.add("mesh/join_cache_warm", 1, 10, join, [gpu_setup, join, remove_cache](){
+		gpu_setup();
+		remove_cache();
+		join();
+	});
+}
+
+}	// namespace bench
+}	// namespace uni
@@ -0,0 +1,111 @@
+/**
+ * @file bench/net.cpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#include "bench.hpp"
+
+#include "net/net.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+namespace uni {
+namespace bench {
+
+static constexpr u32 PLAYERS = 100;
+static constexpr u8 VIEW_DISTANCE = 8;
+static constexpr u32 CHANGES_PER_TICK = 400;
+static constexpr s32 SPAWN_RADIUS = 256;
+
+void register_net(Suite& suite){
+	/*
+	 * Dedicated server with 100 players over loopback. Players walk about
+	 * a shared spawn area and the world changes every tick. Clients run on
+	 * their own thread so only the server's tick is timed.
+	 */
+	struct State {
+		world::ChunkStore store;
+		std::unique_ptr<world::Generator> generator;
+		std::unique_ptr<net::Server> server;
+		std::vector<std::unique_ptr<net::Client>> clients;
+		std::thread pump;
+		std::atomic<bool> running{false};
+		u64 tick = 0;
+
+		// Closes every socket, nothing of the workload outlives it
+		void stop(){
+			running = false;
+			if(pump.joinable()){ pump.join(); }
+			clients.clear();
+			server.reset();
+		}
+
+		~State(){ stop(); }
+	};
+	auto state = std::make_shared<State>();
+
+	suite.add("net/server_tick_100_players", 100, 400, [&suite, state](){
+		Rng rng(suite.get_seed() + state->tick++);
+		for(u32 i = 0; i < CHANGES_PER_TICK; i++){
+			s32 x = static_cast<s32>(rng.below(2 * SPAWN_RADIUS)) - SPAWN_RADIUS;
+			s32 z = static_cast<s32>(rng.below(2 * SPAWN_RADIUS)) - SPAWN_RADIUS;
+			state->server->set_block(x, 60 + static_cast<s32>(rng.below(20)), z, static_cast<world::BlockId>(rng.below(world::BLOCK_COUNT)));
+		}
+		state->server->tick();
+
+		const auto& stats = state->server->get_stats();
+		suite.counter("clients", stats.clients);
+		suite.counter("bytes_per_client", static_cast<f64>(stats.bytes_sent) / PLAYERS);
+		suite.counter("bytes_encoded", static_cast<f64>(stats.bytes_encoded));
+		suite.counter("chunks_sent", stats.chunks_sent);
+
+		// Mean over every tick so far including the initial chunk load, at 20 ticks per second
+		u64 total = 0;
+		for(size_t i = 0; i < state->server->client_count(); i++){ total += state->server->get_client_stats(i).bytes_sent; }
+		suite.counter("kib_per_s_per_client", static_cast<f64>(total) / PLAYERS / state->tick * 20.0 / 1024.0);
+	}, [&suite, state](){
+		state->generator = std::make_unique<world::Generator>(suite.get_seed());
+		state->server = std::make_unique<net::Server>(state->store, *state->generator, net::ServerConfig{});
+
+		Rng rng(suite.get_seed());
+		std::vector<std::pair<f32, f32>> positions;
+		for(u32 i = 0; i < PLAYERS; i++){
+			state->clients.push_back(std::make_unique<net::Client>("127.0.0.1", state->server->get_port()));
+			positions.emplace_back(rng.uniform(-SPAWN_RADIUS, SPAWN_RADIUS), rng.uniform(-SPAWN_RADIUS, SPAWN_RADIUS));
+			state->clients.back()->send_position(positions.back().first, positions.back().second, VIEW_DISTANCE);
+		}
+
+		// Players walk at about 4 blocks per second in a fixed direction each.
+		// The thread is owned by the state, a shared_ptr here would keep it alive
+		State* raw = state.get();
+		raw->running = true;
+		raw->pump = std::thread([raw, positions]() mutable {
+			Rng rng(1);
+			std::vector<std::pair<f32, f32>> heading;
+			for(u32 i = 0; i < PLAYERS; i++){ heading.emplace_back(rng.uniform(-0.2f, 0.2f), rng.uniform(-0.2f, 0.2f)); }
+
+			auto last_move = std::chrono::steady_clock::now();
+			while(raw->running){
+				for(auto& client : raw->clients){ client->poll(); }
+				if(std::chrono::steady_clock::now() - last_move > std::chrono::milliseconds(50)){
+					last_move = std::chrono::steady_clock::now();
+					for(u32 i = 0; i < PLAYERS; i++){
+						positions[i].first += heading[i].first;
+						positions[i].second += heading[i].second;
+						raw->clients[i]->send_position(positions[i].first, positions[i].second, VIEW_DISTANCE);
+					}
+				}
+				std::this_thread::sleep_for(std::chrono::microseconds(200));
+			}
+		});
+	}, [state](){
+		state->stop();
+	});
+}
+
+}	// namespace bench
+}	// namespace uni
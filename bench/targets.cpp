@@ -0,0 +1,176 @@
+/**
+ * @file bench/targets.cpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#include "bench.hpp"
+
+#include "engine/engine.hpp"
+
+#include <memory>
+
+namespace uni {
+namespace bench {
+
+static constexpr u32 WIDTH = 1920;
+static constexpr u32 HEIGHT = 1080;
+
+/**
+ * @brief Two passes at 1080p, 4x MSAA color and depth resolved in the first, a scratch color in the second
+ *
+ * With `transient` the MSAA color, depth and scratch are transient and
+ * the scratch shares the MSAA color's memory. Without it every target is
+ * stored and has memory of its own.
+ */
+struct TargetFrame {
+	eng::Device* device = nullptr;
+	std::unique_ptr<eng::RenderTargets> targets;
+	VkRenderPass passes[2] = {VK_NULL_HANDLE, VK_NULL_HANDLE};
+	VkFramebuffer framebuffers[2] = {VK_NULL_HANDLE, VK_NULL_HANDLE};
+
+	void create(eng::Device& d, bool transient){
+		device = &d;
+		targets = std::make_unique<eng::RenderTargets>(d);
+		eng::TargetId color = targets->add({VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT, VK_SAMPLE_COUNT_4_BIT, 0, 0, transient});
+		eng::TargetId depth = targets->add({d.find_depth_format(), VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, VK_SAMPLE_COUNT_4_BIT, 0, 0, transient});
+		eng::TargetId resolve = targets->add({VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, VK_SAMPLE_COUNT_1_BIT, 0, 1, false});
+		eng::TargetId scratch = targets->add({VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT, VK_SAMPLE_COUNT_1_BIT, 1, 1, transient});
+		targets->build(WIDTH, HEIGHT);
+
+		// The resolve overwrites every pixel, nothing to clear
+		VkAttachmentDescription first[3] = {
+			targets->describe(color, 0, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL),
+			targets->describe(depth, 0, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL),
+			targets->describe(resolve, 0, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL)
+		};
+		first[2].loadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+		VkAttachmentReference color_reference = {0, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL};
+		VkAttachmentReference depth_reference = {1, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL};
+		VkAttachmentReference resolve_reference = {2, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL};
+		VkSubpassDescription subpass = {};
+		subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+		subpass.colorAttachmentCount = 1;
+		subpass.pColorAttachments = &color_reference;
+		subpass.pResolveAttachments = &resolve_reference;
+		subpass.pDepthStencilAttachment = &depth_reference;
+		create_pass(0, first, 3, subpass, {targets->get_view(color), targets->get_view(depth), targets->get_view(resolve)});
+
+		VkAttachmentDescription second = targets->describe(scratch, 1, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+		VkAttachmentReference scratch_reference = {0, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL};
+		subpass = {};
+		subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+		subpass.colorAttachmentCount = 1;
+		subpass.pColorAttachments = &scratch_reference;
+		create_pass(1, &second, 1, subpass, {targets->get_view(scratch)});
+	}
+
+	void create_pass(u32 i, const VkAttachmentDescription* attachments, u32 count, const VkSubpassDescription& subpass, std::vector<VkImageView> views){
+		// Aliased memory is written by the pass before, its attachment writes must finish first
+		VkSubpassDependency dependency = {};
+		dependency.srcSubpass = VK_SUBPASS_EXTERNAL;
+		dependency.dstSubpass = 0;
+		dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+		dependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+		dependency.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+		dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+
+		VkRenderPassCreateInfo create_info = {};
+		create_info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+		create_info.attachmentCount = count;
+		create_info.pAttachments = attachments;
+		create_info.subpassCount = 1;
+		create_info.pSubpasses = &subpass;
+		create_info.dependencyCount = 1;
+		create_info.pDependencies = &dependency;
+		if(vkCreateRenderPass(device->get_device(), &create_info, nullptr, &passes[i]) != VK_SUCCESS){
+			ERROR("BENCH", "Failed to create render pass.");
+			throw std::exception();
+		}
+
+		VkFramebufferCreateInfo framebuffer_info = {};
+		framebuffer_info.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+		framebuffer_info.renderPass = passes[i];
+		framebuffer_info.attachmentCount = count;
+		framebuffer_info.pAttachments = views.data();
+		framebuffer_info.width = WIDTH;
+		framebuffer_info.height = HEIGHT;
+		framebuffer_info.layers = 1;
+		if(vkCreateFramebuffer(device->get_device(), &framebuffer_info, nullptr, &framebuffers[i]) != VK_SUCCESS){
+			ERROR("BENCH", "Failed to create framebuffer.");
+			throw std::exception();
+		}
+	}
+
+	void record(VkCommandBuffer command_buffer){
+		VkClearValue clears[3] = {};
+		clears[0].color = {{0.62f, 0.75f, 0.90f, 1.0f}};
+		clears[1].depthStencil = {1.0f, 0};
+		const u32 counts[2] = {3, 1};
+		for(u32 i = 0; i < 2; i++){
+			VkRenderPassBeginInfo begin_info = {};
+			begin_info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+			begin_info.renderPass = passes[i];
+			begin_info.framebuffer = framebuffers[i];
+			begin_info.renderArea = {{0, 0}, {WIDTH, HEIGHT}};
+			begin_info.clearValueCount = counts[i];
+			begin_info.pClearValues = clears;
+			vkCmdBeginRenderPass(command_buffer, &begin_info, VK_SUBPASS_CONTENTS_INLINE);
+			vkCmdEndRenderPass(command_buffer);
+		}
+	}
+
+	~TargetFrame(){
+		if(device == nullptr){ return; }
+		VkDevice d = device->get_device();
+		vkDeviceWaitIdle(d);
+		for(u32 i = 0; i < 2; i++){
+			vkDestroyFramebuffer(d, framebuffers[i], nullptr);
+			vkDestroyRenderPass(d, passes[i], nullptr);
+		}
+	}
+};
+
+void register_targets(Suite& suite){
+	struct GpuState {
+		std::unique_ptr<eng::Window> window;
+		std::unique_ptr<eng::Device> device;
+		std::unique_ptr<TargetFrame> frames[2];
+	};
+	auto gpu = std::make_shared<GpuState>();
+
+	/*
+	 * GPU frame time of both passes, nothing drawn so only clears, resolve
+	 * and stores are measured. Memory is what the targets allocate, and
+	 * for lazily allocated memory what the driver actually committed.
+	 * One submit per repetition and waited on.
+	 */
+	const char* names[2] = {"targets/dedicated_1080p", "targets/transient_1080p"};
+	for(u32 transient = 0; transient < 2; transient++){
+		auto setup = [gpu, transient](){
+			if(!gpu->device){
+				gpu->window = std::make_unique<eng::Window>(100, 100, "bench");
+				gpu->device = std::make_unique<eng::Device>(*gpu->window);
+			}
+			if(gpu->frames[transient]){ return; }
+			gpu->frames[transient] = std::make_unique<TargetFrame>();
+			gpu->frames[transient]->create(*gpu->device, transient);
+		};
+
+		suite.add(names[transient], 2, 20, [&suite, gpu, transient](){
+			TargetFrame& frame = *gpu->frames[transient];
+			VkCommandBuffer command_buffer = gpu->device->begin_single_time_commands();
+			frame.record(command_buffer);
+			gpu->device->end_single_time_commands(command_buffer);
+
+			const eng::RenderTargetStats& stats = frame.targets->poll_stats();
+			suite.counter("allocated_bytes", static_cast<f64>(stats.allocated_bytes));
+			suite.counter("committed_bytes", static_cast<f64>(stats.committed_bytes));
+			suite.counter("bytes_saved", static_cast<f64>(stats.dedicated_bytes - stats.allocated_bytes));
+			suite.counter("lazy_targets", stats.lazy_targets);
+		}, setup);
+	}
+}
+
+}	// namespace bench
+}	// namespace uni
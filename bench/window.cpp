@@ -0,0 +1,87 @@
+/**
+ * @file bench/window.cpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#include "bench.hpp"
+
+#include "engine/frame_pacer.hpp"
+#include "engine/window.hpp"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+namespace uni {
+namespace bench {
+
+static constexpr f64 TARGET_FPS = 240.0;
+static constexpr u64 INPUT_PERIOD = 1000000;    // 1kHz mouse
+static constexpr u64 FRAME_WORK = 1000000;
+
+void register_window(Suite& suite){
+	/*
+	 * Headless render loop paced to 240fps with an input thread feeding
+	 * cursor samples at 1kHz. Each repetition is one frame including the
+	 * pacer's sleep, so the timings show how steady the frame rate is and
+	 * the counters how old the input is when the frame is presented.
+	 */
+	struct State {
+		std::unique_ptr<eng::Window> window;
+		std::unique_ptr<eng::FramePacer> pacer;
+		std::thread input;
+		std::atomic<bool> running{false};
+
+		void stop(){
+			running = false;
+			if(input.joinable()){ input.join(); }
+		}
+
+		~State(){ stop(); }
+	};
+	auto state = std::make_shared<State>();
+
+	suite.add("window/headless_pacing_240hz", 60, 1000, [&suite, state](){
+		Clock& clock = Clock::steady();
+		state->pacer->wait();
+
+		eng::InputEvent event;
+		while(state->window->next_event(event)){}
+
+		// Stand in for building the frame, spin so it does not depend on the scheduler
+		u64 start = clock.now();
+		while(clock.now() - start < FRAME_WORK){}
+
+		state->pacer->latch(state->window->latch_cursor().time);
+		state->pacer->presented();
+
+		const auto& stats = state->pacer->get_stats();
+		suite.counter("frame_ms", stats.frame_ms);
+		suite.counter("latency_ms", stats.latency_ms);
+		suite.counter("latency_max_ms", stats.latency_max_ms);
+		suite.counter("missed", static_cast<f64>(stats.missed));
+		suite.counter("dropped_events", static_cast<f64>(state->window->get_dropped_events()));
+	}, [state](){
+		state->window = std::make_unique<eng::Window>(100, 100, "bench", eng::WindowMode::HEADLESS);
+		state->pacer = std::make_unique<eng::FramePacer>(Clock::steady(), eng::FramePacerConfig{TARGET_FPS});
+
+		// The state joins the thread, a raw pointer keeps the thread from owning it
+		State* raw = state.get();
+		raw->running = true;
+		raw->input = std::thread([raw](){
+			Clock& clock = Clock::steady();
+			for(u64 next = clock.now(); raw->running; next += INPUT_PERIOD){
+				clock.sleep_until(next);
+				u64 now = clock.now();
+				raw->window->inject({eng::InputEvent::CURSOR, 0, 0, static_cast<f64>(now % 1000), 0.0, now});
+			}
+		});
+	}, [state](){
+		// The input period is within the clock's spin, left running it holds a core
+		state->stop();
+	});
+}
+
+}	// namespace bench
+}	// namespace uni
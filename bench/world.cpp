@@ -0,0 +1,142 @@
+/**
+ * @file bench/world.cpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#include "bench.hpp"
+
+#include "world/world.hpp"
+
+#include <array>
+#include <memory>
+
+namespace uni {
+namespace bench {
+
+// 8x8 chunks around the origin, same terrain every run for a given seed
+static constexpr s32 WORLD_RADIUS = 4;
+static constexpr size_t RAY_COUNT = 1 << 16;
+static constexpr size_t ENTITY_COUNT = 1 << 14;
+static constexpr size_t FLUID_SOURCES = 10000;
+
+static void generate_world(world::ChunkStore& store, u64 seed){
+	world::Generator generator(seed);
+	for(s32 cx = -WORLD_RADIUS; cx < WORLD_RADIUS; cx++){
+		for(s32 cz = -WORLD_RADIUS; cz < WORLD_RADIUS; cz++){
+			generator.generate(store.create({cx, cz}));
+		}
+	}
+}
+
+/**
+ * @brief Block picking style rays from above the terrain
+ */
+static std::vector<world::Ray> make_rays(u64 seed){
+	Rng rng(seed);
+	std::vector<world::Ray> rays(RAY_COUNT);
+	f32 extent = WORLD_RADIUS * world::SECTION_SIZE;
+	for(auto& ray : rays){
+		ray.origin = {rng.uniform(-extent, extent), rng.uniform(70.0f, 90.0f), rng.uniform(-extent, extent)};
+		ray.direction = Vec3{rng.uniform(-1.0f, 1.0f), rng.uniform(-1.0f, 0.2f), rng.uniform(-1.0f, 1.0f)}.normalized();
+		ray.max_distance = 64.0f;
+	}
+	return rays;
+}
+
+void register_world(Suite& suite){
+	suite.add("world/generate_64_chunks", 1, 10, [&suite](){
+		world::ChunkStore store;
+		generate_world(store, suite.get_seed());
+		keep(store.size());
+	});
+
+	struct State {
+		world::ChunkStore store;
+		std::vector<world::Ray> rays;
+		std::vector<world::RayHit> hits;
+		std::vector<world::AabbMove> moves;
+	};
+	auto state = std::make_shared<State>();
+	auto setup = [&suite, state](){
+		if(state->store.size() > 0){ return; }
+		generate_world(state->store, suite.get_seed());
+		state->rays = make_rays(suite.get_seed());
+		state->hits.resize(state->rays.size());
+
+		Rng rng(suite.get_seed() + 1);
+		f32 extent = WORLD_RADIUS * world::SECTION_SIZE - 2.0f;
+		state->moves.resize(ENTITY_COUNT);
+		for(auto& move : state->moves){
+			Vec3 feet = {rng.uniform(-extent, extent), 0.0f, rng.uniform(-extent, extent)};
+			feet.y = static_cast<f32>(world::Generator(suite.get_seed()).height(static_cast<s32>(feet.x), static_cast<s32>(feet.z)) + 1);
+			move.box = {feet - Vec3{0.3f, 0.0f, 0.3f}, feet + Vec3{0.3f, 1.8f, 0.3f}};
+		}
+	};
+
+	suite.add("world/raycast_scalar", 2, 20, [&suite, state](){
+		for(size_t i = 0; i < state->rays.size(); i++){
+			state->hits[i] = world::raycast(state->store, state->rays[i]);
+		}
+		keep(state->hits);
+		suite.counter("rays", static_cast<f64>(state->rays.size()));
+	}, setup);
+
+	suite.add("world/raycast_batch", 2, 20, [&suite, state](){
+		world::raycast_batch(state->store, state->rays.data(), state->hits.data(), state->rays.size());
+		keep(state->hits);
+		suite.counter("rays", static_cast<f64>(state->rays.size()));
+	}, setup);
+
+	// One physics tick: gravity plus a random walk for every entity
+	suite.add("world/aabb_batch_tick", 2, 50, [&suite, state](){
+		Rng rng(suite.get_seed() + 2);
+		for(auto& move : state->moves){
+			move.delta = {rng.uniform(-0.2f, 0.2f), -0.08f, rng.uniform(-0.2f, 0.2f)};
+		}
+		world::move_aabb_batch(state->store, state->moves.data(), state->moves.size());
+		suite.counter("entities", static_cast<f64>(state->moves.size()));
+	}, setup);
+
+	struct SimulationState {
+		world::ChunkStore store;
+		ThreadPool pool;
+		std::unique_ptr<world::Simulation> simulation;
+		std::vector<std::array<s32, 3>> sources;
+		Rng rng{0};
+	};
+	auto sim = std::make_shared<SimulationState>();
+	auto sim_setup = [&suite, sim](){
+		if(sim->simulation){ return; }
+		generate_world(sim->store, suite.get_seed());
+		sim->simulation = std::make_unique<world::Simulation>(sim->store, sim->pool, world::SimulationConfig{suite.get_seed()});
+		sim->rng = Rng(suite.get_seed() + 3);
+
+		world::Generator generator(suite.get_seed());
+		s32 extent = WORLD_RADIUS * world::SECTION_SIZE;
+		sim->sources.resize(FLUID_SOURCES);
+		for(auto& p : sim->sources){
+			p[0] = static_cast<s32>(sim->rng.below(2 * extent)) - extent;
+			p[2] = static_cast<s32>(sim->rng.below(2 * extent)) - extent;
+			p[1] = generator.height(p[0], p[2]) + 1;
+			sim->simulation->set_block(p[0], p[1], p[2], world::WATER);
+		}
+	};
+
+	// Keeps the water moving by toggling 1% of the sources every tick
+	suite.add("world/simulation_tick_10k_fluids", 20, 200, [&suite, sim](){
+		for(size_t i = 0; i < FLUID_SOURCES / 100; i++){
+			const auto& p = sim->sources[sim->rng.below(FLUID_SOURCES)];
+			bool on = sim->store.get_block(p[0], p[1], p[2]) == world::WATER;
+			sim->simulation->set_block(p[0], p[1], p[2], on ? world::AIR : world::WATER);
+		}
+		sim->simulation->tick();
+		const world::SimulationStats& stats = sim->simulation->get_stats();
+		suite.counter("sections", stats.sections);
+		suite.counter("updates", stats.updates + stats.scheduled + stats.random);
+		suite.counter("changes", stats.changes);
+	}, sim_setup);
+}
+
+}	// namespace bench
+}	// namespace uni
@@ -0,0 +1,43 @@
+/**
+ * @file src/ecs/command_buffer.cpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#include "ecs/command_buffer.hpp"
+
+namespace uni {
+namespace ecs {
+
+void CommandBuffer::flush(Registry& registry){
+	std::vector<const void*> pointers;
+	for(const Command& command : commands){
+		switch(command.op){
+		case Op::CREATE: {
+			pointers.clear();
+			size_t offset = command.data;
+			for(u32 i = 0; i < command.count; i++){
+				pointers.push_back(data.data() + offset);
+				offset += component_info(ids[command.first + i]).size;
+			}
+			registry.create_raw(ids.data() + command.first, pointers.data(), command.count);
+			break;
+		}
+		case Op::DESTROY:
+			registry.destroy(command.entity);
+			break;
+		case Op::ADD:
+			registry.add_raw(command.entity, ids[command.first], data.data() + command.data);
+			break;
+		case Op::REMOVE:
+			registry.remove_raw(command.entity, command.first);
+			break;
+		}
+	}
+	commands.clear();
+	ids.clear();
+	data.clear();
+}
+
+}	// namespace ecs
+}	// namespace uni
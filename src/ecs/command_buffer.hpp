@@ -0,0 +1,84 @@
+/**
+ * @file src/ecs/command_buffer.hpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#pragma once
+
+#include "ecs/ecs.hpp"
+
+#include <vector>
+
+namespace uni {
+namespace ecs {
+
+/**
+ * @brief Structural changes recorded while systems iterate
+ *
+ * Not thread safe, parallel systems keep one per worker. Commands are
+ * applied in the order they were recorded by `flush`.
+ */
+class CommandBuffer {
+public:
+	template<typename... Ts>
+	void create(const Ts&... values){
+		Command command{Op::CREATE, {}, static_cast<u32>(ids.size()), static_cast<u32>(sizeof...(Ts)), data.size()};
+		(push<Ts>(values), ...);
+		commands.push_back(command);
+	}
+
+	void destroy(Entity entity){
+		commands.push_back({Op::DESTROY, entity, 0, 0, 0});
+	}
+
+	template<typename T>
+	void add(Entity entity, const T& value){
+		Command command{Op::ADD, entity, static_cast<u32>(ids.size()), 1, data.size()};
+		push<T>(value);
+		commands.push_back(command);
+	}
+
+	template<typename T>
+	void remove(Entity entity){
+		commands.push_back({Op::REMOVE, entity, component_id<T>(), 0, 0});
+	}
+
+	/**
+	 * @brief Applies every command to `registry` and clears the buffer
+	 * @note Commands on entities destroyed in the meantime are ignored
+	 */
+	void flush(Registry& registry);
+
+	bool empty() const { return commands.empty(); }
+	size_t size() const { return commands.size(); }
+
+private:
+	enum class Op : u8 { CREATE, DESTROY, ADD, REMOVE };
+
+	/**
+	 * `first` indexes `ids` for CREATE and ADD and is the component id
+	 * for REMOVE. Payloads are packed back to back starting at `data`.
+	 */
+	struct Command {
+		Op op;
+		Entity entity;
+		u32 first;
+		u32 count;
+		size_t data;
+	};
+
+	template<typename T>
+	void push(const T& value){
+		ids.push_back(component_id<T>());
+		const u8* bytes = reinterpret_cast<const u8*>(&value);
+		data.insert(data.end(), bytes, bytes + sizeof(T));
+	}
+
+	std::vector<Command> commands;
+	std::vector<ComponentId> ids;
+	std::vector<u8> data;
+};
+
+}	// namespace ecs
+}	// namespace uni
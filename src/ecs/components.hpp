@@ -0,0 +1,47 @@
+/**
+ * @file src/ecs/components.hpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#pragma once
+
+#include "util/math.hpp"
+#include "world/block.hpp"
+
+namespace uni {
+namespace ecs {
+
+/*
+ * Components shared by mobs and dropped items
+ */
+
+struct Position {
+	Vec3 value;
+};
+
+struct Velocity {
+	Vec3 value;
+};
+
+/**
+ * @brief Box around the entity's position, feet at the bottom centre
+ */
+struct Collider {
+	Vec3 half_extents;
+	bool on_ground = false;
+};
+
+struct Mob {
+	u16 type;
+	u16 health;
+};
+
+struct DroppedItem {
+	world::BlockId block;
+	u16 count;
+	f32 age;
+};
+
+}	// namespace ecs
+}	// namespace uni
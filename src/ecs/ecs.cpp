@@ -0,0 +1,197 @@
+/**
+ * @file src/ecs/ecs.cpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#include "ecs/ecs.hpp"
+
+#include "util/util.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <exception>
+#include <mutex>
+
+namespace uni {
+namespace ecs {
+
+// Fixed storage so registering never moves what other threads are reading
+static std::array<ComponentInfo, MAX_COMPONENTS> component_infos;
+static std::atomic<u32> component_count{0};
+
+static size_t align_up(size_t value, size_t alignment){
+	return (value + alignment - 1) & ~(alignment - 1);
+}
+
+ComponentId register_component(size_t size, size_t align){
+	static std::mutex mutex;
+	std::lock_guard<std::mutex> lock(mutex);
+
+	u32 id = component_count.load(std::memory_order_relaxed);
+	if(id >= MAX_COMPONENTS){
+		ERROR("ECS", "More than " << MAX_COMPONENTS << " component types registered.");
+		throw std::exception();
+	}
+	component_infos[id] = {size, align};
+	component_count.store(id + 1, std::memory_order_release);
+	return id;
+}
+
+const ComponentInfo& component_info(ComponentId id){
+	if(id >= component_count.load(std::memory_order_acquire)){
+		ERROR("ECS", "Component " << id << " is not registered.");
+		throw std::exception();
+	}
+	return component_infos[id];
+}
+
+Entity Registry::create_raw(const ComponentId* ids, const void* const* data, size_t count){
+	ComponentMask mask = 0;
+	for(size_t i = 0; i < count; i++){ mask |= ComponentMask(1) << ids[i]; }
+
+	Archetype& archetype = get_archetype(mask);
+	Entity entity = allocate_entity();
+	push_row(archetype, entity);
+
+	const Record& r = records[entity.index];
+	for(size_t i = 0; i < count; i++){
+		std::memcpy(archetype.column(archetype.chunks[r.chunk], ids[i]) + r.row * component_info(ids[i]).size, data[i], component_info(ids[i]).size);
+	}
+	live++;
+	return entity;
+}
+
+void Registry::destroy(Entity entity){
+	if(!alive(entity)){ return; }
+	Record& r = records[entity.index];
+	erase_row(*r.archetype, r.chunk, r.row);
+	r.archetype = nullptr;
+	r.generation++;
+	free_indices.push_back(entity.index);
+	live--;
+}
+
+void Registry::add_raw(Entity entity, ComponentId id, const void* data){
+	if(!alive(entity)){ return; }
+	ComponentMask bit = ComponentMask(1) << id;
+	if(!(records[entity.index].archetype->mask & bit)){
+		move_entity(entity, records[entity.index].archetype->mask | bit);
+	}
+	const Record& r = records[entity.index];
+	size_t size = component_info(id).size;
+	std::memcpy(r.archetype->column(r.archetype->chunks[r.chunk], id) + r.row * size, data, size);
+}
+
+void Registry::remove_raw(Entity entity, ComponentId id){
+	if(!alive(entity)){ return; }
+	ComponentMask bit = ComponentMask(1) << id;
+	if(records[entity.index].archetype->mask & bit){
+		move_entity(entity, records[entity.index].archetype->mask & ~bit);
+	}
+}
+
+Archetype& Registry::get_archetype(ComponentMask mask){
+	auto found = archetype_by_mask.find(mask);
+	if(found != archetype_by_mask.end()){ return *found->second; }
+
+	auto archetype = std::make_unique<Archetype>();
+	archetype->mask = mask;
+	archetype->offsets.fill(0);
+	size_t row_bytes = sizeof(Entity);
+	for(ComponentId id = 0; id < MAX_COMPONENTS; id++){
+		if(mask & (ComponentMask(1) << id)){
+			archetype->components.push_back(id);
+			row_bytes += component_info(id).size;
+		}
+	}
+
+	// Largest row count whose cache line aligned columns fit in one chunk
+	for(size_t capacity = CHUNK_BYTES / row_bytes; capacity > 0; capacity--){
+		size_t offset = align_up(sizeof(Entity) * capacity, CACHE_LINE);
+		for(ComponentId id : archetype->components){
+			archetype->offsets[id] = static_cast<u32>(offset);
+			offset = align_up(offset + component_info(id).size * capacity, CACHE_LINE);
+		}
+		if(offset <= CHUNK_BYTES){
+			archetype->capacity = static_cast<u32>(capacity);
+			break;
+		}
+	}
+	if(archetype->capacity == 0){
+		ERROR("ECS", "A row of " << row_bytes << " bytes does not fit in a " << CHUNK_BYTES << " byte chunk.");
+		throw std::exception();
+	}
+
+	Archetype* result = archetype.get();
+	archetype_by_mask[mask] = result;
+	archetypes.push_back(std::move(archetype));
+	return *result;
+}
+
+Entity Registry::allocate_entity(){
+	if(!free_indices.empty()){
+		u32 index = free_indices.back();
+		free_indices.pop_back();
+		return {index, records[index].generation};
+	}
+	records.emplace_back();
+	return {static_cast<u32>(records.size() - 1), 0};
+}
+
+void Registry::push_row(Archetype& archetype, Entity entity){
+	if(archetype.chunks.empty() || archetype.chunks.back().count == archetype.capacity){
+		ArchetypeChunk chunk;
+		chunk.data.reset(static_cast<u8*>(std::aligned_alloc(CACHE_LINE, CHUNK_BYTES)));
+		if(!chunk.data){
+			ERROR("ECS", "Failed to allocate archetype chunk.");
+			throw std::exception();
+		}
+		archetype.chunks.push_back(std::move(chunk));
+	}
+
+	ArchetypeChunk& chunk = archetype.chunks.back();
+	u32 row = chunk.count++;
+	archetype.entities(chunk)[row] = entity;
+
+	Record& r = records[entity.index];
+	r.archetype = &archetype;
+	r.chunk = static_cast<u32>(archetype.chunks.size() - 1);
+	r.row = row;
+}
+
+void Registry::erase_row(Archetype& archetype, u32 chunk_index, u32 row){
+	ArchetypeChunk& chunk = archetype.chunks[chunk_index];
+	ArchetypeChunk& last = archetype.chunks.back();
+	u32 last_row = last.count - 1;
+
+	if(&chunk != &last || row != last_row){
+		Entity moved = archetype.entities(last)[last_row];
+		archetype.entities(chunk)[row] = moved;
+		for(ComponentId id : archetype.components){
+			size_t size = component_info(id).size;
+			std::memcpy(archetype.column(chunk, id) + row * size, archetype.column(last, id) + last_row * size, size);
+		}
+		records[moved.index].chunk = chunk_index;
+		records[moved.index].row = row;
+	}
+
+	if(--last.count == 0){ archetype.chunks.pop_back(); }
+}
+
+void Registry::move_entity(Entity entity, ComponentMask mask){
+	Record old = records[entity.index];
+	Archetype& dst = get_archetype(mask);
+	push_row(dst, entity);
+
+	const Record& r = records[entity.index];
+	for(ComponentId id : dst.components){
+		if(!(old.archetype->mask & (ComponentMask(1) << id))){ continue; }
+		size_t size = component_info(id).size;
+		std::memcpy(dst.column(dst.chunks[r.chunk], id) + r.row * size, old.archetype->column(old.archetype->chunks[old.chunk], id) + old.row * size, size);
+	}
+	erase_row(*old.archetype, old.chunk, old.row);
+}
+
+}	// namespace ecs
+}	// namespace uni
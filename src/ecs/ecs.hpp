@@ -0,0 +1,249 @@
+/**
+ * @file src/ecs/ecs.hpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#pragma once
+
+#include "util/thread_pool.hpp"
+#include "util/types.hpp"
+
+#include <array>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace uni {
+namespace ecs {
+
+using ComponentId = u32;
+using ComponentMask = u64;
+
+constexpr u32 MAX_COMPONENTS = 64;
+constexpr size_t CACHE_LINE = 64;
+constexpr size_t CHUNK_BYTES = 16 * 1024;
+
+struct Entity {
+	u32 index = ~0u;
+	u32 generation = 0;
+
+	bool operator==(const Entity& o) const { return index == o.index && generation == o.generation; }
+	bool operator!=(const Entity& o) const { return !(*this == o); }
+};
+
+struct ComponentInfo {
+	size_t size;
+	size_t align;
+};
+
+/**
+ * @brief Registers a component type
+ * @note Called through `component_id<T>()`, not directly
+ */
+ComponentId register_component(size_t size, size_t align);
+
+/**
+ * @brief Size and alignment of a registered component
+ *
+ * Safe while other threads register components, entries never move
+ * once written. Throws for an id that was never handed out.
+ */
+const ComponentInfo& component_info(ComponentId id);
+
+/**
+ * @brief Process wide id of a component type
+ *
+ * Components are plain data, they are moved between chunks with memcpy.
+ */
+template<typename T>
+ComponentId component_id(){
+	static_assert(std::is_trivially_copyable<T>::value, "Components must be trivially copyable");
+	static_assert(alignof(T) <= CACHE_LINE, "Components must not be over aligned");
+	static const ComponentId id = register_component(sizeof(T), alignof(T));
+	return id;
+}
+
+template<typename... Ts>
+ComponentMask component_mask(){
+	return (ComponentMask(0) | ... | (ComponentMask(1) << component_id<Ts>()));
+}
+
+/**
+ * @brief Fixed size block of entities that share an archetype
+ *
+ * Holds `capacity` rows as one entity array followed by one array per
+ * component, every array starting on its own cache line.
+ */
+struct ArchetypeChunk {
+	struct Free {
+		void operator()(u8* p) const { std::free(p); }
+	};
+
+	std::unique_ptr<u8, Free> data;
+	u32 count = 0;
+};
+
+/**
+ * @brief Every entity with exactly one set of components
+ */
+struct Archetype {
+	ComponentMask mask;
+	std::vector<ComponentId> components;
+	std::array<u32, MAX_COMPONENTS> offsets;    // column offset in a chunk, by component id
+	u32 capacity = 0;
+	std::vector<ArchetypeChunk> chunks;
+
+	Entity* entities(ArchetypeChunk& chunk) const { return reinterpret_cast<Entity*>(chunk.data.get()); }
+
+	template<typename T>
+	T* column(ArchetypeChunk& chunk) const { return reinterpret_cast<T*>(chunk.data.get() + offsets[component_id<T>()]); }
+
+	u8* column(ArchetypeChunk& chunk, ComponentId id) const { return chunk.data.get() + offsets[id]; }
+};
+
+/**
+ * @brief Owns all entities and their components
+ *
+ * Structural changes (create, destroy, add, remove) invalidate
+ * component pointers and must not happen while iterating, record them
+ * in a `CommandBuffer` and flush it after the systems ran.
+ */
+class Registry {
+public:
+	Registry() = default;
+	Registry(const Registry&) = delete;
+	Registry& operator=(const Registry&) = delete;
+
+	/**
+	 * @brief Creates an entity with the given components
+	 */
+	template<typename... Ts>
+	Entity create(const Ts&... values){
+		ComponentId ids[] = {component_id<Ts>()..., 0};
+		const void* data[] = {static_cast<const void*>(&values)..., nullptr};
+		return create_raw(ids, data, sizeof...(Ts));
+	}
+
+	/**
+	 * @brief Creates an entity from type erased component data
+	 * @param[in] ids Component ids, any order
+	 * @param[in] data One pointer per id to copy the component from
+	 * @param[in] count
+	 */
+	Entity create_raw(const ComponentId* ids, const void* const* data, size_t count);
+
+	void destroy(Entity entity);
+
+	bool alive(Entity entity) const {
+		return entity.index < records.size() && records[entity.index].generation == entity.generation && records[entity.index].archetype;
+	}
+
+	template<typename T>
+	T* get(Entity entity){
+		if(!alive(entity)){ return nullptr; }
+		const Record& r = records[entity.index];
+		if(!(r.archetype->mask & (ComponentMask(1) << component_id<T>()))){ return nullptr; }
+		return r.archetype->column<T>(r.archetype->chunks[r.chunk]) + r.row;
+	}
+
+	template<typename T>
+	void add(Entity entity, const T& value){ add_raw(entity, component_id<T>(), &value); }
+
+	template<typename T>
+	void remove(Entity entity){ remove_raw(entity, component_id<T>()); }
+
+	void add_raw(Entity entity, ComponentId id, const void* data);
+	void remove_raw(Entity entity, ComponentId id);
+
+	/**
+	 * @brief Calls `f(count, entities, Ts*...)` once per chunk holding all of Ts
+	 *
+	 * The arrays are the chunk's columns, `count` long.
+	 */
+	template<typename... Ts, typename F>
+	void each_chunk(F&& f){
+		ComponentMask required = component_mask<Ts...>();
+		for(auto& archetype : archetypes){
+			if((archetype->mask & required) != required){ continue; }
+			for(auto& chunk : archetype->chunks){
+				if(chunk.count == 0){ continue; }
+				f(chunk.count, static_cast<const Entity*>(archetype->entities(chunk)), archetype->template column<Ts>(chunk)...);
+			}
+		}
+	}
+
+	/**
+	 * @brief Calls `f(entity, Ts&...)` for every entity holding all of Ts
+	 */
+	template<typename... Ts, typename F>
+	void each(F&& f){
+		each_chunk<Ts...>([&](u32 count, const Entity* entities, Ts*... columns){
+			for(u32 i = 0; i < count; i++){ f(entities[i], columns[i]...); }
+		});
+	}
+
+	/**
+	 * @brief `each_chunk` spread over a thread pool, one task per chunk
+	 *
+	 * `f(worker, count, entities, Ts*...)` may run concurrently for
+	 * different chunks. `worker` indexes per thread state such as one
+	 * `CommandBuffer` per worker.
+	 */
+	template<typename... Ts, typename F>
+	void par_each_chunk(ThreadPool& pool, F&& f){
+		ComponentMask required = component_mask<Ts...>();
+		std::vector<std::pair<Archetype*, ArchetypeChunk*>> work;
+		for(auto& archetype : archetypes){
+			if((archetype->mask & required) != required){ continue; }
+			for(auto& chunk : archetype->chunks){
+				if(chunk.count > 0){ work.emplace_back(archetype.get(), &chunk); }
+			}
+		}
+		pool.parallel_for(work.size(), [&](size_t i, u32 worker){
+			Archetype* archetype = work[i].first;
+			ArchetypeChunk& chunk = *work[i].second;
+			f(worker, chunk.count, static_cast<const Entity*>(archetype->entities(chunk)), archetype->template column<Ts>(chunk)...);
+		});
+	}
+
+	size_t size() const { return live; }
+	size_t archetype_count() const { return archetypes.size(); }
+
+private:
+	struct Record {
+		Archetype* archetype = nullptr;
+		u32 chunk = 0;
+		u32 row = 0;
+		u32 generation = 0;
+	};
+
+	Archetype& get_archetype(ComponentMask mask);
+	Entity allocate_entity();
+
+	/**
+	 * @brief Appends a row to an archetype, components left uninitialized
+	 */
+	void push_row(Archetype& archetype, Entity entity);
+
+	/**
+	 * @brief Removes a row by moving the archetype's last row into it
+	 */
+	void erase_row(Archetype& archetype, u32 chunk, u32 row);
+
+	/**
+	 * @brief Moves an entity to the archetype with `mask`, copying shared components
+	 */
+	void move_entity(Entity entity, ComponentMask mask);
+
+	std::vector<Record> records;
+	std::vector<u32> free_indices;
+	std::vector<std::unique_ptr<Archetype>> archetypes;
+	std::unordered_map<ComponentMask, Archetype*> archetype_by_mask;
+	size_t live = 0;
+};
+
+}	// namespace ecs
+}	// namespace uni
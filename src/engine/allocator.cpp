@@ -0,0 +1,127 @@
+/**
+ * @file src/engine/allocator.cpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#include "engine/allocator.hpp"
+
+#include "util/util.hpp"
+
+#include <exception>
+
+namespace uni {
+namespace eng {
+
+FreeListAllocator::FreeListAllocator(u64 capacity) : capacity{capacity} {
+	if(capacity > 0){ insert_free(0, capacity); }
+}
+
+std::optional<u64> FreeListAllocator::allocate(u64 size){
+	if(size == 0){ return std::nullopt; }
+
+	// Best fit: smallest free block that is large enough
+	auto fit = free_by_size.lower_bound(size);
+	if(fit == free_by_size.end()){ return std::nullopt; }
+
+	u64 offset = fit->second;
+	auto block = free_blocks.find(offset);
+	u64 block_size = block->second;
+	erase_free(block);
+	if(block_size > size){ insert_free(offset + size, block_size - size); }
+
+	allocations[offset] = size;
+	used += size;
+	return offset;
+}
+
+void FreeListAllocator::free(u64 offset){
+	auto allocation = allocations.find(offset);
+	if(allocation == allocations.end()){
+		ERROR("ALLOCATOR", "Free of unknown offset " << offset);
+		throw std::exception();
+	}
+	u64 size = allocation->second;
+	allocations.erase(allocation);
+	moved.erase(offset);
+	used -= size;
+
+	// Coalesce with the free neighbours on both sides
+	auto next = free_blocks.lower_bound(offset);
+	if(next != free_blocks.begin()){
+		auto prev = std::prev(next);
+		if(prev->first + prev->second == offset){
+			offset = prev->first;
+			size += prev->second;
+			erase_free(prev);
+		}
+	}
+	next = free_blocks.lower_bound(offset);
+	if(next != free_blocks.end() && offset + size == next->first){
+		size += next->second;
+		erase_free(next);
+	}
+	insert_free(offset, size);
+}
+
+std::vector<AllocationMove> FreeListAllocator::compact(u64 budget, const std::function<bool(u64)>& movable){
+	std::vector<AllocationMove> moves;
+	std::vector<std::pair<u64, u64>> candidates(allocations.rbegin(), allocations.rend());
+
+	u64 moved_units = 0;
+	for(const auto& [offset, size] : candidates){
+		if(free_blocks.empty() || free_blocks.begin()->first >= offset){ break; }
+		if(moved_units + size > budget || moved.count(offset) || !movable(offset)){ continue; }
+
+		// Lowest hole below the allocation that can hold it
+		auto hole = free_blocks.end();
+		for(auto block = free_blocks.begin(); block != free_blocks.end() && block->first < offset; block++){
+			if(block->second >= size){
+				hole = block;
+				break;
+			}
+		}
+		if(hole == free_blocks.end()){ continue; }
+
+		u64 dst = hole->first;
+		u64 hole_size = hole->second;
+		erase_free(hole);
+		if(hole_size > size){ insert_free(dst + size, hole_size - size); }
+		allocations[dst] = size;
+		used += size;
+
+		moves.push_back({offset, dst, size});
+		moved.insert(offset);
+		moved_units += size;
+	}
+	return moves;
+}
+
+f32 FreeListAllocator::fragmentation() const {
+	u64 total = capacity - used;
+	if(total == 0){ return 0.0f; }
+	return 1.0f - static_cast<f32>(get_largest_free()) / static_cast<f32>(total);
+}
+
+u64 FreeListAllocator::get_largest_free() const {
+	return free_by_size.empty() ? 0 : free_by_size.rbegin()->first;
+}
+
+void FreeListAllocator::insert_free(u64 offset, u64 size){
+	free_blocks[offset] = size;
+	free_by_size.emplace(size, offset);
+}
+
+void FreeListAllocator::erase_free(std::map<u64, u64>::iterator block){
+	auto range = free_by_size.equal_range(block->second);
+	for(auto it = range.first; it != range.second; it++){
+		if(it->second == block->first){
+			free_by_size.erase(it);
+			break;
+		}
+	}
+	free_blocks.erase(block);
+}
+
+}	// namespace eng
+}	// namespace uni
@@ -0,0 +1,94 @@
+/**
+ * @file src/engine/allocator.hpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#pragma once
+
+#include "util/types.hpp"
+
+#include <functional>
+#include <map>
+#include <optional>
+#include <set>
+#include <vector>
+
+namespace uni {
+namespace eng {
+
+/**
+ * @brief A pending move of one allocation produced by compaction
+ */
+struct AllocationMove {
+	u64 src;
+	u64 dst;
+	u64 size;
+};
+
+/**
+ * @brief Free-list allocator over an abstract range [0, capacity)
+ *
+ * Knows nothing about vulkan, it only hands out offsets. Units are
+ * whatever the owner decides (bytes, vertices, indices). Free blocks
+ * are coalesced on free and allocation is best-fit.
+ */
+class FreeListAllocator {
+public:
+	FreeListAllocator(u64 capacity);
+
+	/**
+	 * @brief Allocates a block
+	 * @param[in] size Units to allocate, must be non zero
+	 * @return Offset of the block or nothing if no free block is large enough
+	 */
+	std::optional<u64> allocate(u64 size);
+
+	/**
+	 * @brief Frees a block previously returned by `allocate`
+	 * @param[in] offset
+	 * @return void
+	 */
+	void free(u64 offset);
+
+	/**
+	 * @brief Moves allocations towards the front of the range
+	 *
+	 * Walks allocations from the back and moves each one into the lowest
+	 * free block below it that fits. The destination is allocated but the
+	 * source is NOT freed, the caller frees it once nothing reads it any
+	 * more. This keeps every source and destination of one call disjoint
+	 * so all moves can be executed as a single copy. Sources waiting to be
+	 * freed are never moved again.
+	 *
+	 * @param[in] budget Maximum units to move
+	 * @param[in] movable Returns false for allocations that must stay put
+	 * @return Moves performed, in no particular order
+	 */
+	std::vector<AllocationMove> compact(u64 budget, const std::function<bool(u64)>& movable);
+
+	/**
+	 * @brief How scattered the free space is
+	 * @return 1 - largest free block / total free, 0 when free space is contiguous
+	 */
+	f32 fragmentation() const;
+
+	u64 get_capacity() const { return capacity; }
+	u64 get_used() const { return used; }
+	u64 get_largest_free() const;
+	size_t get_allocation_count() const { return allocations.size(); }
+
+private:
+	void insert_free(u64 offset, u64 size);
+	void erase_free(std::map<u64, u64>::iterator block);
+
+	u64 capacity;
+	u64 used = 0;
+	std::map<u64, u64> allocations;          // offset -> size
+	std::map<u64, u64> free_blocks;          // offset -> size
+	std::multimap<u64, u64> free_by_size;    // size -> offset
+	std::set<u64> moved;                     // compaction sources not yet freed
+};
+
+}	// namespace eng
+}	// namespace uni
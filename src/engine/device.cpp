@@ -11,6 +11,8 @@
 
 #include "util/util.hpp"
 
+#include <fstream>
+
 namespace uni {
 namespace eng {
 
@@ -60,11 +62,9 @@ Device::Device(Window& window) : window{window} {
  * 
  * Cleans up:
  *  1. Vulkan Debugger
- *  2. Command Buffers
+ *  2. Command Pool
  *  3. Logical Device / Queues
  *  4. Vulkan Instance
- *
- * TODO: Destroy command buffers
  */
 Device::~Device(){
 	if(enable_validation_layers){
@@ -72,6 +72,9 @@ Device::~Device(){
 		VK_INFO("Destroyed Vulkan Debugger.");
 	}
 
+    vkDestroyCommandPool(device, command_pool, nullptr);
+    VK_INFO("Destroyed Command Pool.");
+
     vkDestroyDevice(device, nullptr);
     VK_INFO("Destroyed Logical Device.");
 
@@ -86,9 +89,6 @@ Device::~Device(){
 /**
  * @brief Initializes device
  *
- * TODO create logical device
- * TODO create command pool
- *
  * @note Called by constructor
  * @return void
  */
@@ -98,6 +98,8 @@ void Device::initialize(){
 	window.create_surface(instance, &surface);
 	pick_physical_device();
 	create_logical_device();
+	create_command_pool();
+	poll_memory();
 }
 	
 /**
@@ -199,6 +201,14 @@ std::vector<const char*> Device::get_required_extensions(){
     std::vector<VkExtensionProperties> available_extensions(available_extension_count); // set up vector to hold VkExtensionProperties structs
     vkEnumerateInstanceExtensionProperties(nullptr, &available_extension_count, available_extensions.data());   // get VkExtensionProperties structs
 
+    // Needed to query memory budget and priority support on vulkan 1.0
+    for(const auto& e : available_extensions){
+        if(std::strcmp(e.extensionName, VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME) == 0){
+            extensions.push_back(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
+            properties2 = true;
+        }
+    }
+
     VK_INFO("number of available extensions: " << available_extension_count);
     
 #ifndef NDEBUG
@@ -439,8 +449,9 @@ SwapChainSupportDetails Device::query_swapchain_support(VkPhysicalDevice physica
  * queue and a present queue. Before calling this function 
  * a physical device must have been picked.
  *
- * TODO Enable needed features
- * 
+ * Optional features are enabled when supported, check
+ * `get_features` before relying on one.
+ *
  * @note Stores created logical device in `device`
  * @return void
  */
@@ -464,16 +475,52 @@ void Device::create_logical_device(){
 	device_queue_info.queueFamilyIndex = indices.present.value();
 	create_infos.push_back(device_queue_info);
 
-	// TODO Enable some features
-    VkPhysicalDeviceFeatures features = {};
+	// Lets every section draw in one vkCmdDrawIndirect
+	VkPhysicalDeviceFeatures supported;
+	vkGetPhysicalDeviceFeatures(physical_device, &supported);
+	features.multiDrawIndirect = supported.multiDrawIndirect;
+
+	/*
+	 * Budget and priority tell how close we are to running out of device
+	 * memory and which allocations to page out first. Both need the
+	 * properties2 instance extension to be queried.
+	 */
+	std::vector<const char*> extensions = enabled_extensions;
+	std::set<std::string> available;
+	u32 extension_count = 0;
+	vkEnumerateDeviceExtensionProperties(physical_device, nullptr, &extension_count, nullptr);
+	std::vector<VkExtensionProperties> extension_properties(extension_count);
+	vkEnumerateDeviceExtensionProperties(physical_device, nullptr, &extension_count, extension_properties.data());
+	for(const auto& extension : extension_properties){ available.insert(extension.extensionName); }
+
+	if(properties2 && available.count(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME)){
+		get_memory_properties2 = reinterpret_cast<PFN_vkGetPhysicalDeviceMemoryProperties2KHR>(vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceMemoryProperties2KHR"));
+		memory_budget = get_memory_properties2 != nullptr;
+	}
+	VkPhysicalDeviceMemoryPriorityFeaturesEXT priority_features = {};
+	priority_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PRIORITY_FEATURES_EXT;
+	if(properties2 && available.count(VK_EXT_MEMORY_PRIORITY_EXTENSION_NAME)){
+		auto get_features2 = reinterpret_cast<PFN_vkGetPhysicalDeviceFeatures2KHR>(vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceFeatures2KHR"));
+		if(get_features2 != nullptr){
+			VkPhysicalDeviceFeatures2 features2 = {};
+			features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+			features2.pNext = &priority_features;
+			get_features2(physical_device, &features2);
+			priority_features.pNext = nullptr;
+		}
+		memory_priority = priority_features.memoryPriority == VK_TRUE;
+	}
+	if(memory_budget){ extensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME); }
+	if(memory_priority){ extensions.push_back(VK_EXT_MEMORY_PRIORITY_EXTENSION_NAME); }
 
     VkDeviceCreateInfo create_info = {};
     create_info.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+    create_info.pNext = memory_priority ? &priority_features : nullptr;
     create_info.queueCreateInfoCount = static_cast<uint32_t>(create_infos.size());
     create_info.pQueueCreateInfos = create_infos.data();
     create_info.pEnabledFeatures = &features;
-    create_info.enabledExtensionCount = static_cast<uint32_t>(enabled_extensions.size());
-    create_info.ppEnabledExtensionNames = enabled_extensions.data();
+    create_info.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
+    create_info.ppEnabledExtensionNames = extensions.data();
     create_info.enabledLayerCount = static_cast<uint32_t>(enabled_layers.size());
     create_info.ppEnabledLayerNames = enabled_layers.data();
     
@@ -483,12 +530,335 @@ void Device::create_logical_device(){
     	throw std::exception();
     }
     VK_INFO("Created Logical Device.");
+    if(memory_budget){ VK_INFO("Enabled " << VK_EXT_MEMORY_BUDGET_EXTENSION_NAME << "."); }
+    if(memory_priority){ VK_INFO("Enabled " << VK_EXT_MEMORY_PRIORITY_EXTENSION_NAME << "."); }
+    vkGetPhysicalDeviceMemoryProperties(physical_device, &memory_properties);
     VK_INFO("Created Graphics Queue.");
     VK_INFO("Created Present Queue.");
     vkGetDeviceQueue(device, indices.graphics.value(), 0, &graphics_queue);
     vkGetDeviceQueue(device, indices.present.value(), 0, &present_queue);
 }
 
+/**
+ * @brief Creates the command pool for the graphics queue family
+ * @note Stores created pool in `command_pool`
+ * @return void
+ */
+void Device::create_command_pool(){
+	QueueFamilyIndices indices = find_queue_families(physical_device);
+
+	VkCommandPoolCreateInfo create_info = {};
+	create_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+	create_info.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+	create_info.queueFamilyIndex = indices.graphics.value();
+
+	if(vkCreateCommandPool(device, &create_info, nullptr, &command_pool) != VK_SUCCESS){
+		VK_ERROR("Failed to create command pool.");
+		throw std::exception();
+	}
+	VK_INFO("Created Command Pool.");
+}
+
+/**
+ * @brief Finds a memory type index
+ * @param[in] type_filter Bitmask of acceptable types from VkMemoryRequirements
+ * @param[in] properties Properties the memory type must have
+ * @return Index of the first matching memory type
+ */
+u32 Device::find_memory_type(u32 type_filter, VkMemoryPropertyFlags properties){
+	VkPhysicalDeviceMemoryProperties memory_properties;
+	vkGetPhysicalDeviceMemoryProperties(physical_device, &memory_properties);
+
+	for(u32 i = 0; i < memory_properties.memoryTypeCount; i++){
+		if((type_filter & (1 << i)) && (memory_properties.memoryTypes[i].propertyFlags & properties) == properties){
+			return i;
+		}
+	}
+	VK_ERROR("Failed to find suitable memory type.");
+	throw std::exception();
+}
+
+/**
+ * @brief Checks for a memory type without throwing, e.g. for LAZILY_ALLOCATED
+ * @param[in] type_filter Bitmask of acceptable types from VkMemoryRequirements
+ * @param[in] properties Properties the memory type must have
+ * @return If any acceptable type has all the properties
+ */
+bool Device::has_memory_type(u32 type_filter, VkMemoryPropertyFlags properties) const {
+	for(u32 i = 0; i < memory_properties.memoryTypeCount; i++){
+		if((type_filter & (1 << i)) && (memory_properties.memoryTypes[i].propertyFlags & properties) == properties){ return true; }
+	}
+	return false;
+}
+
+/**
+ * @brief Picks the first format supporting the given features
+ * @param[in] candidates In order of preference
+ * @param[in] tiling
+ * @param[in] features
+ * @return The format, throws when none is supported
+ */
+VkFormat Device::find_supported_format(const std::vector<VkFormat>& candidates, VkImageTiling tiling, VkFormatFeatureFlags features){
+	for(VkFormat format : candidates){
+		VkFormatProperties properties;
+		vkGetPhysicalDeviceFormatProperties(physical_device, format, &properties);
+		VkFormatFeatureFlags supported = tiling == VK_IMAGE_TILING_OPTIMAL ? properties.optimalTilingFeatures : properties.linearTilingFeatures;
+		if((supported & features) == features){ return format; }
+	}
+	VK_ERROR("Failed to find supported format.");
+	throw std::exception();
+}
+
+/**
+ * @brief Picks a depth attachment format this device supports
+ * @param[in] stencil Whether a stencil aspect is needed too
+ * @return D32_SFLOAT when possible
+ */
+VkFormat Device::find_depth_format(bool stencil){
+	// D24 is not supported everywhere, D32 with stencil is the usual fallback
+	std::vector<VkFormat> candidates = {VK_FORMAT_D32_SFLOAT, VK_FORMAT_D24_UNORM_S8_UINT, VK_FORMAT_D32_SFLOAT_S8_UINT, VK_FORMAT_D16_UNORM};
+	if(stencil){ candidates = {VK_FORMAT_D24_UNORM_S8_UINT, VK_FORMAT_D32_SFLOAT_S8_UINT}; }
+	return find_supported_format(candidates, VK_IMAGE_TILING_OPTIMAL, VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT);
+}
+
+/**
+ * @brief Creates a buffer and binds freshly allocated memory to it
+ * @param[in] size Size of the buffer in bytes
+ * @param[in] usage How the buffer will be used
+ * @param[in] properties Properties of the memory backing the buffer
+ * @param[out] buffer
+ * @param[out] memory Freed with `free_memory`
+ * @param[in] priority 0 to 1, higher stays resident longer under VK_EXT_memory_priority
+ * @return void
+ */
+void Device::create_buffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& buffer, VkDeviceMemory& memory, f32 priority){
+	VkBufferCreateInfo buffer_info = {};
+	buffer_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+	buffer_info.size = size;
+	buffer_info.usage = usage;
+	buffer_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+	if(vkCreateBuffer(device, &buffer_info, nullptr, &buffer) != VK_SUCCESS){
+		VK_ERROR("Failed to create buffer.");
+		throw std::exception();
+	}
+
+	VkMemoryRequirements requirements;
+	vkGetBufferMemoryRequirements(device, buffer, &requirements);
+
+	if(allocate_memory(requirements, properties, priority, memory) != VK_SUCCESS){
+		VK_ERROR("Failed to allocate buffer memory.");
+		vkDestroyBuffer(device, buffer, nullptr);
+		throw std::exception();
+	}
+	vkBindBufferMemory(device, buffer, memory, 0);
+}
+
+/**
+ * @brief Creates an image and binds freshly allocated memory to it
+ * @param[in] info Full description of the image
+ * @param[in] properties Properties of the memory backing the image
+ * @param[out] image
+ * @param[out] memory Freed with `free_memory`
+ * @param[in] priority 0 to 1, higher stays resident longer under VK_EXT_memory_priority
+ * @return void
+ */
+void Device::create_image(const VkImageCreateInfo& info, VkMemoryPropertyFlags properties, VkImage& image, VkDeviceMemory& memory, f32 priority){
+	if(vkCreateImage(device, &info, nullptr, &image) != VK_SUCCESS){
+		VK_ERROR("Failed to create image.");
+		throw std::exception();
+	}
+
+	VkMemoryRequirements requirements;
+	vkGetImageMemoryRequirements(device, image, &requirements);
+
+	if(allocate_memory(requirements, properties, priority, memory) != VK_SUCCESS){
+		VK_ERROR("Failed to allocate image memory.");
+		vkDestroyImage(device, image, nullptr);
+		throw std::exception();
+	}
+	vkBindImageMemory(device, image, memory, 0);
+}
+
+/**
+ * @brief Allocates memory for a resource and records it against its heap
+ *
+ * What `create_buffer` and `create_image` allocate with, for memory
+ * bound by hand such as memory shared by several images.
+ *
+ * @param[in] requirements
+ * @param[in] properties
+ * @param[in] priority 0 to 1, higher stays resident longer under VK_EXT_memory_priority
+ * @param[out] memory Freed with `free_memory`
+ * @return Result of vkAllocateMemory
+ */
+VkResult Device::allocate_memory(const VkMemoryRequirements& requirements, VkMemoryPropertyFlags properties, f32 priority, VkDeviceMemory& memory){
+	VkMemoryAllocateInfo allocate_info = {};
+	allocate_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+	allocate_info.allocationSize = requirements.size;
+	allocate_info.memoryTypeIndex = find_memory_type(requirements.memoryTypeBits, properties);
+
+	VkMemoryPriorityAllocateInfoEXT priority_info = {};
+	priority_info.sType = VK_STRUCTURE_TYPE_MEMORY_PRIORITY_ALLOCATE_INFO_EXT;
+	priority_info.priority = priority;
+	if(memory_priority){ allocate_info.pNext = &priority_info; }
+
+	VkResult result = vkAllocateMemory(device, &allocate_info, nullptr, &memory);
+	if(result == VK_SUCCESS){
+		u32 heap = memory_properties.memoryTypes[allocate_info.memoryTypeIndex].heapIndex;
+		allocations[memory] = {heap, requirements.size};
+		allocated[heap] += requirements.size;
+	}
+	return result;
+}
+
+/**
+ * @brief Frees memory from `create_buffer` or `create_image`
+ * @param[in] memory
+ * @return void
+ */
+void Device::free_memory(VkDeviceMemory memory){
+	auto it = allocations.find(memory);
+	if(it != allocations.end()){
+		allocated[it->second.first] -= it->second.second;
+		allocations.erase(it);
+	}
+	vkFreeMemory(device, memory, nullptr);
+}
+
+/**
+ * @brief Reads the budget and usage of every heap, meant to be called once per frame
+ *
+ * Exact with VK_EXT_memory_budget. Without it a heap's budget is taken
+ * as 80% of its size, roughly what the OS and other applications leave
+ * over, and its usage as what was allocated through this Device.
+ *
+ * @return The stats also returned by `get_memory_stats`
+ */
+const MemoryStats& Device::poll_memory(){
+	VkPhysicalDeviceMemoryBudgetPropertiesEXT budget = {};
+	budget.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+	if(memory_budget){
+		VkPhysicalDeviceMemoryProperties2 properties = {};
+		properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+		properties.pNext = &budget;
+		get_memory_properties2(physical_device, &properties);
+	}
+
+	memory_stats.exact = memory_budget;
+	memory_stats.heaps.resize(memory_properties.memoryHeapCount);
+	for(u32 i = 0; i < memory_properties.memoryHeapCount; i++){
+		MemoryHeapStats& heap = memory_stats.heaps[i];
+		heap.size = memory_properties.memoryHeaps[i].size;
+		heap.device_local = memory_properties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT;
+		heap.allocated = allocated[i];
+		if(memory_budget){
+			heap.budget = budget.heapBudget[i];
+			heap.usage = budget.heapUsage[i];
+		} else {
+			heap.budget = heap.size / 10 * 8;
+			heap.usage = heap.allocated;
+		}
+	}
+	return memory_stats;
+}
+
+/**
+ * @brief Creates a 2D view of a whole image
+ * @param[in] image
+ * @param[in] format Format the image was created with
+ * @param[in] aspect Color or depth
+ * @return The image view, destroyed by the caller
+ */
+VkImageView Device::create_image_view(VkImage image, VkFormat format, VkImageAspectFlags aspect){
+	VkImageViewCreateInfo view_info = {};
+	view_info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+	view_info.image = image;
+	view_info.viewType = VK_IMAGE_VIEW_TYPE_2D;
+	view_info.format = format;
+	view_info.subresourceRange.aspectMask = aspect;
+	view_info.subresourceRange.levelCount = 1;
+	view_info.subresourceRange.layerCount = 1;
+
+	VkImageView view;
+	if(vkCreateImageView(device, &view_info, nullptr, &view) != VK_SUCCESS){
+		VK_ERROR("Failed to create image view.");
+		throw std::exception();
+	}
+	return view;
+}
+
+/**
+ * @brief Allocates and begins a one time command buffer
+ * @return The command buffer in the recording state
+ */
+VkCommandBuffer Device::begin_single_time_commands(){
+	VkCommandBufferAllocateInfo allocate_info = {};
+	allocate_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+	allocate_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+	allocate_info.commandPool = command_pool;
+	allocate_info.commandBufferCount = 1;
+
+	VkCommandBuffer command_buffer;
+	vkAllocateCommandBuffers(device, &allocate_info, &command_buffer);
+
+	VkCommandBufferBeginInfo begin_info = {};
+	begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+	begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+	vkBeginCommandBuffer(command_buffer, &begin_info);
+	return command_buffer;
+}
+
+/**
+ * @brief Ends, submits and frees a one time command buffer
+ *
+ * Waits for the graphics queue to go idle before returning.
+ *
+ * @param[in] command_buffer Buffer from `begin_single_time_commands`
+ * @return void
+ */
+void Device::end_single_time_commands(VkCommandBuffer command_buffer){
+	vkEndCommandBuffer(command_buffer);
+
+	VkSubmitInfo submit_info = {};
+	submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+	submit_info.commandBufferCount = 1;
+	submit_info.pCommandBuffers = &command_buffer;
+
+	vkQueueSubmit(graphics_queue, 1, &submit_info, VK_NULL_HANDLE);
+	vkQueueWaitIdle(graphics_queue);
+	vkFreeCommandBuffers(device, command_pool, 1, &command_buffer);
+}
+
+/**
+ * @brief Creates a shader module from a SPIR-V file
+ * @param[in] path Path to the compiled shader
+ * @return The shader module, destroyed by the caller
+ */
+VkShaderModule Device::create_shader_module(const std::string& path){
+	std::ifstream file(path, std::ios::ate | std::ios::binary);
+	if(!file.is_open()){
+		VK_ERROR("Failed to open shader " << path << ".");
+		throw std::exception();
+	}
+
+	// SPIR-V is read as 32 bit words
+	std::vector<u32> code((static_cast<size_t>(file.tellg()) + 3) / 4);
+	file.seekg(0);
+	file.read(reinterpret_cast<char*>(code.data()), code.size() * sizeof(u32));
+
+	VkShaderModuleCreateInfo create_info = {};
+	create_info.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+	create_info.codeSize = code.size() * sizeof(u32);
+	create_info.pCode = code.data();
+
+	VkShaderModule module;
+	if(vkCreateShaderModule(device, &create_info, nullptr, &module) != VK_SUCCESS){
+		VK_ERROR("Failed to create shader module from " << path << ".");
+		throw std::exception();
+	}
+	return module;
+}
+
 }   // namespace eng
 }   // namespace uni
-
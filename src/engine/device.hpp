@@ -7,13 +7,17 @@
 #pragma once
 
 #include "engine/window.hpp"
+#include "util/types.hpp"
 
 #include <vulkan/vulkan.h>
 
+#include <array>
 #include <vector>
 #include <optional>
 #include <cstring>
 #include <set>
+#include <string>
+#include <unordered_map>
 
 namespace uni {
 namespace eng {
@@ -39,6 +43,22 @@ struct QueueFamilyIndices {
     }
 };
 
+/**
+ * @brief Memory of one heap as seen by this process
+ */
+struct MemoryHeapStats {
+	VkDeviceSize size = 0;
+	VkDeviceSize budget = 0;        // what this process may use before the driver starts paging
+	VkDeviceSize usage = 0;         // what this process uses
+	VkDeviceSize allocated = 0;     // through this Device
+	bool device_local = false;
+};
+
+struct MemoryStats {
+	std::vector<MemoryHeapStats> heaps;
+	bool exact = false;             // from VK_EXT_memory_budget, estimated otherwise
+};
+
 /**
  * @brief Creates interface with vulkan device
  */
@@ -62,11 +82,9 @@ public:
  	* 
  	* Cleans up:
  	*  1. Vulkan Debugger
- 	*  2. Command Buffers
+ 	*  2. Command Pool
  	*  3. Logical Device / Queues
  	*  4. Vulkan Instance
- 	*
- 	* TODO: Destroy command buffers
  	*/
 	~Device();
 
@@ -75,14 +93,136 @@ public:
     VkQueue get_graphics_queue() const { return graphics_queue; }
     VkQueue get_present_queue() const { return present_queue; }
     SwapChainSupportDetails get_swapchain_support() { return query_swapchain_support(physical_device); }
+    VkPhysicalDevice get_physical_device() const { return physical_device; }
+    VkCommandPool get_command_pool() const { return command_pool; }
+    const VkPhysicalDeviceFeatures& get_features() const { return features; }
+    bool has_memory_budget() const { return memory_budget; }
+    bool has_memory_priority() const { return memory_priority; }
+    const MemoryStats& get_memory_stats() const { return memory_stats; }
+
+	/**
+	 * @brief Finds a memory type index
+	 * @param[in] type_filter Bitmask of acceptable types from VkMemoryRequirements
+	 * @param[in] properties Properties the memory type must have
+	 * @return Index of the first matching memory type
+	 */
+	u32 find_memory_type(u32 type_filter, VkMemoryPropertyFlags properties);
+
+	/**
+	 * @brief Checks for a memory type without throwing, e.g. for LAZILY_ALLOCATED
+	 * @param[in] type_filter Bitmask of acceptable types from VkMemoryRequirements
+	 * @param[in] properties Properties the memory type must have
+	 * @return If any acceptable type has all the properties
+	 */
+	bool has_memory_type(u32 type_filter, VkMemoryPropertyFlags properties) const;
+
+	/**
+	 * @brief Picks the first format supporting the given features
+	 * @param[in] candidates In order of preference
+	 * @param[in] tiling
+	 * @param[in] features
+	 * @return The format, throws when none is supported
+	 */
+	VkFormat find_supported_format(const std::vector<VkFormat>& candidates, VkImageTiling tiling, VkFormatFeatureFlags features);
+
+	/**
+	 * @brief Picks a depth attachment format this device supports
+	 * @param[in] stencil Whether a stencil aspect is needed too
+	 * @return D32_SFLOAT when possible
+	 */
+	VkFormat find_depth_format(bool stencil = false);
+
+	/**
+	 * @brief Allocates memory for a resource and records it against its heap
+	 *
+	 * What `create_buffer` and `create_image` allocate with, for memory
+	 * bound by hand such as memory shared by several images.
+	 *
+	 * @param[in] requirements
+	 * @param[in] properties
+	 * @param[in] priority 0 to 1, higher stays resident longer under VK_EXT_memory_priority
+	 * @param[out] memory Freed with `free_memory`
+	 * @return Result of vkAllocateMemory
+	 */
+	VkResult allocate_memory(const VkMemoryRequirements& requirements, VkMemoryPropertyFlags properties, f32 priority, VkDeviceMemory& memory);
+
+	/**
+	 * @brief Creates a buffer and binds freshly allocated memory to it
+	 * @param[in] size Size of the buffer in bytes
+	 * @param[in] usage How the buffer will be used
+	 * @param[in] properties Properties of the memory backing the buffer
+	 * @param[out] buffer
+	 * @param[out] memory Freed with `free_memory`
+	 * @param[in] priority 0 to 1, higher stays resident longer under VK_EXT_memory_priority
+	 * @return void
+	 */
+	void create_buffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& buffer, VkDeviceMemory& memory, f32 priority = 0.5f);
+
+	/**
+	 * @brief Creates an image and binds freshly allocated memory to it
+	 * @param[in] info Full description of the image
+	 * @param[in] properties Properties of the memory backing the image
+	 * @param[out] image
+	 * @param[out] memory Freed with `free_memory`
+	 * @param[in] priority 0 to 1, higher stays resident longer under VK_EXT_memory_priority
+	 * @return void
+	 */
+	void create_image(const VkImageCreateInfo& info, VkMemoryPropertyFlags properties, VkImage& image, VkDeviceMemory& memory, f32 priority = 0.5f);
+
+	/**
+	 * @brief Frees memory from `create_buffer` or `create_image`
+	 * @param[in] memory
+	 * @return void
+	 */
+	void free_memory(VkDeviceMemory memory);
+
+	/**
+	 * @brief Reads the budget and usage of every heap, meant to be called once per frame
+	 *
+	 * Exact with VK_EXT_memory_budget. Without it a heap's budget is taken
+	 * as 80% of its size, roughly what the OS and other applications leave
+	 * over, and its usage as what was allocated through this Device.
+	 *
+	 * @return The stats also returned by `get_memory_stats`
+	 */
+	const MemoryStats& poll_memory();
+
+	/**
+	 * @brief Creates a 2D view of a whole image
+	 * @param[in] image
+	 * @param[in] format Format the image was created with
+	 * @param[in] aspect Color or depth
+	 * @return The image view, destroyed by the caller
+	 */
+	VkImageView create_image_view(VkImage image, VkFormat format, VkImageAspectFlags aspect);
+
+	/**
+	 * @brief Allocates and begins a one time command buffer
+	 * @return The command buffer in the recording state
+	 */
+	VkCommandBuffer begin_single_time_commands();
+
+	/**
+	 * @brief Ends, submits and frees a one time command buffer
+	 *
+	 * Waits for the graphics queue to go idle before returning.
+	 *
+	 * @param[in] command_buffer Buffer from `begin_single_time_commands`
+	 * @return void
+	 */
+	void end_single_time_commands(VkCommandBuffer command_buffer);
+
+	/**
+	 * @brief Creates a shader module from a SPIR-V file
+	 * @param[in] path Path to the compiled shader
+	 * @return The shader module, destroyed by the caller
+	 */
+	VkShaderModule create_shader_module(const std::string& path);
 
 private:
 	/**
 	 * @brief Initializes device
 	 *
-	 * TODO create logical device
-	 * TODO create command pool
-	 *
 	 * @note Called by constructor
 	 * @return void
 	 */
@@ -201,13 +341,21 @@ private:
  	 * queue and a present queue. Before calling this function 
  	 * a physical device must have been picked.
  	 *
- 	 * TODO Enable needed features
- 	 * 
+ 	 * Optional features are enabled when supported, check
+ 	 * `get_features` before relying on one.
+ 	 *
  	 * @note Stores created logical device in `device`
  	 * @return void
  	 */
     void create_logical_device();
 
+	/**
+ 	 * @brief Creates the command pool for the graphics queue family
+ 	 * @note Stores created pool in `command_pool`
+ 	 * @return void
+ 	 */
+	void create_command_pool();
+
     VkInstance instance;
     Window& window;
     VkDebugUtilsMessengerEXT debug_messenger;
@@ -216,6 +364,19 @@ private:
     VkDevice device;
     VkQueue graphics_queue;
     VkQueue present_queue;
+    VkCommandPool command_pool;
+    VkPhysicalDeviceFeatures features = {};
+
+    // Optional extensions, enabled when the driver has them
+    bool properties2 = false;
+    bool memory_budget = false;
+    bool memory_priority = false;
+    PFN_vkGetPhysicalDeviceMemoryProperties2KHR get_memory_properties2 = nullptr;
+
+    VkPhysicalDeviceMemoryProperties memory_properties = {};
+    std::array<VkDeviceSize, VK_MAX_MEMORY_HEAPS> allocated = {};
+    std::unordered_map<VkDeviceMemory, std::pair<u32, VkDeviceSize>> allocations;   // heap and size
+    MemoryStats memory_stats;
 
 #ifdef NDEBUG
     const bool enable_validation_layers = false;
@@ -5,5 +5,13 @@
  */
 
 #include "engine/window.hpp"
+#include "engine/frame_pacer.hpp"
 #include "engine/device.hpp"
-
+#include "engine/allocator.hpp"
+#include "engine/staging_ring.hpp"
+#include "engine/mesh_arena.hpp"
+#include "engine/instance_renderer.hpp"
+#include "engine/gpu_mesher.hpp"
+#include "engine/far_field.hpp"
+#include "engine/memory_budget.hpp"
+#include "engine/render_targets.hpp"
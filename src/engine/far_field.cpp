@@ -0,0 +1,345 @@
+/**
+ * @file src/engine/far_field.cpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#include "engine/far_field.hpp"
+
+#include "util/util.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace uni {
+namespace eng {
+
+namespace {
+
+struct MarchPush {
+	f32 eye[3];
+	f32 start;
+	f32 forward[3];
+	f32 end;
+	f32 right[3];
+	f32 depth_a;
+	f32 up[3];
+	f32 depth_b;
+	s32 size[2];
+	u32 grid_mask;
+	u32 pad;
+};
+static_assert(sizeof(MarchPush) == 80, "MarchPush must match the shaders");
+
+constexpr VkDeviceSize COLUMN_BYTES = world::CHUNK_SECTIONS * sizeof(u32);
+
+}	// namespace
+
+FarField::FarField(Device& device, StagingRing& staging, const world::Brickmap& map, const FarFieldConfig& config)
+	: device{device}, staging{staging}, config{config}, grid_chunks{map.get_config().grid_chunks} {
+	if(!map.get_config().deferred_reuse){
+		ERROR("FAR FIELD", "Brickmap must defer brick reuse, the GPU copy may still point at freed bricks.");
+		throw std::exception();
+	}
+	VkDeviceSize columns = VkDeviceSize(grid_chunks) * grid_chunks;
+
+	device.create_buffer(
+		columns * COLUMN_BYTES,
+		VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+		grid_buffer,
+		grid_memory
+	);
+	device.create_buffer(
+		columns * sizeof(world::ChunkPos),
+		VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+		owner_buffer,
+		owner_memory
+	);
+	device.create_buffer(
+		VkDeviceSize(map.get_config().max_bricks) * sizeof(world::FarBrick),
+		VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+		brick_buffer,
+		brick_memory
+	);
+	stats.gpu_bytes = columns * (COLUMN_BYTES + sizeof(world::ChunkPos)) + VkDeviceSize(map.get_config().max_bricks) * sizeof(world::FarBrick);
+
+	VkSamplerCreateInfo sampler_info = {};
+	sampler_info.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+	sampler_info.magFilter = VK_FILTER_NEAREST;
+	sampler_info.minFilter = VK_FILTER_NEAREST;
+	sampler_info.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+	sampler_info.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+	sampler_info.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+	sampler_info.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+	if(vkCreateSampler(device.get_device(), &sampler_info, nullptr, &sampler) != VK_SUCCESS){
+		VK_ERROR("Failed to create far field depth sampler.");
+		throw std::exception();
+	}
+
+	create_descriptors();
+	create_pipeline();
+
+	// Every column starts out empty and owned by no chunk
+	VkCommandBuffer command_buffer = device.begin_single_time_commands();
+	vkCmdFillBuffer(command_buffer, grid_buffer, 0, VK_WHOLE_SIZE, world::FAR_EMPTY);
+	vkCmdFillBuffer(command_buffer, owner_buffer, 0, VK_WHOLE_SIZE, 0x80000000u);
+	device.end_single_time_commands(command_buffer);
+	VK_INFO("Created Far Field.");
+}
+
+FarField::~FarField(){
+	VkDevice d = device.get_device();
+	vkDestroyPipeline(d, pipeline, nullptr);
+	vkDestroyPipelineLayout(d, layout, nullptr);
+	vkDestroyDescriptorPool(d, descriptor_pool, nullptr);
+	vkDestroyDescriptorSetLayout(d, set_layout, nullptr);
+	vkDestroySampler(d, sampler, nullptr);
+	vkDestroyBuffer(d, brick_buffer, nullptr);
+	device.free_memory(brick_memory);
+	vkDestroyBuffer(d, owner_buffer, nullptr);
+	device.free_memory(owner_memory);
+	vkDestroyBuffer(d, grid_buffer, nullptr);
+	device.free_memory(grid_memory);
+	VK_INFO("Destroyed Far Field.");
+}
+
+void FarField::begin_frame(u64 frame){
+	current = static_cast<u32>(frame % config.frames_in_flight);
+	current_frame = frame;
+	stats.bricks_uploaded = 0;
+	stats.columns_uploaded = 0;
+	stats.bytes_uploaded = 0;
+}
+
+void FarField::upload(world::Brickmap& map){
+	while(!released.empty() && released.front().frame + config.frames_in_flight <= current_frame){
+		map.recycle_bricks(released.front().slots);
+		released.pop_front();
+	}
+
+	size_t count = std::min<size_t>(config.bricks_per_frame, map.get_dirty_brick_count());
+	if(count > 0){
+		std::optional<VkDeviceSize> offset = staging.allocate(count * sizeof(world::FarBrick));
+		if(!offset){ return; }
+
+		dirty.clear();
+		map.take_dirty_bricks(dirty, count);
+		u8* dst = staging.data(*offset);
+		for(size_t i = 0; i < count; i++){
+			std::memcpy(dst + i * sizeof(world::FarBrick), &map.get_bricks()[dirty[i]], sizeof(world::FarBrick));
+			brick_copies.push_back({*offset + i * sizeof(world::FarBrick), VkDeviceSize(dirty[i]) * sizeof(world::FarBrick), sizeof(world::FarBrick)});
+		}
+		stats.bricks_uploaded += static_cast<u32>(count);
+		stats.bytes_uploaded += count * sizeof(world::FarBrick);
+	}
+
+	// Columns pointing at bricks still waiting stay in the brickmap
+	count = std::min<size_t>(config.columns_per_frame, map.get_dirty_column_count());
+	if(count == 0){ return; }
+	VkDeviceSize column_size = COLUMN_BYTES + sizeof(world::ChunkPos);
+	std::optional<VkDeviceSize> offset = staging.allocate(count * column_size);
+	if(!offset){ return; }
+
+	dirty.clear();
+	map.take_dirty_columns(dirty, count);
+	count = dirty.size();
+	u8* dst = staging.data(*offset);
+	for(size_t i = 0; i < count; i++){
+		VkDeviceSize src = *offset + i * column_size;
+		u32 column = dirty[i];
+		std::memcpy(dst + i * column_size, &map.get_grid()[size_t(column) * world::CHUNK_SECTIONS], COLUMN_BYTES);
+		std::memcpy(dst + i * column_size + COLUMN_BYTES, &map.get_owners()[column], sizeof(world::ChunkPos));
+		grid_copies.push_back({src, VkDeviceSize(column) * COLUMN_BYTES, COLUMN_BYTES});
+		owner_copies.push_back({src + COLUMN_BYTES, VkDeviceSize(column) * sizeof(world::ChunkPos), sizeof(world::ChunkPos)});
+	}
+	stats.columns_uploaded += static_cast<u32>(count);
+	stats.bytes_uploaded += count * column_size;
+
+	// Frames before this one may still march the old columns
+	Released freed = {current_frame, {}};
+	map.take_released_bricks(freed.slots);
+	if(!freed.slots.empty()){ released.push_back(std::move(freed)); }
+}
+
+void FarField::record(VkCommandBuffer command_buffer, const FarFieldView& view, VkImageView depth, VkImageView color){
+	bool copying = !brick_copies.empty() || !grid_copies.empty();
+	VkMemoryBarrier barrier = {};
+	barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+
+	if(copying){
+		// Frames still marching the buffers this frame overwrites must finish first
+		vkCmdPipelineBarrier(
+			command_buffer,
+			VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+			VK_PIPELINE_STAGE_TRANSFER_BIT,
+			0, 0, nullptr, 0, nullptr, 0, nullptr
+		);
+		if(!brick_copies.empty()){
+			vkCmdCopyBuffer(command_buffer, staging.get_buffer(), brick_buffer, static_cast<u32>(brick_copies.size()), brick_copies.data());
+		}
+		if(!grid_copies.empty()){
+			vkCmdCopyBuffer(command_buffer, staging.get_buffer(), grid_buffer, static_cast<u32>(grid_copies.size()), grid_copies.data());
+			vkCmdCopyBuffer(command_buffer, staging.get_buffer(), owner_buffer, static_cast<u32>(owner_copies.size()), owner_copies.data());
+		}
+		brick_copies.clear();
+		grid_copies.clear();
+		owner_copies.clear();
+	}
+
+	// The copies and the near field's attachments must land before the march reads them
+	barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+	barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+	vkCmdPipelineBarrier(
+		command_buffer,
+		VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+		VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+		0, 1, &barrier, 0, nullptr, 0, nullptr
+	);
+
+	// The set of this frame is not in use by any frame in flight
+	VkDescriptorImageInfo depth_info = {sampler, depth, VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL};
+	VkDescriptorImageInfo color_info = {VK_NULL_HANDLE, color, VK_IMAGE_LAYOUT_GENERAL};
+	std::array<VkWriteDescriptorSet, 2> writes = {};
+	for(u32 i = 0; i < writes.size(); i++){
+		writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		writes[i].dstSet = sets[current];
+		writes[i].dstBinding = 3 + i;
+		writes[i].descriptorCount = 1;
+	}
+	writes[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+	writes[0].pImageInfo = &depth_info;
+	writes[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+	writes[1].pImageInfo = &color_info;
+	vkUpdateDescriptorSets(device.get_device(), static_cast<u32>(writes.size()), writes.data(), 0, nullptr);
+
+	// Depth d of a point at view distance z is -A + B / z with the planes of Mat4::perspective
+	MarchPush push = {};
+	for(int a = 0; a < 3; a++){
+		push.eye[a] = view.eye[a];
+		push.forward[a] = view.forward[a];
+		push.right[a] = view.right[a];
+		push.up[a] = view.up[a];
+	}
+	push.start = view.start;
+	push.end = view.end;
+	push.depth_a = view.far / (view.near - view.far);
+	push.depth_b = view.near * view.far / (view.near - view.far);
+	push.size[0] = static_cast<s32>(view.width);
+	push.size[1] = static_cast<s32>(view.height);
+	push.grid_mask = grid_chunks - 1;
+
+	vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
+	vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, layout, 0, 1, &sets[current], 0, nullptr);
+	vkCmdPushConstants(command_buffer, layout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(push), &push);
+	vkCmdDispatch(command_buffer, (view.width + 7) / 8, (view.height + 7) / 8, 1);
+}
+
+void FarField::create_descriptors(){
+	VkDevice d = device.get_device();
+
+	std::array<VkDescriptorSetLayoutBinding, 5> bindings = {};
+	for(u32 i = 0; i < bindings.size(); i++){
+		bindings[i].binding = i;
+		bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		bindings[i].descriptorCount = 1;
+		bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+	}
+	bindings[3].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+	bindings[4].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+
+	VkDescriptorSetLayoutCreateInfo layout_info = {};
+	layout_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+	layout_info.bindingCount = static_cast<u32>(bindings.size());
+	layout_info.pBindings = bindings.data();
+	if(vkCreateDescriptorSetLayout(d, &layout_info, nullptr, &set_layout) != VK_SUCCESS){
+		VK_ERROR("Failed to create far field descriptor set layout.");
+		throw std::exception();
+	}
+
+	u32 frames = config.frames_in_flight;
+	std::array<VkDescriptorPoolSize, 3> pool_sizes = {{
+		{VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, frames * 3},
+		{VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, frames},
+		{VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, frames},
+	}};
+	VkDescriptorPoolCreateInfo pool_info = {};
+	pool_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+	pool_info.maxSets = frames;
+	pool_info.poolSizeCount = static_cast<u32>(pool_sizes.size());
+	pool_info.pPoolSizes = pool_sizes.data();
+	if(vkCreateDescriptorPool(d, &pool_info, nullptr, &descriptor_pool) != VK_SUCCESS){
+		VK_ERROR("Failed to create far field descriptor pool.");
+		throw std::exception();
+	}
+
+	std::vector<VkDescriptorSetLayout> layouts(frames, set_layout);
+	sets.resize(frames);
+	VkDescriptorSetAllocateInfo allocate_info = {};
+	allocate_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+	allocate_info.descriptorPool = descriptor_pool;
+	allocate_info.descriptorSetCount = frames;
+	allocate_info.pSetLayouts = layouts.data();
+	if(vkAllocateDescriptorSets(d, &allocate_info, sets.data()) != VK_SUCCESS){
+		VK_ERROR("Failed to allocate far field descriptor sets.");
+		throw std::exception();
+	}
+
+	// The images change with the swapchain and are written in `record`
+	std::vector<VkDescriptorBufferInfo> infos;
+	std::vector<VkWriteDescriptorSet> writes;
+	infos.reserve(frames * 3);
+	for(u32 i = 0; i < frames; i++){
+		VkBuffer buffers[3] = {grid_buffer, owner_buffer, brick_buffer};
+		for(u32 b = 0; b < 3; b++){
+			infos.push_back({buffers[b], 0, VK_WHOLE_SIZE});
+			VkWriteDescriptorSet w = {};
+			w.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+			w.dstSet = sets[i];
+			w.dstBinding = b;
+			w.descriptorCount = 1;
+			w.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+			w.pBufferInfo = &infos.back();
+			writes.push_back(w);
+		}
+	}
+	vkUpdateDescriptorSets(d, static_cast<u32>(writes.size()), writes.data(), 0, nullptr);
+}
+
+void FarField::create_pipeline(){
+	VkDevice d = device.get_device();
+
+	VkPushConstantRange range = {VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(MarchPush)};
+	VkPipelineLayoutCreateInfo layout_info = {};
+	layout_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+	layout_info.setLayoutCount = 1;
+	layout_info.pSetLayouts = &set_layout;
+	layout_info.pushConstantRangeCount = 1;
+	layout_info.pPushConstantRanges = &range;
+	if(vkCreatePipelineLayout(d, &layout_info, nullptr, &layout) != VK_SUCCESS){
+		VK_ERROR("Failed to create far field pipeline layout.");
+		throw std::exception();
+	}
+
+	VkShaderModule module = device.create_shader_module(config.shader_dir + "far_field.comp.spv");
+
+	VkComputePipelineCreateInfo compute_info = {};
+	compute_info.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+	compute_info.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+	compute_info.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+	compute_info.stage.module = module;
+	compute_info.stage.pName = "main";
+	compute_info.layout = layout;
+	VkResult result = vkCreateComputePipelines(d, VK_NULL_HANDLE, 1, &compute_info, nullptr, &pipeline);
+	vkDestroyShaderModule(d, module, nullptr);
+	if(result != VK_SUCCESS){
+		VK_ERROR("Failed to create far field pipeline.");
+		throw std::exception();
+	}
+}
+
+}	// namespace eng
+}	// namespace uni
@@ -0,0 +1,162 @@
+/**
+ * @file src/engine/far_field.hpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#pragma once
+
+#include "engine/device.hpp"
+#include "engine/staging_ring.hpp"
+
+#include "util/math.hpp"
+#include "world/brickmap.hpp"
+
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace uni {
+namespace eng {
+
+struct FarFieldConfig {
+	u32 bricks_per_frame = 2048;        // uploads per frame, 320 bytes each
+	u32 columns_per_frame = 1024;
+	u32 frames_in_flight = 2;
+	std::string shader_dir = "build/shaders/";
+};
+
+/**
+ * @brief Camera of one far field pass
+ *
+ * `near` and `far` are the planes of the projection the near field
+ * depth buffer was drawn with, `start` and `end` bound the march.
+ */
+struct FarFieldView {
+	Vec3 eye;
+	Vec3 forward;       // unit length
+	Vec3 right;         // scaled by tan(fov_y / 2) * aspect
+	Vec3 up;            // scaled by tan(fov_y / 2)
+	f32 near;
+	f32 far;
+	f32 start;          // usually a little inside the mesh render distance
+	f32 end;
+	u32 width;
+	u32 height;
+};
+
+struct FarFieldStats {
+	u32 bricks_uploaded = 0;            // this frame
+	u32 columns_uploaded = 0;           // this frame
+	VkDeviceSize bytes_uploaded = 0;    // this frame
+	VkDeviceSize gpu_bytes = 0;         // grid, owners and brick buffers
+};
+
+/**
+ * @brief Ray marches a `world::Brickmap` in a compute shader
+ *
+ * Draws terrain past the meshed near field without meshing it. Every
+ * pixel marches from `start` until it hits a cell, reaches `end` or
+ * reaches what the near field drew there, read back from its depth
+ * buffer, and only then writes the color. Near and far field therefore
+ * overlap without seams and the near field always wins where it is closer.
+ *
+ * The GPU copy of the brickmap is kept in step with the changes the
+ * brickmap records, a changed chunk costs the upload of its own bricks.
+ * A column is uploaded with or after the bricks it points at, and bricks
+ * it no longer points at are reused only once the frames that may still
+ * read its old copy retired. The brickmap needs `deferred_reuse`.
+ */
+class FarField {
+public:
+	FarField(const FarField&) = delete;
+	FarField& operator=(const FarField&) = delete;
+
+	/**
+	 * @param[in] device
+	 * @param[in] staging
+	 * @param[in] map Only its config is read, to size the GPU copy, must have `deferred_reuse`
+	 * @param[in] config
+	 */
+	FarField(Device& device, StagingRing& staging, const world::Brickmap& map, const FarFieldConfig& config);
+
+	~FarField();
+
+	/**
+	 * @brief Starts a frame
+	 * @param[in] frame Index of the frame about to be recorded
+	 * @return void
+	 */
+	void begin_frame(u64 frame);
+
+	/**
+	 * @brief Stages what changed in the brickmap since the last call
+	 *
+	 * At most `bricks_per_frame` bricks and `columns_per_frame` columns,
+	 * the rest waits in the brickmap for the next frame.
+	 *
+	 * @param[in,out] map The brickmap given to the constructor
+	 * @return void
+	 */
+	void upload(world::Brickmap& map);
+
+	/**
+	 * @brief Records this frame's uploads and the march
+	 *
+	 * Must be recorded outside a render pass, after the near field. The
+	 * depth image must be in DEPTH_STENCIL_READ_ONLY_OPTIMAL layout and
+	 * the color image, which needs storage usage, in GENERAL layout.
+	 *
+	 * @param[in] command_buffer
+	 * @param[in] view
+	 * @param[in] depth Near field depth
+	 * @param[in] color R8G8B8A8 target the near field drew into
+	 * @return void
+	 */
+	void record(VkCommandBuffer command_buffer, const FarFieldView& view, VkImageView depth, VkImageView color);
+
+	const FarFieldStats& get_stats() const { return stats; }
+
+private:
+	void create_descriptors();
+	void create_pipeline();
+
+	Device& device;
+	StagingRing& staging;
+	FarFieldConfig config;
+	u32 grid_chunks;
+
+	VkBuffer grid_buffer;
+	VkDeviceMemory grid_memory;
+	VkBuffer owner_buffer;
+	VkDeviceMemory owner_memory;
+	VkBuffer brick_buffer;
+	VkDeviceMemory brick_memory;
+	VkSampler sampler;
+
+	VkDescriptorPool descriptor_pool;
+	VkDescriptorSetLayout set_layout;
+	std::vector<VkDescriptorSet> sets;      // per frame in flight
+	VkPipelineLayout layout;
+	VkPipeline pipeline;
+	u32 current = 0;
+	u64 current_frame = 0;
+
+	// Bricks freed by the columns uploaded in a frame, reusable once it retired
+	struct Released {
+		u64 frame;
+		std::vector<u32> slots;
+	};
+	std::deque<Released> released;
+
+	// Work for the next `record`
+	std::vector<VkBufferCopy> grid_copies;
+	std::vector<VkBufferCopy> owner_copies;
+	std::vector<VkBufferCopy> brick_copies;
+	std::vector<u32> dirty;
+
+	FarFieldStats stats;
+};
+
+}	// namespace eng
+}	// namespace uni
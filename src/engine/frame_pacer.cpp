@@ -0,0 +1,73 @@
+/**
+ * @file src/engine/frame_pacer.cpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#include "engine/frame_pacer.hpp"
+
+#include <algorithm>
+
+namespace uni {
+namespace eng {
+
+static constexpr f64 NS_PER_MS = 1e6;
+
+FramePacer::FramePacer(Clock& clock, const FramePacerConfig& config) : clock{clock}, config{config} {
+	set_target_fps(config.target_fps);
+}
+
+void FramePacer::set_target_fps(f64 fps){
+	config.target_fps = fps;
+	interval = fps > 0.0 ? static_cast<u64>(1e9 / fps) : 0;
+	deadline = clock.now() + interval;
+}
+
+void FramePacer::wait(){
+	if(interval > 0){
+		// Nothing measured yet, start right away
+		u64 budget = stats.frames == 0 ? interval : std::min(interval, static_cast<u64>(predicted_work * config.margin));
+		if(deadline > budget){ clock.sleep_until(deadline - budget); }
+	}
+	frame_start = clock.now();
+	input_time = 0;
+}
+
+void FramePacer::latch(u64 time){
+	input_time = time;
+}
+
+void FramePacer::presented(){
+	u64 now = clock.now();
+	f64 work = static_cast<f64>(now - frame_start);
+	predicted_work = stats.frames == 0 ? work : predicted_work + config.smoothing * (work - predicted_work);
+
+	if(interval > 0){
+		if(now > deadline){
+			// Late, align the schedule to this present instead of bursting to catch up
+			stats.missed++;
+			deadline = now + interval;
+		} else {
+			deadline += interval;
+		}
+	}
+
+	if(stats.frames > 0){
+		f64 frame = static_cast<f64>(now - last_present) / NS_PER_MS;
+		stats.frame_ms += (frame - stats.frame_ms) / stats.frames;
+	}
+	last_present = now;
+	stats.frames++;
+	stats.work_ms = predicted_work / NS_PER_MS;
+
+	if(input_time > 0 && input_time <= now){
+		f64 latency = static_cast<f64>(now - input_time) / NS_PER_MS;
+		stats.latency_last_ms = latency;
+		stats.latency_max_ms = std::max(stats.latency_max_ms, latency);
+		latched++;
+		stats.latency_ms += (latency - stats.latency_ms) / latched;
+	}
+}
+
+}	// namespace eng
+}	// namespace uni
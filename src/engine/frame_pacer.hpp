@@ -0,0 +1,95 @@
+/**
+ * @file src/engine/frame_pacer.hpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#pragma once
+
+#include "util/clock.hpp"
+#include "util/types.hpp"
+
+namespace uni {
+namespace eng {
+
+struct FramePacerConfig {
+	f64 target_fps = 60.0;      // 0 runs uncapped
+	f64 margin = 1.25;          // headroom on the predicted frame time
+	f64 smoothing = 0.1;        // weight of the newest frame in the prediction
+};
+
+/**
+ * @brief Running frame statistics, durations in milliseconds
+ */
+struct FrameStats {
+	u64 frames = 0;
+	u64 missed = 0;             // presents that landed after their deadline
+	f64 frame_ms = 0.0;         // mean time between presents
+	f64 work_ms = 0.0;          // predicted cpu time from wake to present
+	f64 latency_ms = 0.0;       // mean input to present latency
+	f64 latency_max_ms = 0.0;
+	f64 latency_last_ms = 0.0;
+};
+
+/**
+ * @brief Paces frames to a target rate while keeping input latency low
+ *
+ * Rather than starting a frame right after the last present and then
+ * idling until vsync, `wait` sleeps until just enough time is left to
+ * build the frame before its deadline. Input sampled after that point is
+ * as fresh as it can be. The render loop looks like
+ *
+ *     pacer.wait();
+ *     drain events, update, record
+ *     pacer.latch(window.latch_cursor().time);    // camera from newest input
+ *     submit and present
+ *     pacer.presented();
+ */
+class FramePacer {
+public:
+	FramePacer(Clock& clock, const FramePacerConfig& config = {});
+
+	/**
+	 * @brief Sleeps until the latest time the next frame can start
+	 * @return void
+	 */
+	void wait();
+
+	/**
+	 * @brief Records when the input the frame is built from was sampled
+	 * @param[in] input_time `Clock` nanoseconds, 0 when there was no input
+	 * @return void
+	 */
+	void latch(u64 input_time);
+
+	/**
+	 * @brief Marks the frame presented and updates the statistics
+	 * @return void
+	 */
+	void presented();
+
+	void set_target_fps(f64 fps);
+
+	/**
+	 * @return Nanoseconds between presents, 0 when uncapped
+	 */
+	u64 get_interval() const { return interval; }
+	u64 get_deadline() const { return deadline; }
+	const FrameStats& get_stats() const { return stats; }
+	void reset_stats(){ stats = {}; latched = 0; }
+
+private:
+	Clock& clock;
+	FramePacerConfig config;
+	u64 interval = 0;
+	u64 deadline = 0;           // when the next present is due
+	u64 frame_start = 0;
+	u64 last_present = 0;
+	u64 input_time = 0;
+	f64 predicted_work = 0.0;   // nanoseconds
+	u64 latched = 0;            // frames with a latency sample
+	FrameStats stats;
+};
+
+}	// namespace eng
+}	// namespace uni
@@ -0,0 +1,587 @@
+/**
+ * @file src/engine/gpu_mesher.cpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#include "engine/gpu_mesher.hpp"
+
+#include "util/util.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace uni {
+namespace eng {
+
+namespace {
+
+struct MeshPush {
+	u32 opaque_mask;    // bit per block id
+};
+
+struct DrawPush {
+	Mat4 view_proj;
+};
+
+static_assert(world::BLOCK_COUNT <= 32, "Opacity of every block must fit the push constant mask");
+
+// Neighbour faces, 16x16 blocks each packed two to a word
+constexpr u32 BORDER_WORDS = world::BORDER_BLOCKS / 2;
+
+u32 opaque_mask(){
+	u32 mask = 0;
+	for(world::BlockId block = 0; block < world::BLOCK_COUNT; block++){
+		if(world::is_opaque(block)){ mask |= 1u << block; }
+	}
+	return mask;
+}
+
+constexpr VkDeviceSize align_up(VkDeviceSize value, VkDeviceSize alignment){
+	return (value + alignment - 1) & ~(alignment - 1);
+}
+
+}	// namespace
+
+GpuMesher::GpuMesher(Device& device, StagingRing& staging, const GpuMesherConfig& config)
+	: device{device}, staging{staging}, config{config}, quad_allocator{config.quad_capacity} {
+	VkPhysicalDeviceFeatures features = device.get_features();
+	multi_draw = features.multiDrawIndirect;
+
+	device.create_buffer(
+		config.quad_capacity * sizeof(world::ChunkQuad),
+		VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+		quad_buffer,
+		quad_memory
+	);
+	device.create_buffer(
+		VkDeviceSize(config.max_sections) * sizeof(SectionDraw),
+		VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+		draw_buffer,
+		draw_memory
+	);
+
+	// Headers then block data, the data binding must start on an aligned offset
+	VkPhysicalDeviceProperties properties;
+	vkGetPhysicalDeviceProperties(device.get_physical_device(), &properties);
+	job_bytes = align_up(VkDeviceSize(config.jobs_per_frame) * sizeof(Job), std::max<VkDeviceSize>(properties.limits.minStorageBufferOffsetAlignment, 16));
+
+	job_buffers.resize(config.frames_in_flight);
+	job_memory.resize(config.frames_in_flight);
+	for(u32 i = 0; i < config.frames_in_flight; i++){
+		device.create_buffer(
+			job_bytes + config.upload_bytes,
+			VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+			job_buffers[i],
+			job_memory[i]
+		);
+	}
+
+	quad_offsets.assign(config.max_sections, ~0ull);
+	quad_sizes.assign(config.max_sections, 0);
+	placements.assign(config.max_sections, {});
+	cleared.reserve(config.max_sections);
+
+	create_descriptors();
+	create_pipelines();
+
+	// Every slot starts out drawing nothing
+	VkCommandBuffer command_buffer = device.begin_single_time_commands();
+	vkCmdFillBuffer(command_buffer, draw_buffer, 0, VK_WHOLE_SIZE, 0);
+	device.end_single_time_commands(command_buffer);
+	VK_INFO("Created GPU Mesher.");
+}
+
+GpuMesher::~GpuMesher(){
+	VkDevice d = device.get_device();
+	if(draw_pipeline != VK_NULL_HANDLE){
+		vkDestroyPipeline(d, draw_pipeline, nullptr);
+		vkDestroyPipelineLayout(d, draw_layout, nullptr);
+	}
+	vkDestroyPipeline(d, mesh_pipeline, nullptr);
+	vkDestroyPipelineLayout(d, mesh_layout, nullptr);
+	vkDestroyDescriptorPool(d, descriptor_pool, nullptr);
+	vkDestroyDescriptorSetLayout(d, draw_set_layout, nullptr);
+	vkDestroyDescriptorSetLayout(d, mesh_set_layout, nullptr);
+	for(u32 i = 0; i < config.frames_in_flight; i++){
+		vkDestroyBuffer(d, job_buffers[i], nullptr);
+		device.free_memory(job_memory[i]);
+	}
+	vkDestroyBuffer(d, draw_buffer, nullptr);
+	device.free_memory(draw_memory);
+	vkDestroyBuffer(d, quad_buffer, nullptr);
+	device.free_memory(quad_memory);
+	VK_INFO("Destroyed GPU Mesher.");
+}
+
+void GpuMesher::begin_frame(u64 frame){
+	current_frame = frame;
+	current = static_cast<u32>(frame % config.frames_in_flight);
+	while(!retired.empty() && retired.front().frame + config.frames_in_flight <= frame){
+		quad_allocator.free(retired.front().offset);
+		retired.pop_front();
+	}
+	stats.quads_reserved = quad_allocator.get_used();
+	stats.jobs = 0;
+	stats.uploads = 0;
+	stats.deferred = 0;
+	stats.bytes_uploaded = 0;
+}
+
+bool GpuMesher::mesh(MeshId& id, const world::SectionNeighbours& section, s32 sx, s32 sy, s32 sz){
+	u32 bound = section.center ? world::max_quads(*section.center) : 0;
+	if(bound == 0){
+		if(id != NO_MESH){ destroy(id); }
+		id = NO_MESH;
+		return true;
+	}
+
+	world::encode_section(*section.center, paletted);
+	u64 words = paletted.palette.size() + paletted.words.size() * 2 + BORDER_WORDS;
+	if(jobs == config.jobs_per_frame || (upload_words + words) * sizeof(u32) > config.upload_bytes){
+		stats.deferred++;
+		return false;
+	}
+
+	u64 quad_base;
+	VkDeviceSize offset;
+	MeshId slot = reserve(id, bound, sizeof(Job) + words * sizeof(u32), quad_base, offset);
+	if(slot == NO_MESH){
+		stats.deferred++;
+		return false;
+	}
+	id = slot;
+	placements[id] = {{sx, sy, sz}, current_frame};
+
+	Job job = {};
+	job.origin[0] = sx * world::SECTION_SIZE;
+	job.origin[1] = sy * world::SECTION_SIZE;
+	job.origin[2] = sz * world::SECTION_SIZE;
+	job.slot = id;
+	job.quad_base = static_cast<u32>(quad_base);
+	job.quad_capacity = bound;
+	job.bits = paletted.bits;
+	job.palette = static_cast<u32>(upload_words);
+	job.words = job.palette + static_cast<u32>(paletted.palette.size());
+	job.border = job.words + static_cast<u32>(paletted.words.size() * 2);
+
+	// Palette entries widened to words, index words as little endian halves
+	u8* dst = staging.data(offset);
+	std::memcpy(dst, &job, sizeof(Job));
+	u32* data = reinterpret_cast<u32*>(dst + sizeof(Job));
+	for(size_t i = 0; i < paletted.palette.size(); i++){ data[i] = paletted.palette[i]; }
+	std::memcpy(data + (job.words - job.palette), paletted.words.data(), paletted.words.size() * sizeof(u64));
+	world::write_border(section, reinterpret_cast<world::BlockId*>(data + (job.border - job.palette)));
+
+	copies.push_back({offset, VkDeviceSize(jobs) * sizeof(Job), sizeof(Job)});
+	copies.push_back({offset + sizeof(Job), job_bytes + upload_words * sizeof(u32), words * sizeof(u32)});
+	jobs++;
+	upload_words += words;
+	stats.jobs++;
+	stats.bytes_uploaded += sizeof(Job) + words * sizeof(u32);
+	return true;
+}
+
+bool GpuMesher::upload(MeshId& id, const world::ChunkQuad* quads, u32 count, s32 sx, s32 sy, s32 sz){
+	if(count == 0){
+		if(id != NO_MESH){ destroy(id); }
+		id = NO_MESH;
+		return true;
+	}
+
+	// The draw then the quads, copied where the meshing pass would have written them
+	u64 quad_base;
+	VkDeviceSize offset;
+	VkDeviceSize bytes = VkDeviceSize(count) * sizeof(world::ChunkQuad);
+	MeshId slot = reserve(id, count, sizeof(SectionDraw) + bytes, quad_base, offset);
+	if(slot == NO_MESH){
+		stats.deferred++;
+		return false;
+	}
+	id = slot;
+	placements[id] = {{sx, sy, sz}, current_frame};
+
+	SectionDraw draw = {};
+	draw.command = {count * 6, 1, static_cast<u32>(quad_base) * 6, id};
+	draw.origin[0] = sx * world::SECTION_SIZE;
+	draw.origin[1] = sy * world::SECTION_SIZE;
+	draw.origin[2] = sz * world::SECTION_SIZE;
+	u8* dst = staging.data(offset);
+	std::memcpy(dst, &draw, sizeof(draw));
+	std::memcpy(dst + sizeof(draw), quads, bytes);
+
+	draw_copies.push_back({offset, VkDeviceSize(id) * sizeof(SectionDraw), sizeof(SectionDraw)});
+	quad_copies.push_back({offset + sizeof(draw), quad_base * sizeof(world::ChunkQuad), bytes});
+	stats.uploads++;
+	stats.bytes_uploaded += sizeof(draw) + bytes;
+	return true;
+}
+
+MeshId GpuMesher::reserve(MeshId id, u64 quads, VkDeviceSize bytes, u64& quad_base, VkDeviceSize& offset){
+	if(id == NO_MESH && free_ids.empty() && slot_count == config.max_sections){ return NO_MESH; }
+
+	std::optional<u64> base = quad_allocator.allocate(quads);
+	if(!base){ return NO_MESH; }
+	std::optional<VkDeviceSize> staged = staging.allocate(bytes);
+	if(!staged){
+		quad_allocator.free(*base);
+		return NO_MESH;
+	}
+
+	if(id == NO_MESH){
+		if(!free_ids.empty()){
+			id = free_ids.back();
+			free_ids.pop_back();
+		} else {
+			id = slot_count++;
+		}
+		stats.sections++;
+	} else {
+		release(id);
+	}
+	quad_offsets[id] = *base;
+	quad_sizes[id] = quads;
+	live_quads += quads;
+	stats.quads_reserved = quad_allocator.get_used();
+	quad_base = *base;
+	offset = *staged;
+	return id;
+}
+
+void GpuMesher::destroy(MeshId id){
+	release(id);
+	cleared.push_back(id);
+	free_ids.push_back(id);
+	stats.sections--;
+}
+
+void GpuMesher::release(MeshId id){
+	if(quad_offsets[id] == ~0ull){ return; }
+	retired.push_back({current_frame, quad_offsets[id]});
+	live_quads -= quad_sizes[id];
+	quad_offsets[id] = ~0ull;
+	quad_sizes[id] = 0;
+}
+
+VkDeviceSize GpuMesher::evict(VkDeviceSize bytes, s32 sx, s32 sy, s32 sz, std::vector<MeshId>& evicted){
+	// Farthest first, a queued slot's job would write its draw after the clear
+	std::vector<std::pair<s64, MeshId>> order;
+	for(MeshId slot = 0; slot < slot_count; slot++){
+		const Placement& placement = placements[slot];
+		if(quad_offsets[slot] == ~0ull || placement.frame == current_frame){ continue; }
+		s64 dx = placement.section[0] - sx, dy = placement.section[1] - sy, dz = placement.section[2] - sz;
+		order.push_back({dx * dx + dy * dy + dz * dz, slot});
+	}
+	std::sort(order.begin(), order.end(), [](const auto& a, const auto& b){ return a.first > b.first; });
+
+	VkDeviceSize freed = 0;
+	for(const auto& [distance, slot] : order){
+		if(freed >= bytes){ break; }
+		freed += get_bytes(slot);
+		destroy(slot);
+		evicted.push_back(slot);
+	}
+	return freed;
+}
+
+void GpuMesher::record(VkCommandBuffer command_buffer){
+	if(jobs == 0 && cleared.empty() && draw_copies.empty()){ return; }
+
+	// Frames still drawing from the buffers this pass overwrites must finish first
+	vkCmdPipelineBarrier(
+		command_buffer,
+		VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
+		VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+		0, 0, nullptr, 0, nullptr, 0, nullptr
+	);
+
+	if(!copies.empty()){
+		vkCmdCopyBuffer(command_buffer, staging.get_buffer(), job_buffers[current], static_cast<u32>(copies.size()), copies.data());
+	}
+	for(u32 slot : cleared){
+		vkCmdFillBuffer(command_buffer, draw_buffer, VkDeviceSize(slot) * sizeof(SectionDraw), sizeof(SectionDraw), 0);
+	}
+
+	VkMemoryBarrier barrier = {};
+	barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+	if(!draw_copies.empty()){
+		// A slot cleared this frame may have been handed out again
+		if(!cleared.empty()){
+			barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+			barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+			vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+		}
+		vkCmdCopyBuffer(command_buffer, staging.get_buffer(), draw_buffer, static_cast<u32>(draw_copies.size()), draw_copies.data());
+		vkCmdCopyBuffer(command_buffer, staging.get_buffer(), quad_buffer, static_cast<u32>(quad_copies.size()), quad_copies.data());
+	}
+
+	barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+	barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+	vkCmdPipelineBarrier(
+		command_buffer,
+		VK_PIPELINE_STAGE_TRANSFER_BIT,
+		VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
+		0, 1, &barrier, 0, nullptr, 0, nullptr
+	);
+
+	if(jobs > 0){
+		MeshPush push = {opaque_mask()};
+		vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, mesh_pipeline);
+		vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, mesh_layout, 0, 1, &mesh_sets[current], 0, nullptr);
+		vkCmdPushConstants(command_buffer, mesh_layout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(push), &push);
+		vkCmdDispatch(command_buffer, jobs, 1, 1);
+
+		barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+		barrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_TRANSFER_READ_BIT;
+		vkCmdPipelineBarrier(
+			command_buffer,
+			VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+			VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+			0, 1, &barrier, 0, nullptr, 0, nullptr
+		);
+	}
+
+	jobs = 0;
+	upload_words = 0;
+	copies.clear();
+	quad_copies.clear();
+	draw_copies.clear();
+	cleared.clear();
+}
+
+void GpuMesher::record_draw(VkCommandBuffer command_buffer, const Mat4& view_proj){
+	stats.draw_calls = 0;
+	if(draw_pipeline == VK_NULL_HANDLE || slot_count == 0){ return; }
+
+	DrawPush push = {view_proj};
+	vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, draw_pipeline);
+	vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, draw_layout, 0, 1, &draw_set, 0, nullptr);
+	vkCmdPushConstants(command_buffer, draw_layout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(push), &push);
+
+	// Free and empty slots hold zero counts, drawing them is a no-op
+	if(multi_draw){
+		vkCmdDrawIndirect(command_buffer, draw_buffer, 0, slot_count, sizeof(SectionDraw));
+		stats.draw_calls = 1;
+		return;
+	}
+	for(u32 slot = 0; slot < slot_count; slot++){
+		if(quad_offsets[slot] == ~0ull){ continue; }
+		vkCmdDrawIndirect(command_buffer, draw_buffer, VkDeviceSize(slot) * sizeof(SectionDraw), 1, sizeof(SectionDraw));
+		stats.draw_calls++;
+	}
+}
+
+void GpuMesher::create_descriptors(){
+	VkDevice d = device.get_device();
+
+	std::array<VkDescriptorSetLayoutBinding, 4> bindings = {};
+	for(u32 i = 0; i < bindings.size(); i++){
+		bindings[i].binding = i;
+		bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		bindings[i].descriptorCount = 1;
+		bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+	}
+
+	VkDescriptorSetLayoutCreateInfo layout_info = {};
+	layout_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+	layout_info.bindingCount = static_cast<u32>(bindings.size());
+	layout_info.pBindings = bindings.data();
+	if(vkCreateDescriptorSetLayout(d, &layout_info, nullptr, &mesh_set_layout) != VK_SUCCESS){
+		VK_ERROR("Failed to create mesher descriptor set layout.");
+		throw std::exception();
+	}
+
+	bindings[0].stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+	bindings[1].stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+	layout_info.bindingCount = 2;
+	if(vkCreateDescriptorSetLayout(d, &layout_info, nullptr, &draw_set_layout) != VK_SUCCESS){
+		VK_ERROR("Failed to create section draw descriptor set layout.");
+		throw std::exception();
+	}
+
+	u32 frames = config.frames_in_flight;
+	VkDescriptorPoolSize pool_size = {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, frames * 4 + 2};
+	VkDescriptorPoolCreateInfo pool_info = {};
+	pool_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+	pool_info.maxSets = frames + 1;
+	pool_info.poolSizeCount = 1;
+	pool_info.pPoolSizes = &pool_size;
+	if(vkCreateDescriptorPool(d, &pool_info, nullptr, &descriptor_pool) != VK_SUCCESS){
+		VK_ERROR("Failed to create mesher descriptor pool.");
+		throw std::exception();
+	}
+
+	std::vector<VkDescriptorSetLayout> mesh_layouts(frames, mesh_set_layout);
+	mesh_sets.resize(frames);
+
+	VkDescriptorSetAllocateInfo allocate_info = {};
+	allocate_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+	allocate_info.descriptorPool = descriptor_pool;
+	allocate_info.descriptorSetCount = frames;
+	allocate_info.pSetLayouts = mesh_layouts.data();
+	if(vkAllocateDescriptorSets(d, &allocate_info, mesh_sets.data()) != VK_SUCCESS){
+		VK_ERROR("Failed to allocate mesher descriptor sets.");
+		throw std::exception();
+	}
+	allocate_info.descriptorSetCount = 1;
+	allocate_info.pSetLayouts = &draw_set_layout;
+	if(vkAllocateDescriptorSets(d, &allocate_info, &draw_set) != VK_SUCCESS){
+		VK_ERROR("Failed to allocate section draw descriptor set.");
+		throw std::exception();
+	}
+
+	std::vector<VkDescriptorBufferInfo> infos;
+	std::vector<VkWriteDescriptorSet> writes;
+	infos.reserve(frames * 4 + 2);
+	auto write = [&](VkDescriptorSet set, u32 binding, VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range){
+		infos.push_back({buffer, offset, range});
+		VkWriteDescriptorSet w = {};
+		w.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		w.dstSet = set;
+		w.dstBinding = binding;
+		w.descriptorCount = 1;
+		w.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		w.pBufferInfo = &infos.back();
+		writes.push_back(w);
+	};
+	for(u32 i = 0; i < frames; i++){
+		write(mesh_sets[i], 0, job_buffers[i], 0, job_bytes);
+		write(mesh_sets[i], 1, job_buffers[i], job_bytes, config.upload_bytes);
+		write(mesh_sets[i], 2, quad_buffer, 0, VK_WHOLE_SIZE);
+		write(mesh_sets[i], 3, draw_buffer, 0, VK_WHOLE_SIZE);
+	}
+	write(draw_set, 0, quad_buffer, 0, VK_WHOLE_SIZE);
+	write(draw_set, 1, draw_buffer, 0, VK_WHOLE_SIZE);
+	vkUpdateDescriptorSets(d, static_cast<u32>(writes.size()), writes.data(), 0, nullptr);
+}
+
+void GpuMesher::create_pipelines(){
+	VkDevice d = device.get_device();
+
+	VkPushConstantRange mesh_range = {VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(MeshPush)};
+	VkPipelineLayoutCreateInfo layout_info = {};
+	layout_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+	layout_info.setLayoutCount = 1;
+	layout_info.pSetLayouts = &mesh_set_layout;
+	layout_info.pushConstantRangeCount = 1;
+	layout_info.pPushConstantRanges = &mesh_range;
+	if(vkCreatePipelineLayout(d, &layout_info, nullptr, &mesh_layout) != VK_SUCCESS){
+		VK_ERROR("Failed to create mesher pipeline layout.");
+		throw std::exception();
+	}
+
+	// Meshing pass
+	VkShaderModule mesh_module = device.create_shader_module(config.shader_dir + "chunk_mesh.comp.spv");
+
+	VkComputePipelineCreateInfo compute_info = {};
+	compute_info.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+	compute_info.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+	compute_info.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+	compute_info.stage.module = mesh_module;
+	compute_info.stage.pName = "main";
+	compute_info.layout = mesh_layout;
+	VkResult result = vkCreateComputePipelines(d, VK_NULL_HANDLE, 1, &compute_info, nullptr, &mesh_pipeline);
+	vkDestroyShaderModule(d, mesh_module, nullptr);
+	if(result != VK_SUCCESS){
+		VK_ERROR("Failed to create mesher pipeline.");
+		throw std::exception();
+	}
+
+	if(config.render_pass == VK_NULL_HANDLE){ return; }
+
+	VkPushConstantRange draw_range = {VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(DrawPush)};
+	layout_info.pSetLayouts = &draw_set_layout;
+	layout_info.pPushConstantRanges = &draw_range;
+	if(vkCreatePipelineLayout(d, &layout_info, nullptr, &draw_layout) != VK_SUCCESS){
+		VK_ERROR("Failed to create section draw pipeline layout.");
+		throw std::exception();
+	}
+
+	// Draw pass, vertices are pulled from the quad buffer so there is no vertex input
+	VkShaderModule vert_module = device.create_shader_module(config.shader_dir + "chunk.vert.spv");
+	VkShaderModule frag_module = device.create_shader_module(config.shader_dir + "chunk.frag.spv");
+
+	VkPipelineShaderStageCreateInfo stages[2] = {};
+	stages[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+	stages[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
+	stages[0].module = vert_module;
+	stages[0].pName = "main";
+	stages[1].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+	stages[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+	stages[1].module = frag_module;
+	stages[1].pName = "main";
+
+	VkPipelineVertexInputStateCreateInfo vertex_input = {};
+	vertex_input.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+
+	VkPipelineInputAssemblyStateCreateInfo input_assembly = {};
+	input_assembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+	input_assembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+	VkPipelineViewportStateCreateInfo viewport = {};
+	viewport.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+	viewport.viewportCount = 1;
+	viewport.scissorCount = 1;
+
+	VkPipelineRasterizationStateCreateInfo rasterization = {};
+	rasterization.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+	rasterization.polygonMode = VK_POLYGON_MODE_FILL;
+	rasterization.cullMode = VK_CULL_MODE_BACK_BIT;
+	rasterization.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+	rasterization.lineWidth = 1.0f;
+
+	VkPipelineMultisampleStateCreateInfo multisample = {};
+	multisample.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+	multisample.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+	VkPipelineDepthStencilStateCreateInfo depth = {};
+	depth.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+	depth.depthTestEnable = VK_TRUE;
+	depth.depthWriteEnable = VK_TRUE;
+	depth.depthCompareOp = VK_COMPARE_OP_LESS;
+
+	VkPipelineColorBlendAttachmentState blend_attachment = {};
+	blend_attachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+
+	VkPipelineColorBlendStateCreateInfo blend = {};
+	blend.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+	blend.attachmentCount = 1;
+	blend.pAttachments = &blend_attachment;
+
+	VkDynamicState dynamic_states[2] = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
+	VkPipelineDynamicStateCreateInfo dynamic = {};
+	dynamic.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+	dynamic.dynamicStateCount = 2;
+	dynamic.pDynamicStates = dynamic_states;
+
+	VkGraphicsPipelineCreateInfo pipeline_info = {};
+	pipeline_info.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+	pipeline_info.stageCount = 2;
+	pipeline_info.pStages = stages;
+	pipeline_info.pVertexInputState = &vertex_input;
+	pipeline_info.pInputAssemblyState = &input_assembly;
+	pipeline_info.pViewportState = &viewport;
+	pipeline_info.pRasterizationState = &rasterization;
+	pipeline_info.pMultisampleState = &multisample;
+	pipeline_info.pDepthStencilState = &depth;
+	pipeline_info.pColorBlendState = &blend;
+	pipeline_info.pDynamicState = &dynamic;
+	pipeline_info.layout = draw_layout;
+	pipeline_info.renderPass = config.render_pass;
+	pipeline_info.subpass = config.subpass;
+
+	result = vkCreateGraphicsPipelines(d, VK_NULL_HANDLE, 1, &pipeline_info, nullptr, &draw_pipeline);
+	vkDestroyShaderModule(d, vert_module, nullptr);
+	vkDestroyShaderModule(d, frag_module, nullptr);
+	if(result != VK_SUCCESS){
+		VK_ERROR("Failed to create section draw pipeline.");
+		throw std::exception();
+	}
+}
+
+}	// namespace eng
+}	// namespace uni
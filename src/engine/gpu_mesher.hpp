@@ -0,0 +1,273 @@
+/**
+ * @file src/engine/gpu_mesher.hpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#pragma once
+
+#include "engine/allocator.hpp"
+#include "engine/device.hpp"
+#include "engine/mesh_arena.hpp"
+#include "engine/staging_ring.hpp"
+
+#include "util/math.hpp"
+#include "world/mesher.hpp"
+#include "world/palette.hpp"
+
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace uni {
+namespace eng {
+
+/**
+ * @brief Indirect draw of one section plus where the section is, std430 layout
+ *
+ * Written entirely by the meshing pass, the draw pass reads `origin`
+ * back through `firstInstance`.
+ */
+struct SectionDraw {
+	VkDrawIndirectCommand command;
+	s32 origin[3];
+	u32 pad;
+};
+static_assert(sizeof(SectionDraw) == 32, "SectionDraw must match the shaders");
+
+struct GpuMesherConfig {
+	VkRenderPass render_pass = VK_NULL_HANDLE;  // null meshes without a draw pipeline
+	u32 subpass = 0;
+	u32 max_sections = 1 << 14;
+	u64 quad_capacity = 1 << 24;        // quads in the shared buffer, 4 bytes each
+	u32 jobs_per_frame = 256;
+	VkDeviceSize upload_bytes = 4 << 20;    // block data per frame
+	u32 frames_in_flight = 2;
+	std::string shader_dir = "build/shaders/";
+};
+
+struct GpuMesherStats {
+	u32 sections = 0;
+	u32 jobs = 0;                   // this frame
+	u32 uploads = 0;                // this frame, sections uploaded already meshed
+	u32 deferred = 0;               // this frame, sections refused for lack of space
+	VkDeviceSize bytes_uploaded = 0;    // this frame
+	u64 quads_reserved = 0;         // including ranges waiting to retire
+	u32 draw_calls = 0;
+};
+
+/**
+ * @brief Meshes sections in a compute shader and draws them indirectly
+ *
+ * Sections are uploaded palette compressed together with the faces of
+ * their six neighbours. One workgroup per section culls faces and
+ * appends `world::ChunkQuad`s through a shared memory counter into the
+ * section's range of one shared quad buffer, then writes the section's
+ * indirect draw. Nothing is read back, the draw pass pulls quads by
+ * `gl_VertexIndex` and draws every section from the draw buffer.
+ *
+ * Quad ranges are reserved on the CPU from `world::max_quads` and
+ * freed ranges are reused once the frames that may read them retired,
+ * like `MeshArena`. The output matches `world::mesh_section` up to the
+ * order of the quads.
+ *
+ * Sections meshed elsewhere, such as hits of a `world::MeshCache`, are
+ * uploaded as they are and skip the meshing pass.
+ */
+class GpuMesher {
+public:
+	GpuMesher(const GpuMesher&) = delete;
+	GpuMesher& operator=(const GpuMesher&) = delete;
+
+	GpuMesher(Device& device, StagingRing& staging, const GpuMesherConfig& config);
+
+	~GpuMesher();
+
+	/**
+	 * @brief Starts a frame, releasing ranges no frame in flight can read
+	 * @param[in] frame Index of the frame about to be recorded
+	 * @return void
+	 */
+	void begin_frame(u64 frame);
+
+	/**
+	 * @brief Queues a section to be meshed by the next `record`
+	 *
+	 * Passing an existing id replaces that section's mesh. A section must
+	 * be queued at most once per frame.
+	 *
+	 * @param[in,out] id Mesh to replace or NO_MESH, becomes the section's
+	 * mesh, NO_MESH when the section is empty
+	 * @param[in] section
+	 * @param[in] sx Section coordinates, world block coordinates >> 4
+	 * @param[in] sy
+	 * @param[in] sz
+	 * @return False when this frame is out of space, `id` and its mesh are
+	 * then left as they were and the section should be queued again
+	 */
+	bool mesh(MeshId& id, const world::SectionNeighbours& section, s32 sx, s32 sy, s32 sz);
+
+	/**
+	 * @brief Uploads quads meshed elsewhere, such as a `world::MeshCache` hit
+	 *
+	 * The quads are copied into the staging ring as they are and the
+	 * section's draw is written along with them, the meshing pass is
+	 * skipped. Same rules as `mesh` otherwise.
+	 *
+	 * @param[in,out] id Mesh to replace or NO_MESH, becomes the section's
+	 * mesh, NO_MESH when there are no quads
+	 * @param[in] quads In `world::ChunkQuad` encoding
+	 * @param[in] count
+	 * @param[in] sx Section coordinates, world block coordinates >> 4
+	 * @param[in] sy
+	 * @param[in] sz
+	 * @return False when this frame is out of space, as for `mesh`
+	 */
+	bool upload(MeshId& id, const world::ChunkQuad* quads, u32 count, s32 sx, s32 sy, s32 sz);
+
+	/**
+	 * @brief Frees a section's mesh, its id may be reused
+	 * @param[in] id
+	 * @return void
+	 */
+	void destroy(MeshId id);
+
+	/**
+	 * @brief Records this frame's uploads, copies and the meshing pass
+	 *
+	 * Must be recorded outside a render pass, before `record_draw`.
+	 *
+	 * @param[in] command_buffer
+	 * @return void
+	 */
+	void record(VkCommandBuffer command_buffer);
+
+	/**
+	 * @brief Draws every section, inside the render pass given in the config
+	 *
+	 * Viewport and scissor are dynamic state and must already be set.
+	 *
+	 * @param[in] command_buffer
+	 * @param[in] view_proj
+	 * @return void
+	 */
+	void record_draw(VkCommandBuffer command_buffer, const Mat4& view_proj);
+
+	/**
+	 * @brief Destroys the meshes of the sections farthest from a section
+	 *
+	 * For a `MemoryBudget` evictor, call it before queuing the frame's
+	 * sections. Sections queued this frame are never evicted.
+	 *
+	 * @param[in] bytes Quad buffer bytes to free at least
+	 * @param[in] sx Section coordinates to keep close meshes around
+	 * @param[in] sy
+	 * @param[in] sz
+	 * @param[out] evicted Ids destroyed, their owners must forget them
+	 * @return Bytes freed
+	 */
+	VkDeviceSize evict(VkDeviceSize bytes, s32 sx, s32 sy, s32 sz, std::vector<MeshId>& evicted);
+
+	/**
+	 * @brief Quad buffer bytes a section's mesh holds, what destroying it frees
+	 */
+	VkDeviceSize get_bytes(MeshId id) const { return quad_sizes[id] * sizeof(world::ChunkQuad); }
+
+	/**
+	 * @brief Quad buffer bytes no mesh holds, including ranges still retiring
+	 */
+	VkDeviceSize get_free_bytes() const { return (quad_allocator.get_capacity() - live_quads) * sizeof(world::ChunkQuad); }
+
+	VkBuffer get_quad_buffer() const { return quad_buffer; }
+	VkBuffer get_draw_buffer() const { return draw_buffer; }
+	const GpuMesherStats& get_stats() const { return stats; }
+
+private:
+	/**
+	 * @brief One queued section as the meshing pass sees it, std430 layout
+	 *
+	 * Offsets are in 32 bit words into the frame's upload data.
+	 */
+	struct Job {
+		s32 origin[3];
+		u32 slot;
+		u32 quad_base;
+		u32 quad_capacity;
+		u32 bits;
+		u32 palette;
+		u32 words;
+		u32 border;
+		u32 pad[2];
+	};
+	static_assert(sizeof(Job) == 48, "Job must match the shaders");
+
+	struct Retired {
+		u64 frame;
+		u64 offset;
+	};
+
+	struct Placement {
+		s32 section[3];
+		u64 frame;      // last queued
+	};
+
+	void release(MeshId id);
+
+	/**
+	 * @brief Takes a slot for a section, its quad range and staging space
+	 * @return The slot, NO_MESH when any of them ran out and nothing was taken
+	 */
+	MeshId reserve(MeshId id, u64 quads, VkDeviceSize bytes, u64& quad_base, VkDeviceSize& offset);
+	void create_descriptors();
+	void create_pipelines();
+
+	Device& device;
+	StagingRing& staging;
+	GpuMesherConfig config;
+	bool multi_draw;
+
+	VkBuffer quad_buffer;
+	VkDeviceMemory quad_memory;
+	VkBuffer draw_buffer;
+	VkDeviceMemory draw_memory;
+	VkDeviceSize job_bytes;     // header part of each job buffer
+
+	// Per frame in flight
+	std::vector<VkBuffer> job_buffers;
+	std::vector<VkDeviceMemory> job_memory;
+	std::vector<VkDescriptorSet> mesh_sets;
+
+	VkDescriptorPool descriptor_pool;
+	VkDescriptorSetLayout mesh_set_layout;
+	VkDescriptorSetLayout draw_set_layout;
+	VkDescriptorSet draw_set;
+	VkPipelineLayout mesh_layout;
+	VkPipelineLayout draw_layout = VK_NULL_HANDLE;
+	VkPipeline mesh_pipeline;
+	VkPipeline draw_pipeline = VK_NULL_HANDLE;
+
+	FreeListAllocator quad_allocator;
+	std::vector<u64> quad_offsets;      // by slot, ~0 when free
+	std::vector<u64> quad_sizes;        // by slot
+	std::vector<Placement> placements;  // by slot
+	u64 live_quads = 0;                 // held by meshes, not retiring
+	std::vector<MeshId> free_ids;
+	u32 slot_count = 0;                 // high water mark of slots
+	std::deque<Retired> retired;
+	u64 current_frame = 0;
+	u32 current = 0;
+
+	// Work for the next `record`
+	u32 jobs = 0;
+	u64 upload_words = 0;
+	std::vector<VkBufferCopy> copies;
+	std::vector<VkBufferCopy> quad_copies;
+	std::vector<VkBufferCopy> draw_copies;
+	std::vector<u32> cleared;
+	world::PalettedSection paletted;
+
+	GpuMesherStats stats;
+};
+
+}	// namespace eng
+}	// namespace uni
@@ -0,0 +1,411 @@
+/**
+ * @file src/engine/instance_renderer.cpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#include "engine/instance_renderer.hpp"
+
+#include "util/util.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+
+namespace uni {
+namespace eng {
+
+namespace {
+
+struct CullPush {
+	f32 planes[6][4];
+	u32 count;
+};
+
+struct DrawPush {
+	Mat4 view_proj;
+	u32 base;
+};
+
+constexpr u32 CULL_GROUP_SIZE = 64;
+
+}	// namespace
+
+InstanceRenderer::InstanceRenderer(Device& device, MeshArena& arena, const InstanceRendererConfig& config)
+	: device{device}, arena{arena}, config{config}, type_counts(MAX_INSTANCE_TYPES, 0) {
+	if(arena.get_vertex_stride() != sizeof(EntityVertex)){
+		ERROR("INSTANCE RENDERER", "Mesh arena vertex stride " << arena.get_vertex_stride() << " is not EntityVertex.");
+		throw std::exception();
+	}
+
+	u32 frames = config.frames_in_flight;
+	instance_buffers.resize(frames);
+	instance_memory.resize(frames);
+	mapped.resize(frames);
+	visible_buffers.resize(frames);
+	visible_memory.resize(frames);
+	draw_buffers.resize(frames);
+	draw_memory.resize(frames);
+	draws.resize(frames);
+
+	VkDeviceSize instance_bytes = VkDeviceSize(config.capacity) * sizeof(InstanceData);
+	VkDeviceSize draw_bytes = VkDeviceSize(MAX_INSTANCE_TYPES) * sizeof(InstanceDraw);
+	for(u32 i = 0; i < frames; i++){
+		// Written by the CPU every frame, read once by the cull pass
+		device.create_buffer(
+			instance_bytes,
+			VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+			instance_buffers[i],
+			instance_memory[i]
+		);
+		vkMapMemory(device.get_device(), instance_memory[i], 0, instance_bytes, 0, reinterpret_cast<void**>(&mapped[i]));
+
+		device.create_buffer(
+			instance_bytes,
+			VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+			visible_buffers[i],
+			visible_memory[i]
+		);
+
+		// Small, so kept host visible and filled in place instead of staged
+		device.create_buffer(
+			draw_bytes,
+			VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+			draw_buffers[i],
+			draw_memory[i]
+		);
+		vkMapMemory(device.get_device(), draw_memory[i], 0, draw_bytes, 0, reinterpret_cast<void**>(&draws[i]));
+	}
+
+	create_descriptors();
+	create_pipelines();
+	VK_INFO("Created Instance Renderer.");
+}
+
+InstanceRenderer::~InstanceRenderer(){
+	VkDevice d = device.get_device();
+	vkDestroyPipeline(d, draw_pipeline, nullptr);
+	vkDestroyPipeline(d, cull_pipeline, nullptr);
+	vkDestroyPipelineLayout(d, draw_layout, nullptr);
+	vkDestroyPipelineLayout(d, cull_layout, nullptr);
+	vkDestroyDescriptorPool(d, descriptor_pool, nullptr);
+	vkDestroyDescriptorSetLayout(d, draw_set_layout, nullptr);
+	vkDestroyDescriptorSetLayout(d, cull_set_layout, nullptr);
+	for(u32 i = 0; i < config.frames_in_flight; i++){
+		vkUnmapMemory(d, instance_memory[i]);
+		vkDestroyBuffer(d, instance_buffers[i], nullptr);
+		device.free_memory(instance_memory[i]);
+		vkDestroyBuffer(d, visible_buffers[i], nullptr);
+		device.free_memory(visible_memory[i]);
+		vkUnmapMemory(d, draw_memory[i]);
+		vkDestroyBuffer(d, draw_buffers[i], nullptr);
+		device.free_memory(draw_memory[i]);
+	}
+	VK_INFO("Destroyed Instance Renderer.");
+}
+
+u32 InstanceRenderer::add_mesh_type(MeshId mesh, f32 radius){
+	if(types.size() == MAX_INSTANCE_TYPES){
+		ERROR("INSTANCE RENDERER", "More than " << MAX_INSTANCE_TYPES << " mesh types.");
+		throw std::exception();
+	}
+	types.push_back({mesh, radius});
+	stats.mesh_types = static_cast<u32>(types.size());
+	return stats.mesh_types - 1;
+}
+
+void InstanceRenderer::begin_frame(u64 frame){
+	current = static_cast<u32>(frame % config.frames_in_flight);
+	count = 0;
+	std::fill(type_counts.begin(), type_counts.begin() + types.size(), 0);
+	stats.instances = 0;
+	stats.draw_calls = 0;
+}
+
+void InstanceRenderer::record_cull(VkCommandBuffer command_buffer, const Frustum& frustum){
+	stats.instances = count;
+
+	/*
+	 * Each type gets as many visible slots as it has instances, culling can
+	 * only shrink that. The counts start at zero and the cull pass fills
+	 * them in.
+	 */
+	u32 base = 0;
+	for(u32 t = 0; t < types.size(); t++){
+		const MeshRange& range = arena.get(types[t].mesh);
+		InstanceDraw& draw = draws[current][t];
+		draw.command.indexCount = range.index_count;
+		draw.command.instanceCount = 0;
+		draw.command.firstIndex = range.first_index;
+		draw.command.vertexOffset = static_cast<s32>(range.vertex_offset);
+		draw.command.firstInstance = 0;
+		draw.radius = types[t].radius;
+		draw.base = base;
+		base += type_counts[t];
+	}
+	if(count == 0){ return; }
+
+	VkMemoryBarrier host_barrier = {};
+	host_barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+	host_barrier.srcAccessMask = VK_ACCESS_HOST_WRITE_BIT;
+	host_barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+	vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_HOST_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &host_barrier, 0, nullptr, 0, nullptr);
+
+	CullPush push;
+	std::memcpy(push.planes, frustum.planes, sizeof(push.planes));
+	push.count = count;
+
+	vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, cull_pipeline);
+	vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, cull_layout, 0, 1, &cull_sets[current], 0, nullptr);
+	vkCmdPushConstants(command_buffer, cull_layout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(push), &push);
+	vkCmdDispatch(command_buffer, (count + CULL_GROUP_SIZE - 1) / CULL_GROUP_SIZE, 1, 1);
+
+	VkMemoryBarrier cull_barrier = {};
+	cull_barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+	cull_barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+	cull_barrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+	vkCmdPipelineBarrier(
+		command_buffer,
+		VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+		VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
+		0, 1, &cull_barrier, 0, nullptr, 0, nullptr
+	);
+}
+
+void InstanceRenderer::record_draw(VkCommandBuffer command_buffer, const Mat4& view_proj){
+	if(count == 0){ return; }
+
+	VkBuffer vertex_buffer = arena.get_vertex_buffer();
+	VkDeviceSize offset = 0;
+	vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, draw_pipeline);
+	vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, draw_layout, 0, 1, &draw_sets[current], 0, nullptr);
+	vkCmdBindVertexBuffers(command_buffer, 0, 1, &vertex_buffer, &offset);
+	vkCmdBindIndexBuffer(command_buffer, arena.get_index_buffer(), 0, VK_INDEX_TYPE_UINT32);
+
+	DrawPush push;
+	push.view_proj = view_proj;
+	for(u32 t = 0; t < types.size(); t++){
+		if(type_counts[t] == 0){ continue; }
+		push.base = draws[current][t].base;
+		vkCmdPushConstants(command_buffer, draw_layout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(push), &push);
+		vkCmdDrawIndexedIndirect(command_buffer, draw_buffers[current], VkDeviceSize(t) * sizeof(InstanceDraw), 1, sizeof(InstanceDraw));
+		stats.draw_calls++;
+	}
+}
+
+void InstanceRenderer::create_descriptors(){
+	VkDevice d = device.get_device();
+
+	std::array<VkDescriptorSetLayoutBinding, 3> bindings = {};
+	for(u32 i = 0; i < bindings.size(); i++){
+		bindings[i].binding = i;
+		bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		bindings[i].descriptorCount = 1;
+		bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+	}
+
+	VkDescriptorSetLayoutCreateInfo layout_info = {};
+	layout_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+	layout_info.bindingCount = static_cast<u32>(bindings.size());
+	layout_info.pBindings = bindings.data();
+	if(vkCreateDescriptorSetLayout(d, &layout_info, nullptr, &cull_set_layout) != VK_SUCCESS){
+		VK_ERROR("Failed to create instance cull descriptor set layout.");
+		throw std::exception();
+	}
+
+	bindings[0].stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+	layout_info.bindingCount = 1;
+	if(vkCreateDescriptorSetLayout(d, &layout_info, nullptr, &draw_set_layout) != VK_SUCCESS){
+		VK_ERROR("Failed to create instance draw descriptor set layout.");
+		throw std::exception();
+	}
+
+	u32 frames = config.frames_in_flight;
+	VkDescriptorPoolSize pool_size = {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, frames * 4};
+	VkDescriptorPoolCreateInfo pool_info = {};
+	pool_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+	pool_info.maxSets = frames * 2;
+	pool_info.poolSizeCount = 1;
+	pool_info.pPoolSizes = &pool_size;
+	if(vkCreateDescriptorPool(d, &pool_info, nullptr, &descriptor_pool) != VK_SUCCESS){
+		VK_ERROR("Failed to create instance descriptor pool.");
+		throw std::exception();
+	}
+
+	std::vector<VkDescriptorSetLayout> cull_layouts(frames, cull_set_layout);
+	std::vector<VkDescriptorSetLayout> draw_layouts(frames, draw_set_layout);
+	cull_sets.resize(frames);
+	draw_sets.resize(frames);
+
+	VkDescriptorSetAllocateInfo allocate_info = {};
+	allocate_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+	allocate_info.descriptorPool = descriptor_pool;
+	allocate_info.descriptorSetCount = frames;
+	allocate_info.pSetLayouts = cull_layouts.data();
+	if(vkAllocateDescriptorSets(d, &allocate_info, cull_sets.data()) != VK_SUCCESS){
+		VK_ERROR("Failed to allocate instance cull descriptor sets.");
+		throw std::exception();
+	}
+	allocate_info.pSetLayouts = draw_layouts.data();
+	if(vkAllocateDescriptorSets(d, &allocate_info, draw_sets.data()) != VK_SUCCESS){
+		VK_ERROR("Failed to allocate instance draw descriptor sets.");
+		throw std::exception();
+	}
+
+	for(u32 i = 0; i < frames; i++){
+		VkDescriptorBufferInfo infos[3] = {
+			{instance_buffers[i], 0, VK_WHOLE_SIZE},
+			{visible_buffers[i], 0, VK_WHOLE_SIZE},
+			{draw_buffers[i], 0, VK_WHOLE_SIZE},
+		};
+
+		VkWriteDescriptorSet writes[4] = {};
+		for(u32 b = 0; b < 4; b++){
+			writes[b].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+			writes[b].dstSet = b < 3 ? cull_sets[i] : draw_sets[i];
+			writes[b].dstBinding = b < 3 ? b : 0;
+			writes[b].descriptorCount = 1;
+			writes[b].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+			writes[b].pBufferInfo = &infos[b < 3 ? b : 1];
+		}
+		vkUpdateDescriptorSets(d, 4, writes, 0, nullptr);
+	}
+}
+
+void InstanceRenderer::create_pipelines(){
+	VkDevice d = device.get_device();
+
+	VkPushConstantRange cull_range = {VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(CullPush)};
+	VkPipelineLayoutCreateInfo layout_info = {};
+	layout_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+	layout_info.setLayoutCount = 1;
+	layout_info.pSetLayouts = &cull_set_layout;
+	layout_info.pushConstantRangeCount = 1;
+	layout_info.pPushConstantRanges = &cull_range;
+	if(vkCreatePipelineLayout(d, &layout_info, nullptr, &cull_layout) != VK_SUCCESS){
+		VK_ERROR("Failed to create instance cull pipeline layout.");
+		throw std::exception();
+	}
+
+	VkPushConstantRange draw_range = {VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(DrawPush)};
+	layout_info.pSetLayouts = &draw_set_layout;
+	layout_info.pPushConstantRanges = &draw_range;
+	if(vkCreatePipelineLayout(d, &layout_info, nullptr, &draw_layout) != VK_SUCCESS){
+		VK_ERROR("Failed to create instance draw pipeline layout.");
+		throw std::exception();
+	}
+
+	// Cull pass
+	VkShaderModule cull_module = device.create_shader_module(config.shader_dir + "instance_cull.comp.spv");
+
+	VkComputePipelineCreateInfo compute_info = {};
+	compute_info.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+	compute_info.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+	compute_info.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+	compute_info.stage.module = cull_module;
+	compute_info.stage.pName = "main";
+	compute_info.layout = cull_layout;
+	VkResult result = vkCreateComputePipelines(d, VK_NULL_HANDLE, 1, &compute_info, nullptr, &cull_pipeline);
+	vkDestroyShaderModule(d, cull_module, nullptr);
+	if(result != VK_SUCCESS){
+		VK_ERROR("Failed to create instance cull pipeline.");
+		throw std::exception();
+	}
+
+	// Draw pass
+	VkShaderModule vert_module = device.create_shader_module(config.shader_dir + "instance.vert.spv");
+	VkShaderModule frag_module = device.create_shader_module(config.shader_dir + "instance.frag.spv");
+
+	VkPipelineShaderStageCreateInfo stages[2] = {};
+	stages[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+	stages[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
+	stages[0].module = vert_module;
+	stages[0].pName = "main";
+	stages[1].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+	stages[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+	stages[1].module = frag_module;
+	stages[1].pName = "main";
+
+	VkVertexInputBindingDescription binding = {0, sizeof(EntityVertex), VK_VERTEX_INPUT_RATE_VERTEX};
+	VkVertexInputAttributeDescription attributes[2] = {
+		{0, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(EntityVertex, position)},
+		{1, 0, VK_FORMAT_R8G8B8A8_UNORM, offsetof(EntityVertex, color)},
+	};
+
+	VkPipelineVertexInputStateCreateInfo vertex_input = {};
+	vertex_input.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+	vertex_input.vertexBindingDescriptionCount = 1;
+	vertex_input.pVertexBindingDescriptions = &binding;
+	vertex_input.vertexAttributeDescriptionCount = 2;
+	vertex_input.pVertexAttributeDescriptions = attributes;
+
+	VkPipelineInputAssemblyStateCreateInfo input_assembly = {};
+	input_assembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+	input_assembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+	VkPipelineViewportStateCreateInfo viewport = {};
+	viewport.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+	viewport.viewportCount = 1;
+	viewport.scissorCount = 1;
+
+	VkPipelineRasterizationStateCreateInfo rasterization = {};
+	rasterization.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+	rasterization.polygonMode = VK_POLYGON_MODE_FILL;
+	rasterization.cullMode = VK_CULL_MODE_BACK_BIT;
+	rasterization.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+	rasterization.lineWidth = 1.0f;
+
+	VkPipelineMultisampleStateCreateInfo multisample = {};
+	multisample.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+	multisample.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+	VkPipelineDepthStencilStateCreateInfo depth = {};
+	depth.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+	depth.depthTestEnable = VK_TRUE;
+	depth.depthWriteEnable = VK_TRUE;
+	depth.depthCompareOp = VK_COMPARE_OP_LESS;
+
+	VkPipelineColorBlendAttachmentState blend_attachment = {};
+	blend_attachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+
+	VkPipelineColorBlendStateCreateInfo blend = {};
+	blend.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+	blend.attachmentCount = 1;
+	blend.pAttachments = &blend_attachment;
+
+	VkDynamicState dynamic_states[2] = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
+	VkPipelineDynamicStateCreateInfo dynamic = {};
+	dynamic.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+	dynamic.dynamicStateCount = 2;
+	dynamic.pDynamicStates = dynamic_states;
+
+	VkGraphicsPipelineCreateInfo pipeline_info = {};
+	pipeline_info.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+	pipeline_info.stageCount = 2;
+	pipeline_info.pStages = stages;
+	pipeline_info.pVertexInputState = &vertex_input;
+	pipeline_info.pInputAssemblyState = &input_assembly;
+	pipeline_info.pViewportState = &viewport;
+	pipeline_info.pRasterizationState = &rasterization;
+	pipeline_info.pMultisampleState = &multisample;
+	pipeline_info.pDepthStencilState = &depth;
+	pipeline_info.pColorBlendState = &blend;
+	pipeline_info.pDynamicState = &dynamic;
+	pipeline_info.layout = draw_layout;
+	pipeline_info.renderPass = config.render_pass;
+	pipeline_info.subpass = config.subpass;
+
+	result = vkCreateGraphicsPipelines(d, VK_NULL_HANDLE, 1, &pipeline_info, nullptr, &draw_pipeline);
+	vkDestroyShaderModule(d, vert_module, nullptr);
+	vkDestroyShaderModule(d, frag_module, nullptr);
+	if(result != VK_SUCCESS){
+		VK_ERROR("Failed to create instance draw pipeline.");
+		throw std::exception();
+	}
+}
+
+}	// namespace eng
+}	// namespace uni
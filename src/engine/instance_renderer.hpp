@@ -0,0 +1,194 @@
+/**
+ * @file src/engine/instance_renderer.hpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#pragma once
+
+#include "engine/device.hpp"
+#include "engine/mesh_arena.hpp"
+
+#include "util/math.hpp"
+
+#include <string>
+#include <vector>
+
+namespace uni {
+namespace eng {
+
+/**
+ * @brief Vertex format of entity meshes in the mesh arena
+ */
+struct EntityVertex {
+	f32 position[3];
+	u32 color;      // R8G8B8A8
+};
+
+/**
+ * @brief One entity as the GPU sees it, std430 layout
+ */
+struct InstanceData {
+	Vec3 position;
+	f32 yaw = 0.0f;
+	f32 scale = 1.0f;
+	f32 anim_time = 0.0f;
+	u32 anim_state = 0;
+	u32 type = 0;       // from `InstanceRenderer::add_mesh_type`
+};
+static_assert(sizeof(InstanceData) == 32, "InstanceData must match the shaders");
+
+/**
+ * @brief Indirect draw of one mesh type plus what the cull pass needs
+ *
+ * Stride of the indirect draws, the cull pass counts visible instances
+ * straight into `command.instanceCount`.
+ */
+struct InstanceDraw {
+	VkDrawIndexedIndirectCommand command;
+	f32 radius;
+	u32 base;       // first slot of this type in the visible buffer
+	u32 pad;
+};
+static_assert(sizeof(InstanceDraw) == 32, "InstanceDraw must match the shaders");
+
+/**
+ * @brief Largest number of mesh types, fixes the size of the draw buffers
+ */
+constexpr u32 MAX_INSTANCE_TYPES = 256;
+
+struct InstanceRendererConfig {
+	VkRenderPass render_pass;
+	u32 subpass = 0;
+	u32 capacity = 1 << 16;     // instances per frame
+	u32 frames_in_flight = 2;
+	std::string shader_dir = "build/shaders/";
+};
+
+struct InstanceStats {
+	u32 instances = 0;      // pushed this frame, before culling
+	u32 draw_calls = 0;
+	u32 mesh_types = 0;
+};
+
+/**
+ * @brief Draws every entity with one indirect draw per mesh type
+ *
+ * Instances are written straight into a persistently mapped storage
+ * buffer, one per frame in flight. A compute pass tests each against the
+ * view frustum and copies the visible ones, grouped by mesh type, into a
+ * device local buffer while counting them into the indirect draws. The
+ * CPU cost per frame is the copy of 32 bytes per entity and a handful of
+ * commands regardless of how many entities there are.
+ *
+ * Like `StagingRing` the caller must have waited on the fence of frame
+ * N - frames_in_flight before `begin_frame(N)`.
+ */
+class InstanceRenderer {
+public:
+	InstanceRenderer(const InstanceRenderer&) = delete;
+	InstanceRenderer& operator=(const InstanceRenderer&) = delete;
+
+	/**
+	 * @param[in] device
+	 * @param[in] arena Holds the meshes, its vertices must be `EntityVertex`
+	 * @param[in] config
+	 */
+	InstanceRenderer(Device& device, MeshArena& arena, const InstanceRendererConfig& config);
+
+	~InstanceRenderer();
+
+	/**
+	 * @brief Registers a mesh every instance of a type is drawn with
+	 * @param[in] mesh Mesh in the arena
+	 * @param[in] radius Bounding sphere radius around the origin at scale 1
+	 * @return The type to put in `InstanceData::type`
+	 */
+	u32 add_mesh_type(MeshId mesh, f32 radius);
+
+	/**
+	 * @brief Starts writing the instances of a frame
+	 * @param[in] frame Index of the frame about to be recorded
+	 * @return void
+	 */
+	void begin_frame(u64 frame);
+
+	/**
+	 * @brief Adds an instance to this frame
+	 * @return False when the frame is full or the type was never added
+	 */
+	bool push(const InstanceData& instance){
+		if(count == config.capacity || instance.type >= types.size()){ return false; }
+		mapped[current][count++] = instance;
+		type_counts[instance.type]++;
+		return true;
+	}
+
+	/**
+	 * @brief Records the cull and compaction pass
+	 *
+	 * Must be recorded outside a render pass, after the mesh arena's
+	 * `record` and before `record_draw`.
+	 *
+	 * @param[in] command_buffer
+	 * @param[in] frustum Frustum of the camera the instances are drawn with
+	 * @return void
+	 */
+	void record_cull(VkCommandBuffer command_buffer, const Frustum& frustum);
+
+	/**
+	 * @brief Records one indirect draw per mesh type with instances
+	 *
+	 * Must be recorded inside the render pass given in the config. Viewport
+	 * and scissor are dynamic state and must already be set.
+	 *
+	 * @param[in] command_buffer
+	 * @param[in] view_proj
+	 * @return void
+	 */
+	void record_draw(VkCommandBuffer command_buffer, const Mat4& view_proj);
+
+	const InstanceStats& get_stats() const { return stats; }
+
+private:
+	void create_descriptors();
+	void create_pipelines();
+
+	Device& device;
+	MeshArena& arena;
+	InstanceRendererConfig config;
+
+	struct MeshType {
+		MeshId mesh;
+		f32 radius;
+	};
+	std::vector<MeshType> types;
+	std::vector<u32> type_counts;
+
+	// Per frame in flight
+	std::vector<VkBuffer> instance_buffers;
+	std::vector<VkDeviceMemory> instance_memory;
+	std::vector<InstanceData*> mapped;
+	std::vector<VkBuffer> visible_buffers;
+	std::vector<VkDeviceMemory> visible_memory;
+	std::vector<VkBuffer> draw_buffers;
+	std::vector<VkDeviceMemory> draw_memory;
+	std::vector<InstanceDraw*> draws;
+	std::vector<VkDescriptorSet> cull_sets;
+	std::vector<VkDescriptorSet> draw_sets;
+
+	VkDescriptorPool descriptor_pool;
+	VkDescriptorSetLayout cull_set_layout;
+	VkDescriptorSetLayout draw_set_layout;
+	VkPipelineLayout cull_layout;
+	VkPipelineLayout draw_layout;
+	VkPipeline cull_pipeline;
+	VkPipeline draw_pipeline;
+
+	u32 current = 0;
+	u32 count = 0;
+	InstanceStats stats;
+};
+
+}	// namespace eng
+}	// namespace uni
@@ -0,0 +1,76 @@
+/**
+ * @file src/engine/memory_budget.cpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#include "engine/memory_budget.hpp"
+
+#include "util/util.hpp"
+
+#include <algorithm>
+
+namespace uni {
+namespace eng {
+
+MemoryBudget::MemoryBudget(Device& device, const MemoryBudgetConfig& config) : device{device}, config{config} {
+	if(config.low_watermark > config.high_watermark){
+		ERROR("MEMORY", "Low watermark " << config.low_watermark << " is above the high watermark " << config.high_watermark << ".");
+		throw std::exception();
+	}
+}
+
+void MemoryBudget::add_evictor(Evictor evictor){
+	evictors.push_back(std::move(evictor));
+}
+
+void MemoryBudget::add_pool(PoolFree pool){
+	pools.push_back(std::move(pool));
+}
+
+void MemoryBudget::begin_frame(){
+	// The device local heap closest to its budget, integrated GPUs have only one
+	const MemoryStats& memory = device.poll_memory();
+	stats.budget = 0;
+	stats.usage = 0;
+	f32 fullest = 0.0f;
+	for(const MemoryHeapStats& heap : memory.heaps){
+		if(!heap.device_local || heap.budget == 0){ continue; }
+		f32 pressure = static_cast<f32>(static_cast<f64>(heap.usage) / static_cast<f64>(heap.budget));
+		if(pressure >= fullest){
+			stats.budget = heap.budget;
+			stats.usage = heap.usage;
+			fullest = pressure;
+		}
+	}
+
+	VkDeviceSize pooled = 0;
+	for(const PoolFree& pool : pools){ pooled += pool(); }
+	stats.pooled_free = std::min(pooled, stats.usage);
+	stats.usage -= stats.pooled_free;
+	stats.pressure = stats.budget > 0 ? static_cast<f32>(static_cast<f64>(stats.usage) / static_cast<f64>(stats.budget)) : 0.0f;
+
+	// Compared in bytes, what evictors free must end the crossing exactly
+	VkDeviceSize high = static_cast<VkDeviceSize>(static_cast<f64>(stats.budget) * config.high_watermark);
+	VkDeviceSize low = static_cast<VkDeviceSize>(static_cast<f64>(stats.budget) * config.low_watermark);
+	if(!stats.evicting && stats.usage > high){
+		stats.evicting = true;
+		stats.episodes++;
+		WARNING("MEMORY", "Device memory at " << stats.pressure * 100.0f << "% of budget, evicting.");
+	} else if(stats.evicting && stats.usage <= low){
+		stats.evicting = false;
+	}
+
+	stats.evicted = 0;
+	if(!stats.evicting){ return; }
+
+	VkDeviceSize wanted = std::min(stats.usage - low, config.evict_per_frame);
+	for(const Evictor& evictor : evictors){
+		if(stats.evicted >= wanted){ break; }
+		stats.evicted += evictor(wanted - stats.evicted);
+	}
+	stats.total_evicted += stats.evicted;
+}
+
+}	// namespace eng
+}	// namespace uni
@@ -0,0 +1,102 @@
+/**
+ * @file src/engine/memory_budget.hpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#pragma once
+
+#include "engine/device.hpp"
+
+#include <functional>
+#include <vector>
+
+namespace uni {
+namespace eng {
+
+struct MemoryBudgetConfig {
+	f32 high_watermark = 0.90f;                 // of the budget, eviction starts above it
+	f32 low_watermark = 0.75f;                  // and stops below it
+	VkDeviceSize evict_per_frame = 64 << 20;    // most bytes asked of the evictors in one frame
+};
+
+struct MemoryBudgetStats {
+	VkDeviceSize budget = 0;        // of the fullest device local heap
+	VkDeviceSize usage = 0;         // less what pools hold free
+	VkDeviceSize pooled_free = 0;
+	f32 pressure = 0.0f;            // usage / budget
+	bool evicting = false;
+	VkDeviceSize evicted = 0;       // this frame
+	VkDeviceSize total_evicted = 0;
+	u32 episodes = 0;               // times usage crossed the high watermark
+};
+
+/**
+ * @brief Frees up to the given bytes of resident data, such as far chunk meshes
+ * @return Bytes actually freed
+ */
+using Evictor = std::function<VkDeviceSize(VkDeviceSize bytes)>;
+
+/**
+ * @brief Bytes free inside a long lived buffer the engine sub-allocates from
+ */
+using PoolFree = std::function<VkDeviceSize()>;
+
+/**
+ * @brief Keeps device memory usage under the budget the driver reports
+ *
+ * Polls `Device::poll_memory` every frame and watches the device local
+ * heap closest to its budget. Once its usage crosses the high watermark,
+ * evictors are asked each frame to free what lies above the low
+ * watermark, at most `evict_per_frame` bytes a frame, until usage falls
+ * below the low watermark again.
+ *
+ * Most engine memory is sub-allocated from long lived buffers, freeing
+ * inside them lowers no usage the driver sees. Pools report what they
+ * hold free and that is taken off the usage, so evicting from a pool
+ * ends the crossing and filling it again starts the next one. Pools are
+ * taken to live in the heap being watched.
+ *
+ * While `is_evicting`, streaming should hold off loading more.
+ */
+class MemoryBudget {
+public:
+	MemoryBudget(const MemoryBudget&) = delete;
+	MemoryBudget& operator=(const MemoryBudget&) = delete;
+
+	MemoryBudget(Device& device, const MemoryBudgetConfig& config);
+
+	/**
+	 * @brief Adds an evictor, they are asked in the order added
+	 * @param[in] evictor
+	 * @return void
+	 */
+	void add_evictor(Evictor evictor);
+
+	/**
+	 * @brief Adds a pool whose free bytes do not count as used
+	 * @param[in] pool
+	 * @return void
+	 */
+	void add_pool(PoolFree pool);
+
+	/**
+	 * @brief Polls the device and evicts if over the high watermark
+	 * @return void
+	 */
+	void begin_frame();
+
+	bool is_evicting() const { return stats.evicting; }
+	const MemoryBudgetStats& get_stats() const { return stats; }
+
+private:
+	Device& device;
+	MemoryBudgetConfig config;
+	std::vector<Evictor> evictors;
+	std::vector<PoolFree> pools;
+
+	MemoryBudgetStats stats;
+};
+
+}	// namespace eng
+}	// namespace uni
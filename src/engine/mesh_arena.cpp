@@ -0,0 +1,256 @@
+/**
+ * @file src/engine/mesh_arena.cpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#include "engine/mesh_arena.hpp"
+
+#include "util/util.hpp"
+
+#include <algorithm>
+
+namespace uni {
+namespace eng {
+
+MeshArena::MeshArena(Device& device, StagingRing& staging, const MeshArenaConfig& config)
+	: device{device}, staging{staging}, config{config},
+	  vertex_allocator{config.vertex_capacity}, index_allocator{config.index_capacity} {
+	device.create_buffer(
+		config.vertex_capacity * config.vertex_stride,
+		VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | config.extra_usage,
+		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+		vertex_buffer,
+		vertex_memory
+	);
+	device.create_buffer(
+		config.index_capacity * sizeof(u32),
+		VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | config.extra_usage,
+		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+		index_buffer,
+		index_memory
+	);
+	VK_INFO("Created Mesh Arena.");
+}
+
+MeshArena::~MeshArena(){
+	vkDestroyBuffer(device.get_device(), vertex_buffer, nullptr);
+	device.free_memory(vertex_memory);
+	vkDestroyBuffer(device.get_device(), index_buffer, nullptr);
+	device.free_memory(index_memory);
+	VK_INFO("Destroyed Mesh Arena.");
+}
+
+void MeshArena::begin_frame(u64 frame){
+	current_frame = frame;
+	while(!retired.empty() && retired.front().frame + config.frames_in_flight <= frame){
+		const Retired& r = retired.front();
+		(r.index ? index_allocator : vertex_allocator).free(r.offset);
+		retired.pop_front();
+	}
+	stats.bytes_uploaded = 0;
+	stats.bytes_moved = 0;
+}
+
+MeshWrite MeshArena::write(MeshId id, u32 vertex_count, u32 index_count){
+	MeshWrite result;
+	if(id != NO_MESH && (id >= meshes.size() || !alive[id])){
+		WARNING("MESH ARENA", "Write to mesh " << id << " which does not exist.");
+		return result;
+	}
+	VkDeviceSize vertex_bytes = VkDeviceSize(vertex_count) * config.vertex_stride;
+	VkDeviceSize index_bytes = VkDeviceSize(index_count) * sizeof(u32);
+
+	std::optional<u64> vertex_offset = 0, index_offset = 0;
+	if(vertex_count > 0){ vertex_offset = vertex_allocator.allocate(vertex_count); }
+	if(index_count > 0){ index_offset = index_allocator.allocate(index_count); }
+
+	std::optional<VkDeviceSize> vertex_staging = 0, index_staging = 0;
+	if(vertex_offset && index_offset){
+		if(vertex_count > 0){ vertex_staging = staging.allocate(vertex_bytes); }
+		if(index_count > 0 && vertex_staging){ index_staging = staging.allocate(index_bytes, sizeof(u32)); }
+	}
+
+	if(!vertex_offset || !index_offset || !vertex_staging || !index_staging){
+		// Nothing has been recorded yet so the ranges can go straight back
+		if(vertex_count > 0 && vertex_offset){ vertex_allocator.free(*vertex_offset); }
+		if(index_count > 0 && index_offset){ index_allocator.free(*index_offset); }
+		WARNING("MESH ARENA", "Out of space for mesh with " << vertex_count << " vertices.");
+		return result;
+	}
+
+	if(id == NO_MESH){
+		if(free_ids.empty()){
+			id = static_cast<MeshId>(meshes.size());
+			meshes.emplace_back();
+			alive.push_back(true);
+		} else {
+			id = free_ids.back();
+			free_ids.pop_back();
+			alive[id] = true;
+		}
+	} else {
+		release(id);
+	}
+
+	MeshRange& range = meshes[id];
+	range.vertex_offset = static_cast<u32>(*vertex_offset);
+	range.vertex_count = vertex_count;
+	range.first_index = static_cast<u32>(*index_offset);
+	range.index_count = index_count;
+
+	if(vertex_count > 0){
+		vertex_owner[*vertex_offset] = id;
+		pending_vertex.insert(*vertex_offset);
+		vertex_uploads.push_back({*vertex_staging, *vertex_offset * config.vertex_stride, vertex_bytes});
+		result.vertices = staging.data(*vertex_staging);
+	}
+	if(index_count > 0){
+		index_owner[*index_offset] = id;
+		pending_index.insert(*index_offset);
+		index_uploads.push_back({*index_staging, *index_offset * sizeof(u32), index_bytes});
+		result.indices = reinterpret_cast<u32*>(staging.data(*index_staging));
+	}
+	stats.bytes_uploaded += vertex_bytes + index_bytes;
+	result.id = id;
+	return result;
+}
+
+MeshId MeshArena::upload(MeshId id, const void* vertices, u32 vertex_count, const u32* indices, u32 index_count){
+	MeshWrite target = write(id, vertex_count, index_count);
+	if(target.id == NO_MESH){ return NO_MESH; }
+	if(vertex_count > 0){ std::memcpy(target.vertices, vertices, size_t(vertex_count) * config.vertex_stride); }
+	if(index_count > 0){ std::memcpy(target.indices, indices, index_count * sizeof(u32)); }
+	return target.id;
+}
+
+void MeshArena::destroy(MeshId id){
+	if(id >= meshes.size() || !alive[id]){ return; }
+	release(id);
+	meshes[id] = {};
+	alive[id] = false;
+	free_ids.push_back(id);
+}
+
+void MeshArena::record(VkCommandBuffer command_buffer){
+	std::vector<VkBufferCopy> vertex_moves, index_moves;
+	compact_into(vertex_moves, index_moves);
+
+	if(vertex_uploads.empty() && index_uploads.empty() && vertex_moves.empty() && index_moves.empty()){
+		return;
+	}
+
+	if(!vertex_uploads.empty()){
+		vkCmdCopyBuffer(command_buffer, staging.get_buffer(), vertex_buffer, static_cast<u32>(vertex_uploads.size()), vertex_uploads.data());
+	}
+	if(!index_uploads.empty()){
+		vkCmdCopyBuffer(command_buffer, staging.get_buffer(), index_buffer, static_cast<u32>(index_uploads.size()), index_uploads.data());
+	}
+
+	// Sources and destinations of one compaction pass never overlap
+	if(!vertex_moves.empty()){
+		vkCmdCopyBuffer(command_buffer, vertex_buffer, vertex_buffer, static_cast<u32>(vertex_moves.size()), vertex_moves.data());
+	}
+	if(!index_moves.empty()){
+		vkCmdCopyBuffer(command_buffer, index_buffer, index_buffer, static_cast<u32>(index_moves.size()), index_moves.data());
+	}
+
+	// Later frames' compaction copies read and overwrite what this frame wrote too
+	VkMemoryBarrier barrier = {};
+	barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+	barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+	barrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_SHADER_READ_BIT
+		| VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+	vkCmdPipelineBarrier(
+		command_buffer,
+		VK_PIPELINE_STAGE_TRANSFER_BIT,
+		VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+		0, 1, &barrier, 0, nullptr, 0, nullptr
+	);
+
+	vertex_uploads.clear();
+	index_uploads.clear();
+	pending_vertex.clear();
+	pending_index.clear();
+}
+
+const MeshArenaStats& MeshArena::get_stats(){
+	stats.meshes = static_cast<u32>(meshes.size() - free_ids.size());
+	stats.vertex_bytes_used = vertex_allocator.get_used() * config.vertex_stride;
+	stats.vertex_bytes_capacity = vertex_allocator.get_capacity() * config.vertex_stride;
+	stats.index_bytes_used = index_allocator.get_used() * sizeof(u32);
+	stats.index_bytes_capacity = index_allocator.get_capacity() * sizeof(u32);
+	stats.vertex_fragmentation = vertex_allocator.fragmentation();
+	stats.index_fragmentation = index_allocator.fragmentation();
+	return stats;
+}
+
+void MeshArena::retire(bool index, u64 offset){
+	retired.push_back({current_frame, index, offset});
+}
+
+void MeshArena::release(MeshId id){
+	MeshRange& range = meshes[id];
+	if(range.vertex_count > 0){
+		vertex_owner.erase(range.vertex_offset);
+		retire(false, range.vertex_offset);
+	}
+	if(range.index_count > 0){
+		index_owner.erase(range.first_index);
+		retire(true, range.first_index);
+	}
+}
+
+void MeshArena::compact_into(std::vector<VkBufferCopy>& vertex_moves, std::vector<VkBufferCopy>& index_moves){
+	f32 fragmentation = std::max(vertex_allocator.fragmentation(), index_allocator.fragmentation());
+	if(!stats.compacting && fragmentation > config.compaction_threshold){
+		stats.compacting = true;
+	} else if(stats.compacting && fragmentation < config.compaction_threshold * 0.5f){
+		stats.compacting = false;
+	}
+	if(!stats.compacting){ return; }
+
+	// Vertices get first claim on the budget, indices get what is left. Only
+	// ranges a mesh still owns move, released ones are waiting to be freed
+	VkDeviceSize budget = config.compaction_budget;
+	auto moves = vertex_allocator.compact(budget / config.vertex_stride, [&](u64 offset){
+		return pending_vertex.count(offset) == 0 && vertex_owner.count(offset) > 0;
+	});
+	for(const auto& move : moves){
+		auto owner = vertex_owner.find(move.src);
+		MeshId id = owner->second;
+		vertex_owner.erase(owner);
+		vertex_owner[move.dst] = id;
+		meshes[id].vertex_offset = static_cast<u32>(move.dst);
+		retire(false, move.src);
+
+		VkDeviceSize bytes = move.size * config.vertex_stride;
+		vertex_moves.push_back({move.src * config.vertex_stride, move.dst * config.vertex_stride, bytes});
+		budget -= bytes;
+	}
+
+	moves = index_allocator.compact(budget / sizeof(u32), [&](u64 offset){
+		return pending_index.count(offset) == 0 && index_owner.count(offset) > 0;
+	});
+	for(const auto& move : moves){
+		auto owner = index_owner.find(move.src);
+		MeshId id = owner->second;
+		index_owner.erase(owner);
+		index_owner[move.dst] = id;
+		meshes[id].first_index = static_cast<u32>(move.dst);
+		retire(true, move.src);
+		index_moves.push_back({move.src * sizeof(u32), move.dst * sizeof(u32), move.size * sizeof(u32)});
+	}
+
+	VkDeviceSize moved = 0;
+	for(const auto& copy : vertex_moves){ moved += copy.size; }
+	for(const auto& copy : index_moves){ moved += copy.size; }
+	stats.bytes_moved += moved;
+	stats.total_bytes_moved += moved;
+
+	// Nothing left that can move, wait for retired ranges to open new holes
+	if(moved == 0){ stats.compacting = false; }
+}
+
+}	// namespace eng
+}	// namespace uni
@@ -0,0 +1,190 @@
+/**
+ * @file src/engine/mesh_arena.hpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#pragma once
+
+#include "engine/allocator.hpp"
+#include "engine/device.hpp"
+#include "engine/staging_ring.hpp"
+
+#include <deque>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace uni {
+namespace eng {
+
+using MeshId = u32;
+constexpr MeshId NO_MESH = ~0u;
+
+/**
+ * @brief Where a mesh lives inside the arena buffers
+ *
+ * Offsets are in elements so they can be handed straight to
+ * vkCmdDrawIndexed as `vertexOffset` and `firstIndex`. Indices are
+ * relative to the mesh's first vertex.
+ */
+struct MeshRange {
+	u32 vertex_offset = 0;
+	u32 vertex_count = 0;
+	u32 first_index = 0;
+	u32 index_count = 0;
+};
+
+/**
+ * @brief Staging memory handed out by `MeshArena::write`
+ *
+ * The caller fills `vertices` and `indices` before the next `record`.
+ */
+struct MeshWrite {
+	MeshId id = NO_MESH;
+	void* vertices = nullptr;
+	u32* indices = nullptr;
+};
+
+struct MeshArenaConfig {
+	VkDeviceSize vertex_stride;
+	u64 vertex_capacity = 1 << 22;
+	u64 index_capacity = 1 << 23;
+
+	// Compaction starts above this fragmentation and stops below half of it
+	f32 compaction_threshold = 0.3f;
+
+	// Bytes compaction may copy per frame
+	VkDeviceSize compaction_budget = 4 << 20;
+
+	u32 frames_in_flight = 2;
+
+	// Extra usage for the arena buffers, e.g. storage for compute passes
+	VkBufferUsageFlags extra_usage = 0;
+};
+
+struct MeshArenaStats {
+	u32 meshes = 0;
+	VkDeviceSize vertex_bytes_used = 0;
+	VkDeviceSize vertex_bytes_capacity = 0;
+	VkDeviceSize index_bytes_used = 0;
+	VkDeviceSize index_bytes_capacity = 0;
+	f32 vertex_fragmentation = 0.0f;
+	f32 index_fragmentation = 0.0f;
+	VkDeviceSize bytes_uploaded = 0;    // this frame
+	VkDeviceSize bytes_moved = 0;       // this frame, by compaction
+	VkDeviceSize total_bytes_moved = 0;
+	bool compacting = false;
+};
+
+/**
+ * @brief All chunk geometry in one vertex buffer and one index buffer
+ *
+ * Meshes are sub-allocated with a free-list allocator and addressed by
+ * offset and count. Freed ranges are only reused once the frames that
+ * may still read them have retired. When fragmentation passes the
+ * configured threshold, every `record` also moves a bounded number of
+ * bytes towards the front of the buffers with vkCmdCopyBuffer.
+ */
+class MeshArena {
+public:
+	MeshArena(const MeshArena&) = delete;
+	MeshArena& operator=(const MeshArena&) = delete;
+
+	MeshArena(Device& device, StagingRing& staging, const MeshArenaConfig& config);
+
+	~MeshArena();
+
+	/**
+	 * @brief Starts a frame, releasing ranges no frame in flight can read
+	 * @param[in] frame Index of the frame about to be recorded
+	 * @return void
+	 */
+	void begin_frame(u64 frame);
+
+	/**
+	 * @brief Reserves space for a mesh's geometry
+	 *
+	 * Passing an existing id replaces that mesh's geometry, the id stays
+	 * valid. The returned pointers are staging memory the caller fills.
+	 *
+	 * @param[in] id Mesh to replace or NO_MESH for a new mesh
+	 * @param[in] vertex_count
+	 * @param[in] index_count
+	 * @return Staging pointers, `id` is NO_MESH when the arena or staging ring is full or `id` was destroyed
+	 */
+	MeshWrite write(MeshId id, u32 vertex_count, u32 index_count);
+
+	/**
+	 * @brief Convenience wrapper around `write` that copies the data in
+	 * @return The mesh id or NO_MESH when out of space
+	 */
+	MeshId upload(MeshId id, const void* vertices, u32 vertex_count, const u32* indices, u32 index_count);
+
+	/**
+	 * @brief Frees a mesh, its id may be reused
+	 * @param[in] id
+	 * @return void
+	 */
+	void destroy(MeshId id);
+
+	/**
+	 * @brief Records this frame's uploads and compaction copies
+	 *
+	 * Must be recorded before any draw that reads the arena. Ends with a
+	 * barrier making the copies visible to vertex input.
+	 *
+	 * @param[in] command_buffer Command buffer in the recording state
+	 * @return void
+	 */
+	void record(VkCommandBuffer command_buffer);
+
+	const MeshRange& get(MeshId id) const { return meshes[id]; }
+	VkBuffer get_vertex_buffer() const { return vertex_buffer; }
+	VkBuffer get_index_buffer() const { return index_buffer; }
+	VkDeviceSize get_vertex_stride() const { return config.vertex_stride; }
+	const MeshArenaStats& get_stats();
+
+private:
+	struct Retired {
+		u64 frame;
+		bool index;
+		u64 offset;
+	};
+
+	void retire(bool index, u64 offset);
+	void release(MeshId id);
+	void compact_into(std::vector<VkBufferCopy>& vertex_moves, std::vector<VkBufferCopy>& index_moves);
+
+	Device& device;
+	StagingRing& staging;
+	MeshArenaConfig config;
+
+	VkBuffer vertex_buffer;
+	VkDeviceMemory vertex_memory;
+	VkBuffer index_buffer;
+	VkDeviceMemory index_memory;
+
+	FreeListAllocator vertex_allocator;
+	FreeListAllocator index_allocator;
+
+	std::vector<MeshRange> meshes;
+	std::vector<bool> alive;
+	std::vector<MeshId> free_ids;
+	std::unordered_map<u64, MeshId> vertex_owner;
+	std::unordered_map<u64, MeshId> index_owner;
+
+	u64 current_frame = 0;
+	std::deque<Retired> retired;
+
+	// Work for the next `record`
+	std::vector<VkBufferCopy> vertex_uploads;
+	std::vector<VkBufferCopy> index_uploads;
+	std::unordered_set<u64> pending_vertex;
+	std::unordered_set<u64> pending_index;
+
+	MeshArenaStats stats;
+};
+
+}	// namespace eng
+}	// namespace uni
@@ -0,0 +1,211 @@
+/**
+ * @file src/engine/render_targets.cpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#include "engine/render_targets.hpp"
+
+#include "util/util.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <numeric>
+
+namespace uni {
+namespace eng {
+
+namespace {
+
+// All a TRANSIENT_ATTACHMENT image may be used as
+constexpr VkImageUsageFlags TRANSIENT_USAGE = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT;
+
+bool has_depth(VkFormat format){
+	switch(format){
+		case VK_FORMAT_D16_UNORM:
+		case VK_FORMAT_D32_SFLOAT:
+		case VK_FORMAT_D24_UNORM_S8_UINT:
+		case VK_FORMAT_D32_SFLOAT_S8_UINT:
+			return true;
+		default:
+			return false;
+	}
+}
+
+bool has_stencil(VkFormat format){
+	return format == VK_FORMAT_D24_UNORM_S8_UINT || format == VK_FORMAT_D32_SFLOAT_S8_UINT;
+}
+
+bool overlaps(const TargetDesc& a, const TargetDesc& b){
+	return a.first_pass <= b.last_pass && b.first_pass <= a.last_pass;
+}
+
+}	// namespace
+
+RenderTargets::RenderTargets(Device& device) : device{device} {}
+
+RenderTargets::~RenderTargets(){
+	destroy();
+}
+
+TargetId RenderTargets::add(const TargetDesc& desc){
+	if(desc.transient && (desc.usage & ~TRANSIENT_USAGE) != 0){
+		ERROR("RENDER TARGETS", "Transient targets may only be used as attachments.");
+		throw std::exception();
+	}
+	if(desc.first_pass > desc.last_pass){
+		ERROR("RENDER TARGETS", "Target is first used in pass " << desc.first_pass << " after its last pass " << desc.last_pass << ".");
+		throw std::exception();
+	}
+	Target target;
+	target.desc = desc;
+	targets.push_back(target);
+	return static_cast<TargetId>(targets.size() - 1);
+}
+
+void RenderTargets::build(u32 width, u32 height){
+	destroy();
+	extent = {width, height};
+	stats = {};
+
+	VkDevice d = device.get_device();
+	for(Target& target : targets){
+		VkImageCreateInfo info = {};
+		info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+		info.imageType = VK_IMAGE_TYPE_2D;
+		info.format = target.desc.format;
+		info.extent = {width, height, 1};
+		info.mipLevels = 1;
+		info.arrayLayers = 1;
+		info.samples = target.desc.samples;
+		info.tiling = VK_IMAGE_TILING_OPTIMAL;
+		info.usage = target.desc.usage;
+		if(target.desc.transient){ info.usage |= VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT; }
+		info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+		info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+		if(vkCreateImage(d, &info, nullptr, &target.image) != VK_SUCCESS){
+			VK_ERROR("Failed to create render target.");
+			throw std::exception();
+		}
+		vkGetImageMemoryRequirements(d, target.image, &target.requirements);
+		target.lazy = target.desc.transient && device.has_memory_type(target.requirements.memoryTypeBits,
+			VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT | VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+		stats.dedicated_bytes += target.requirements.size;
+		stats.lazy_targets += target.lazy;
+	}
+
+	// Largest first, so smaller targets fit in the memory of larger ones
+	std::vector<TargetId> order(targets.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [this](TargetId a, TargetId b){
+		return targets[a].requirements.size > targets[b].requirements.size;
+	});
+	for(TargetId id : order){ targets[id].block = place(id); }
+
+	// Render targets are the last thing that should be evicted
+	for(Block& block : blocks){
+		if(device.allocate_memory(block.requirements, block.properties, 1.0f, block.memory) != VK_SUCCESS){
+			VK_ERROR("Failed to allocate render target memory.");
+			throw std::exception();
+		}
+		stats.allocated_bytes += block.requirements.size;
+	}
+	stats.memory_blocks = static_cast<u32>(blocks.size());
+
+	for(Target& target : targets){
+		vkBindImageMemory(d, target.image, blocks[target.block].memory, 0);
+		VkImageAspectFlags aspect = VK_IMAGE_ASPECT_COLOR_BIT;
+		if(has_depth(target.desc.format)){ aspect = VK_IMAGE_ASPECT_DEPTH_BIT; }
+		if(has_stencil(target.desc.format)){ aspect |= VK_IMAGE_ASPECT_STENCIL_BIT; }
+		target.view = device.create_image_view(target.image, target.desc.format, aspect);
+	}
+
+	poll_stats();
+	VK_INFO("Created " << targets.size() << " render targets in " << blocks.size() << " memory blocks.");
+}
+
+u32 RenderTargets::place(TargetId id){
+	const Target& target = targets[id];
+	VkMemoryPropertyFlags properties = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+	if(target.lazy){ properties |= VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT; }
+
+	if(target.desc.transient){
+		for(u32 i = 0; i < blocks.size(); i++){
+			Block& block = blocks[i];
+			if(block.properties != properties){ continue; }
+			u32 type_bits = block.requirements.memoryTypeBits & target.requirements.memoryTypeBits;
+			if(type_bits == 0 || !device.has_memory_type(type_bits, properties)){ continue; }
+			bool shared = std::any_of(block.targets.begin(), block.targets.end(), [&](TargetId other){
+				return !targets[other].desc.transient || overlaps(targets[other].desc, target.desc);
+			});
+			if(shared){ continue; }
+
+			block.requirements.size = std::max(block.requirements.size, target.requirements.size);
+			block.requirements.alignment = std::max(block.requirements.alignment, target.requirements.alignment);
+			block.requirements.memoryTypeBits = type_bits;
+			block.targets.push_back(id);
+			return i;
+		}
+	}
+
+	Block block;
+	block.requirements = target.requirements;
+	block.properties = properties;
+	block.targets.push_back(id);
+	blocks.push_back(block);
+	return static_cast<u32>(blocks.size() - 1);
+}
+
+VkAttachmentDescription RenderTargets::describe(TargetId id, u32 pass, VkImageLayout final_layout) const {
+	const TargetDesc& desc = targets[id].desc;
+	if(pass < desc.first_pass || pass > desc.last_pass){
+		ERROR("RENDER TARGETS", "Target is not used in pass " << pass << ", only " << desc.first_pass << " to " << desc.last_pass << ".");
+		throw std::exception();
+	}
+	bool first = pass == desc.first_pass;
+	VkAttachmentLoadOp load = first ? VK_ATTACHMENT_LOAD_OP_CLEAR : VK_ATTACHMENT_LOAD_OP_LOAD;
+	VkAttachmentStoreOp store = desc.transient && pass == desc.last_pass ? VK_ATTACHMENT_STORE_OP_DONT_CARE : VK_ATTACHMENT_STORE_OP_STORE;
+	VkImageLayout layout = has_depth(desc.format) ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL : VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+	VkAttachmentDescription attachment = {};
+	attachment.format = desc.format;
+	attachment.samples = desc.samples;
+	attachment.loadOp = load;
+	attachment.storeOp = store;
+	attachment.stencilLoadOp = has_stencil(desc.format) ? load : VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+	attachment.stencilStoreOp = has_stencil(desc.format) ? store : VK_ATTACHMENT_STORE_OP_DONT_CARE;
+	attachment.initialLayout = first ? VK_IMAGE_LAYOUT_UNDEFINED : layout;
+	attachment.finalLayout = final_layout;
+	return attachment;
+}
+
+const RenderTargetStats& RenderTargets::poll_stats(){
+	stats.committed_bytes = 0;
+	for(const Block& block : blocks){
+		if(!(block.properties & VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT)){ continue; }
+		VkDeviceSize committed = 0;
+		vkGetDeviceMemoryCommitment(device.get_device(), block.memory, &committed);
+		stats.committed_bytes += committed;
+	}
+	return stats;
+}
+
+void RenderTargets::destroy(){
+	if(extent.width == 0){ return; }
+	VkDevice d = device.get_device();
+	vkDeviceWaitIdle(d);
+	for(Target& target : targets){
+		vkDestroyImageView(d, target.view, nullptr);
+		vkDestroyImage(d, target.image, nullptr);
+		target.view = VK_NULL_HANDLE;
+		target.image = VK_NULL_HANDLE;
+	}
+	for(Block& block : blocks){
+		if(block.memory != VK_NULL_HANDLE){ device.free_memory(block.memory); }
+	}
+	blocks.clear();
+	extent = {0, 0};
+}
+
+}	// namespace eng
+}	// namespace uni
@@ -0,0 +1,130 @@
+/**
+ * @file src/engine/render_targets.hpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#pragma once
+
+#include "engine/device.hpp"
+
+#include <vector>
+
+namespace uni {
+namespace eng {
+
+using TargetId = u32;
+
+struct TargetDesc {
+	VkFormat format = VK_FORMAT_UNDEFINED;
+	VkImageUsageFlags usage = 0;
+	VkSampleCountFlagBits samples = VK_SAMPLE_COUNT_1_BIT;
+	u32 first_pass = 0;         // first render pass of the frame that uses it
+	u32 last_pass = 0;          // and the last
+	bool transient = true;      // contents are not needed after `last_pass`
+};
+
+struct RenderTargetStats {
+	VkDeviceSize dedicated_bytes = 0;   // what one allocation per target would take
+	VkDeviceSize allocated_bytes = 0;
+	VkDeviceSize committed_bytes = 0;   // of lazily allocated memory, what the driver has backed
+	u32 lazy_targets = 0;
+	u32 memory_blocks = 0;
+};
+
+/**
+ * @brief Attachments for the frame's render passes, sized to the framebuffer
+ *
+ * Transient targets, such as depth and MSAA color that is resolved away,
+ * are created with TRANSIENT_ATTACHMENT usage and backed by
+ * LAZILY_ALLOCATED memory where the device has it, which tilers never
+ * commit. Their last pass does not store them.
+ *
+ * Transient targets whose passes do not overlap share memory. Each one
+ * starts with undefined contents, so passes that reuse memory need an
+ * external subpass dependency on the pass before them. Persistent targets
+ * get memory of their own.
+ */
+class RenderTargets {
+public:
+	RenderTargets(const RenderTargets&) = delete;
+	RenderTargets& operator=(const RenderTargets&) = delete;
+
+	RenderTargets(Device& device);
+	~RenderTargets();
+
+	/**
+	 * @brief Declares a target, images are created by `build`
+	 * @param[in] desc Transient targets may only have attachment usage
+	 * @return Its id
+	 */
+	TargetId add(const TargetDesc& desc);
+
+	/**
+	 * @brief (Re)creates every target, e.g. after a resize
+	 * @param[in] width
+	 * @param[in] height
+	 * @return void
+	 */
+	void build(u32 width, u32 height);
+
+	/**
+	 * @brief How one of a target's passes should use it as an attachment
+	 *
+	 * The first pass clears it from an undefined layout, later passes load
+	 * it from its attachment layout, which passes before them must leave it
+	 * in. A transient target is not stored by its last pass.
+	 *
+	 * @param[in] id
+	 * @param[in] pass Between the target's first and last pass
+	 * @param[in] final_layout
+	 * @return The attachment
+	 */
+	VkAttachmentDescription describe(TargetId id, u32 pass, VkImageLayout final_layout) const;
+
+	/**
+	 * @brief Reads how much lazily allocated memory the driver has committed
+	 * @return The stats
+	 */
+	const RenderTargetStats& poll_stats();
+
+	VkImage get_image(TargetId id) const { return targets[id].image; }
+	VkImageView get_view(TargetId id) const { return targets[id].view; }
+	VkFormat get_format(TargetId id) const { return targets[id].desc.format; }
+	VkExtent2D get_extent() const { return extent; }
+	const RenderTargetStats& get_stats() const { return stats; }
+
+private:
+	struct Target {
+		TargetDesc desc;
+		VkImage image = VK_NULL_HANDLE;
+		VkImageView view = VK_NULL_HANDLE;
+		VkMemoryRequirements requirements = {};
+		bool lazy = false;
+		u32 block = 0;
+	};
+
+	struct Block {
+		VkDeviceMemory memory = VK_NULL_HANDLE;
+		VkMemoryRequirements requirements = {};
+		VkMemoryPropertyFlags properties = 0;
+		std::vector<TargetId> targets;
+	};
+
+	/**
+	 * @brief Finds a block the target can share, or adds one
+	 * @return Index into `blocks`
+	 */
+	u32 place(TargetId id);
+
+	void destroy();
+
+	Device& device;
+	VkExtent2D extent = {0, 0};
+	std::vector<Target> targets;
+	std::vector<Block> blocks;
+	RenderTargetStats stats;
+};
+
+}	// namespace eng
+}	// namespace uni
@@ -0,0 +1,33 @@
+#version 450
+
+layout(location = 0) flat in uint frag_block;
+layout(location = 1) flat in uint frag_face;
+
+layout(location = 0) out vec4 out_color;
+
+// By block id, see world/block.hpp
+const vec4 COLORS[15] = {
+	vec4(0.0),
+	vec4(0.50, 0.50, 0.50, 1.0),
+	vec4(0.45, 0.32, 0.20, 1.0),
+	vec4(0.35, 0.60, 0.25, 1.0),
+	vec4(0.86, 0.80, 0.55, 1.0),
+	vec4(0.20, 0.35, 0.80, 0.6),
+	vec4(0.40, 0.28, 0.15, 1.0),
+	vec4(0.20, 0.50, 0.15, 0.9),
+	vec4(0.20, 0.35, 0.80, 0.6),
+	vec4(0.20, 0.35, 0.80, 0.6),
+	vec4(0.20, 0.35, 0.80, 0.6),
+	vec4(0.20, 0.35, 0.80, 0.6),
+	vec4(0.20, 0.35, 0.80, 0.6),
+	vec4(0.20, 0.35, 0.80, 0.6),
+	vec4(0.20, 0.35, 0.80, 0.6)
+};
+
+// Fixed light per face, -x, +x, -y, +y, -z, +z
+const float SHADE[6] = {0.8, 0.8, 0.5, 1.0, 0.65, 0.65};
+
+void main(){
+	vec4 color = COLORS[min(frag_block, 14u)];
+	out_color = vec4(color.rgb * SHADE[frag_face], color.a);
+}
@@ -0,0 +1,49 @@
+#version 450
+
+// Same layout as the meshing pass writes
+struct Draw {
+	uint vertex_count;
+	uint instance_count;
+	uint first_vertex;
+	uint first_instance;
+	ivec3 origin;
+	uint pad;
+};
+
+layout(std430, set = 0, binding = 0) readonly buffer Quads {
+	uint quads[];
+};
+
+layout(std430, set = 0, binding = 1) readonly buffer Draws {
+	Draw draws[];
+};
+
+layout(push_constant) uniform Push {
+	mat4 view_proj;
+};
+
+layout(location = 0) flat out uint frag_block;
+layout(location = 1) flat out uint frag_face;
+
+// Two triangles per quad, counter clockwise seen from outside the block
+const uint POSITIVE[6] = {0u, 1u, 3u, 0u, 3u, 2u};
+const uint NEGATIVE[6] = {0u, 3u, 1u, 0u, 2u, 3u};
+
+void main(){
+	// gl_VertexIndex includes first_vertex, six vertices per quad
+	uint quad = quads[gl_VertexIndex / 6];
+	uint face = (quad >> 12u) & 7u;
+	uint axis = face >> 1u;
+	uint side = face & 1u;
+	uint corner = side == 1u ? POSITIVE[gl_VertexIndex % 6] : NEGATIVE[gl_VertexIndex % 6];
+
+	vec3 p = vec3(quad & 15u, (quad >> 4u) & 15u, (quad >> 8u) & 15u);
+	vec3 offset;
+	offset[axis] = float(side);
+	offset[(axis + 1u) % 3u] = float(corner & 1u);
+	offset[(axis + 2u) % 3u] = float(corner >> 1u);
+
+	gl_Position = view_proj * vec4(vec3(draws[gl_InstanceIndex].origin) + p + offset, 1.0);
+	frag_block = quad >> 16u;
+	frag_face = face;
+}
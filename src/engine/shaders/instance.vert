@@ -0,0 +1,41 @@
+#version 450
+
+struct Instance {
+	vec3 position;
+	float yaw;
+	float scale;
+	float anim_time;
+	uint anim_state;
+	uint type;
+};
+
+layout(location = 0) in vec3 in_position;
+layout(location = 1) in vec4 in_color;
+
+// Culled instances, grouped by mesh type
+layout(std430, set = 0, binding = 0) readonly buffer Visible {
+	Instance visible[];
+};
+
+layout(push_constant) uniform Push {
+	mat4 view_proj;
+	uint base;
+};
+
+layout(location = 0) out vec4 frag_color;
+
+void main(){
+	Instance instance = visible[base + gl_InstanceIndex];
+
+	vec3 p = in_position * instance.scale;
+	float c = cos(instance.yaw), s = sin(instance.yaw);
+	p = vec3(c * p.x + s * p.z, p.y, -s * p.x + c * p.z);
+
+	// Anything not idle bobs while it moves
+	if(instance.anim_state != 0){
+		p.y += 0.0625 * abs(sin(instance.anim_time * 8.0));
+	}
+
+	gl_Position = view_proj * vec4(p + instance.position, 1.0);
+	frag_color = in_color;
+}
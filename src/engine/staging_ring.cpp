@@ -0,0 +1,79 @@
+/**
+ * @file src/engine/staging_ring.cpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#include "engine/staging_ring.hpp"
+
+#include "util/util.hpp"
+
+namespace uni {
+namespace eng {
+
+StagingRing::StagingRing(Device& device, VkDeviceSize capacity, u32 frames_in_flight)
+	: device{device}, capacity{capacity}, frames_in_flight{frames_in_flight} {
+	device.create_buffer(
+		capacity,
+		VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+		VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+		buffer,
+		memory
+	);
+
+	void* data;
+	if(vkMapMemory(device.get_device(), memory, 0, capacity, 0, &data) != VK_SUCCESS){
+		VK_ERROR("Failed to map staging ring.");
+		vkDestroyBuffer(device.get_device(), buffer, nullptr);
+		device.free_memory(memory);
+		throw std::exception();
+	}
+	mapped = static_cast<u8*>(data);
+	VK_INFO("Created Staging Ring (" << capacity << " bytes).");
+}
+
+StagingRing::~StagingRing(){
+	vkUnmapMemory(device.get_device(), memory);
+	vkDestroyBuffer(device.get_device(), buffer, nullptr);
+	device.free_memory(memory);
+	VK_INFO("Destroyed Staging Ring.");
+}
+
+void StagingRing::begin_frame(u64 frame){
+	if(frame_ends.empty() || frame_ends.back().second != head){
+		frame_ends.emplace_back(current_frame, head);
+	}
+	current_frame = frame;
+
+	while(!frame_ends.empty() && frame_ends.front().first + frames_in_flight <= frame){
+		tail = frame_ends.front().second;
+		frame_ends.pop_front();
+	}
+}
+
+std::optional<VkDeviceSize> StagingRing::allocate(VkDeviceSize size, VkDeviceSize alignment){
+	VkDeviceSize offset = (head + alignment - 1) & ~(alignment - 1);
+
+	/*
+	 * Never let head catch up with tail while data is in use, head == tail
+	 * is reserved for an empty ring.
+	 */
+	if(head == tail){
+		if(size >= capacity){ return std::nullopt; }
+		if(offset + size > capacity){ offset = 0; }
+		tail = head = offset;
+	} else if(head > tail){
+		if(offset + size > capacity){
+			if(size >= tail){ return std::nullopt; }
+			offset = 0;
+		}
+	} else if(offset + size >= tail){
+		return std::nullopt;
+	}
+
+	head = offset + size;
+	return offset;
+}
+
+}	// namespace eng
+}	// namespace uni
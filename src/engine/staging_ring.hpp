@@ -0,0 +1,68 @@
+/**
+ * @file src/engine/staging_ring.hpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#pragma once
+
+#include "engine/device.hpp"
+
+#include <deque>
+#include <optional>
+
+namespace uni {
+namespace eng {
+
+/**
+ * @brief Persistently mapped host visible ring used as the source of uploads
+ *
+ * Space written during frame N is handed back at the start of frame
+ * N + frames_in_flight, by which point the copies reading it must have
+ * completed. The caller is expected to have waited on that frame's fence.
+ */
+class StagingRing {
+public:
+	StagingRing(const StagingRing&) = delete;
+	StagingRing& operator=(const StagingRing&) = delete;
+
+	StagingRing(Device& device, VkDeviceSize capacity, u32 frames_in_flight = 2);
+
+	~StagingRing();
+
+	/**
+	 * @brief Releases space written by frames that are no longer in flight
+	 * @param[in] frame Index of the frame about to be recorded
+	 * @return void
+	 */
+	void begin_frame(u64 frame);
+
+	/**
+	 * @brief Reserves space in the ring for this frame
+	 * @param[in] size Bytes to reserve
+	 * @param[in] alignment Alignment of the returned offset, power of two
+	 * @return Offset into the ring or nothing if the ring is full
+	 */
+	std::optional<VkDeviceSize> allocate(VkDeviceSize size, VkDeviceSize alignment = 16);
+
+	u8* data(VkDeviceSize offset) { return mapped + offset; }
+	VkBuffer get_buffer() const { return buffer; }
+	VkDeviceSize get_capacity() const { return capacity; }
+
+private:
+	Device& device;
+	VkBuffer buffer;
+	VkDeviceMemory memory;
+	u8* mapped;
+	VkDeviceSize capacity;
+	u32 frames_in_flight;
+
+	// Bytes in use are [tail, head), wrapping. head == tail means empty.
+	VkDeviceSize head = 0;
+	VkDeviceSize tail = 0;
+	u64 current_frame = 0;
+	std::deque<std::pair<u64, VkDeviceSize>> frame_ends;
+};
+
+}	// namespace eng
+}	// namespace uni
@@ -10,26 +10,106 @@
 namespace uni {
 namespace eng {
 
-Window::Window(int width, int height, const std::string& name) : width{width}, height{height}, name{name} {
-	initialize();
+Window::Window(int width, int height, const std::string& name, WindowMode mode)
+	: extent{(u64(static_cast<u32>(width)) << 32) | static_cast<u32>(height)}, name{name}, mode{mode} {
+	if(mode == WindowMode::WINDOWED){
+		initialize();
+	}
 }
 
 Window::~Window(){
-	glfwDestroyWindow(window);
-	glfwTerminate();
+	if(window){
+		glfwDestroyWindow(window);
+		glfwTerminate();
+	}
 }
 
 void Window::create_surface(VkInstance instance, VkSurfaceKHR* surface){
+	if(window == nullptr){
+		VK_ERROR("Headless window has no surface.");
+		throw std::exception();
+	}
 	if(glfwCreateWindowSurface(instance, window, nullptr, surface) != VK_SUCCESS){
 		VK_ERROR("Failed to create VkSurfaceKHR.");
 	}
 	VK_INFO("Created VkSurfaceKHR.");
 }
 
+void Window::run_input(const std::atomic<bool>& running, f64 rate){
+	while(running.load(std::memory_order_acquire) && !should_close()){
+		if(window){
+			// Wakes as soon as an event arrives, the timeout bounds the rate otherwise
+			glfwWaitEventsTimeout(1.0 / rate);
+		} else {
+			Clock& clock = Clock::steady();
+			clock.sleep_until(clock.now() + static_cast<u64>(1e9 / rate));
+		}
+	}
+}
+
+void Window::poll_events(){
+	if(window){ glfwPollEvents(); }
+}
+
+void Window::inject(const InputEvent& event){
+	switch(event.type){
+	case InputEvent::CURSOR:
+		cursor_sequence.fetch_add(1, std::memory_order_acq_rel);
+		cursor_x.store(event.x, std::memory_order_relaxed);
+		cursor_y.store(event.y, std::memory_order_relaxed);
+		cursor_time.store(event.time, std::memory_order_relaxed);
+		cursor_sequence.fetch_add(1, std::memory_order_release);
+		break;
+	case InputEvent::RESIZE:
+		extent.store((u64(static_cast<u32>(event.code)) << 32) | static_cast<u32>(event.action), std::memory_order_release);
+		break;
+	case InputEvent::CLOSE:
+		close_requested.store(true, std::memory_order_release);
+		break;
+	default:
+		break;
+	}
+	if(!events.push(event)){ dropped.fetch_add(1, std::memory_order_relaxed); }
+}
+
+CursorSample Window::latch_cursor() const {
+	CursorSample sample;
+	for(;;){
+		u32 before = cursor_sequence.load(std::memory_order_acquire);
+		if(before & 1){ continue; }
+		sample.x = cursor_x.load(std::memory_order_relaxed);
+		sample.y = cursor_y.load(std::memory_order_relaxed);
+		sample.time = cursor_time.load(std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if(cursor_sequence.load(std::memory_order_relaxed) == before){ return sample; }
+	}
+}
+
+static Window& owner(GLFWwindow* window){
+	return *static_cast<Window*>(glfwGetWindowUserPointer(window));
+}
+
 void Window::resize_callback(GLFWwindow* window, int width, int height){
-	(void)window;
-	(void)width;
-	(void)height;
+	owner(window).inject({InputEvent::RESIZE, width, height, 0.0, 0.0, Clock::steady().now()});
+}
+
+void Window::key_callback(GLFWwindow* window, int key, int scancode, int action, int mods){
+	(void)scancode;
+	(void)mods;
+	owner(window).inject({InputEvent::KEY, key, action, 0.0, 0.0, Clock::steady().now()});
+}
+
+void Window::mouse_button_callback(GLFWwindow* window, int button, int action, int mods){
+	(void)mods;
+	owner(window).inject({InputEvent::MOUSE_BUTTON, button, action, 0.0, 0.0, Clock::steady().now()});
+}
+
+void Window::cursor_callback(GLFWwindow* window, double x, double y){
+	owner(window).inject({InputEvent::CURSOR, 0, 0, x, y, Clock::steady().now()});
+}
+
+void Window::close_callback(GLFWwindow* window){
+	owner(window).inject({InputEvent::CLOSE, 0, 0, 0.0, 0.0, Clock::steady().now()});
 }
 	
 void Window::initialize(){
@@ -39,13 +119,18 @@ void Window::initialize(){
    	glfwWindowHint(GLFW_RESIZABLE, GLFW_FALSE);
 
    	// Create GLFW window
-   	window = glfwCreateWindow(width, height, name.c_str(), nullptr, nullptr);
+   	window = glfwCreateWindow(get_width(), get_height(), name.c_str(), nullptr, nullptr);
    	glfwSetWindowUserPointer(window, this);
     
    	// Set function to call on any window resize event
    	glfwSetFramebufferSizeCallback(window, resize_callback);
+
+	// Input, all called from inside glfwPollEvents / glfwWaitEventsTimeout
+	glfwSetKeyCallback(window, key_callback);
+	glfwSetMouseButtonCallback(window, mouse_button_callback);
+	glfwSetCursorPosCallback(window, cursor_callback);
+	glfwSetWindowCloseCallback(window, close_callback);
 }
 
 }	// namespace eng
 }	// namespace uni
-
@@ -9,16 +9,55 @@
 #define GLFW_INCLUDE_VULKAN
 #include <GLFW/glfw3.h>
 
+#include "util/clock.hpp"
+#include "util/spsc_queue.hpp"
+
+#include <atomic>
 #include <string>
 
 namespace uni {
 namespace eng {
 
+enum class WindowMode {
+	WINDOWED,
+	HEADLESS,   // no GLFW, input only arrives through `inject`
+};
+
+struct InputEvent {
+	enum Type : u8 {
+		KEY,
+		MOUSE_BUTTON,
+		CURSOR,
+		RESIZE,
+		CLOSE,
+	};
+
+	Type type;
+	s32 code = 0;       // key or button, width for RESIZE
+	s32 action = 0;     // GLFW_PRESS, GLFW_RELEASE or GLFW_REPEAT, height for RESIZE
+	f64 x = 0.0, y = 0.0;
+	u64 time = 0;       // when it was sampled, `Clock` nanoseconds
+};
+
+/**
+ * @brief Newest cursor position and when it was sampled
+ */
+struct CursorSample {
+	f64 x = 0.0, y = 0.0;
+	u64 time = 0;
+};
+
 /**
  * @brief Creates a window to render onto
  *
  * Class creates a GLFW window and surface we can render onto.
- * 
+ *
+ * Input is decoupled from rendering. GLFW only allows events to be
+ * polled on the thread that created the window, so that thread runs
+ * `run_input` at a high rate and the render loop lives on another
+ * thread. Events go through a lock free queue the render thread drains
+ * with `next_event`, and the cursor is also kept as a single sample the
+ * render thread can latch right before submitting a frame.
  */
 class Window {
 public:
@@ -26,22 +65,90 @@ public:
 	Window(const Window&) = delete;
 	Window& operator=(const Window&) = delete;
 	
-	Window(int width, int height, const std::string& name);
+	Window(int width, int height, const std::string& name, WindowMode mode = WindowMode::WINDOWED);
 
 	~Window();
 
 	void create_surface(VkInstance instance, VkSurfaceKHR* surface);
 
+	/**
+	 * @brief Polls input until `running` goes false
+	 *
+	 * Must be called on the thread that created the window.
+	 *
+	 * @param[in] running
+	 * @param[in] rate Polls per second
+	 * @return void
+	 */
+	void run_input(const std::atomic<bool>& running, f64 rate = 1000.0);
+
+	/**
+	 * @brief Polls input once, for single threaded use
+	 * @return void
+	 */
+	void poll_events();
+
+	/**
+	 * @brief Takes the oldest queued event, render thread side
+	 * @return False when there are none
+	 */
+	bool next_event(InputEvent& event){ return events.pop(event); }
+
+	/**
+	 * @brief Queues an event as if it came from GLFW
+	 *
+	 * The only input source in headless mode, used for simulated input and
+	 * replays. Must come from the input thread.
+	 *
+	 * @return void
+	 */
+	void inject(const InputEvent& event);
+
+	/**
+	 * @brief Newest cursor sample, safe from any thread
+	 */
+	CursorSample latch_cursor() const;
+
+	bool should_close() const { return close_requested.load(std::memory_order_acquire); }
+	bool is_headless() const { return mode == WindowMode::HEADLESS; }
+	int get_width() const { return static_cast<int>(extent.load(std::memory_order_acquire) >> 32); }
+	int get_height() const { return static_cast<int>(static_cast<u32>(extent.load(std::memory_order_acquire))); }
+
+	/**
+	 * @brief Width and height from the same resize, safe from any thread
+	 */
+	VkExtent2D get_extent() const {
+		u64 packed = extent.load(std::memory_order_acquire);
+		return {static_cast<u32>(packed >> 32), static_cast<u32>(packed)};
+	}
+
+	// Events dropped because the render thread fell behind
+	u64 get_dropped_events() const { return dropped.load(std::memory_order_relaxed); }
+
 private:
 	static void resize_callback(GLFWwindow* window, int width, int height);
+	static void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods);
+	static void mouse_button_callback(GLFWwindow* window, int button, int action, int mods);
+	static void cursor_callback(GLFWwindow* window, double x, double y);
+	static void close_callback(GLFWwindow* window);
 
 	void initialize();
 
-	int width, height;
+	// Width in the high half and height in the low half, the input thread resizes it
+	std::atomic<u64> extent;
 	std::string name;
-	GLFWwindow* window;
+	WindowMode mode;
+	GLFWwindow* window = nullptr;
+
+	SpscQueue<InputEvent, 1024> events;
+	std::atomic<u64> dropped{0};
+	std::atomic<bool> close_requested{false};
+
+	// Seqlock, odd while the input thread is writing
+	std::atomic<u32> cursor_sequence{0};
+	std::atomic<f64> cursor_x{0.0}, cursor_y{0.0};
+	std::atomic<u64> cursor_time{0};
 };
 
 }	// namespace eng
 }	// namespace uni
-
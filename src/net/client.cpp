@@ -0,0 +1,87 @@
+/**
+ * @file src/net/client.cpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#include "net/client.hpp"
+
+#include "util/util.hpp"
+
+namespace uni {
+namespace net {
+
+Client::Client(const std::string& host, u16 port) : socket{Socket::connect(host, port)} {}
+
+void Client::send_position(f32 x, f32 z, u8 view_distance){
+	if(closed){ return; }
+	ByteWriter out(unsent);
+	size_t start = out.begin(Message::POSITION);
+	out.put_f32(x);
+	out.put_f32(z);
+	out.put_u8(view_distance);
+	out.end(start);
+	flush();
+}
+
+void Client::flush(){
+	if(unsent.empty()){ return; }
+	ssize_t sent = socket.send(unsent.data(), unsent.size());
+	if(sent < 0){
+		closed = true;
+		return;
+	}
+	unsent.erase(unsent.begin(), unsent.begin() + sent);
+}
+
+bool Client::poll(){
+	if(closed){ return false; }
+	flush();
+
+	u8 buffer[1 << 16];
+	for(;;){
+		ssize_t n = socket.receive(buffer, sizeof(buffer));
+		if(n < 0){ closed = true; break; }
+		if(n == 0){ break; }
+		received.insert(received.end(), buffer, buffer + n);
+		bytes_received += n;
+	}
+
+	size_t offset = 0;
+	while(received.size() - offset >= FRAME_HEADER){
+		u32 size;
+		std::memcpy(&size, received.data() + offset, sizeof(size));
+		if(received.size() - offset - FRAME_HEADER < size){ break; }
+
+		Message type = static_cast<Message>(received[offset + 4]);
+		ByteReader in(received.data() + offset + FRAME_HEADER, size);
+		offset += FRAME_HEADER + size;
+		messages_received++;
+		if(!handle(type, in)){
+			WARNING("CLIENT", "Malformed message " << static_cast<u32>(type) << " from server.");
+		}
+	}
+	received.erase(received.begin(), received.begin() + offset);
+	return !closed;
+}
+
+bool Client::handle(Message type, ByteReader& in){
+	switch(type){
+	case Message::CHUNK:
+		return decode_chunk(in, store);
+	case Message::UNLOAD: {
+		world::ChunkPos pos;
+		pos.x = in.get_s32();
+		pos.z = in.get_s32();
+		store.remove(pos);
+		return !in.failed;
+	}
+	case Message::BLOCK_DELTA:
+		return apply_delta(in, store);
+	default:
+		return false;
+	}
+}
+
+}	// namespace net
+}	// namespace uni
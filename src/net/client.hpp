@@ -0,0 +1,74 @@
+/**
+ * @file src/net/client.hpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#pragma once
+
+#include "net/protocol.hpp"
+#include "net/socket.hpp"
+
+#include <string>
+
+namespace uni {
+namespace net {
+
+/**
+ * @brief Receiving end of `Server`, keeps a copy of the chunks in view
+ *
+ * Has no window or device either, the same class backs the game client
+ * and the loopback test harness.
+ */
+class Client {
+public:
+	Client(const Client&) = delete;
+	Client& operator=(const Client&) = delete;
+
+	/**
+	 * @brief Connects, blocking until the connection is made
+	 */
+	Client(const std::string& host, u16 port);
+
+	/**
+	 * @brief Tells the server where the player is
+	 *
+	 * Whatever the socket does not take is sent by later calls and `poll`.
+	 *
+	 * @param[in] x World x
+	 * @param[in] z World z
+	 * @param[in] view_distance In chunks
+	 * @return void
+	 */
+	void send_position(f32 x, f32 z, u8 view_distance);
+
+	/**
+	 * @brief Applies every complete message received so far, never blocks
+	 * @return False once the connection is closed
+	 */
+	bool poll();
+
+	world::ChunkStore& get_store(){ return store; }
+	u64 get_bytes_received() const { return bytes_received; }
+	u64 get_messages_received() const { return messages_received; }
+
+private:
+	bool handle(Message type, ByteReader& in);
+
+	/**
+	 * @brief Sends what earlier sends left over, in order
+	 * @return void
+	 */
+	void flush();
+
+	Socket socket;
+	world::ChunkStore store;
+	std::vector<u8> received;
+	std::vector<u8> unsent;     // frames or the tail of one the socket did not take
+	u64 bytes_received = 0;
+	u64 messages_received = 0;
+	bool closed = false;
+};
+
+}	// namespace net
+}	// namespace uni
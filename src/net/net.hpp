@@ -0,0 +1,10 @@
+/**
+ * @file src/net/net.hpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#include "net/protocol.hpp"
+#include "net/socket.hpp"
+#include "net/server.hpp"
+#include "net/client.hpp"
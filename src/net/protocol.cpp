@@ -0,0 +1,138 @@
+/**
+ * @file src/net/protocol.cpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#include "net/protocol.hpp"
+
+#include "world/palette.hpp"
+
+#include <algorithm>
+
+namespace uni {
+namespace net {
+
+Frame encode_chunk(const world::Chunk& chunk){
+	auto frame = std::make_shared<std::vector<u8>>();
+	frame->reserve(4096);
+	ByteWriter out(*frame);
+
+	size_t start = out.begin(Message::CHUNK);
+	out.put_s32(chunk.get_pos().x);
+	out.put_s32(chunk.get_pos().z);
+
+	u16 mask = 0;
+	for(s32 i = 0; i < world::CHUNK_SECTIONS; i++){
+		const world::Section* section = chunk.get_section(i);
+		if(section && !section->empty()){ mask |= 1 << i; }
+	}
+	out.put_u16(mask);
+
+	world::PalettedSection paletted;
+	for(s32 i = 0; i < world::CHUNK_SECTIONS; i++){
+		if(!(mask & (1 << i))){ continue; }
+		world::encode_section(*chunk.get_section(i), paletted);
+		out.put_varint(static_cast<u32>(paletted.palette.size()));
+		for(world::BlockId block : paletted.palette){ out.put_varint(block); }
+		out.put_u8(paletted.bits);
+		out.put_bytes(paletted.words.data(), paletted.words.size() * sizeof(u64));
+	}
+	out.end(start);
+	return frame;
+}
+
+bool decode_chunk(ByteReader& in, world::ChunkStore& store){
+	world::ChunkPos pos;
+	pos.x = in.get_s32();
+	pos.z = in.get_s32();
+	u16 mask = in.get_u16();
+	if(in.failed){ return false; }
+
+	// Decoded aside, a malformed payload must not replace the chunk the client has
+	world::Chunk chunk(pos);
+	world::PalettedSection paletted;
+	for(s32 i = 0; i < world::CHUNK_SECTIONS; i++){
+		if(!(mask & (1 << i))){ continue; }
+
+		u32 palette_size = in.get_varint();
+		if(palette_size == 0 || palette_size > world::SECTION_VOLUME){ return false; }
+		paletted.palette.resize(palette_size);
+		for(auto& block : paletted.palette){
+			u32 id = in.get_varint();
+			if(id >= world::BLOCK_COUNT){ return false; }
+			block = static_cast<world::BlockId>(id);
+		}
+		paletted.bits = in.get_u8();
+		if(paletted.bits != world::palette_bits(palette_size)){ return false; }
+		paletted.words.resize(world::palette_words(paletted.bits));
+		in.get_bytes(paletted.words.data(), paletted.words.size() * sizeof(u64));
+		if(in.failed){ return false; }
+
+		world::decode_section(paletted, chunk.make_section(i));
+	}
+	if(!in.done()){ return false; }
+
+	world::Chunk& target = store.create(pos);
+	for(s32 i = 0; i < world::CHUNK_SECTIONS; i++){
+		if(chunk.get_section(i) != nullptr){ target.make_section(i) = *chunk.get_section(i); }
+	}
+	return true;
+}
+
+Frame encode_delta(world::ChunkPos pos, std::vector<BlockChange>& changes){
+	// Stable so the last change to a block stays last among its equals
+	std::stable_sort(changes.begin(), changes.end(), [](const BlockChange& a, const BlockChange& b){
+		return world::block_index(a.x & 15, a.y, a.z & 15) < world::block_index(b.x & 15, b.y, b.z & 15);
+	});
+
+	size_t unique = 0;
+	for(size_t i = 0; i < changes.size(); i++){
+		bool last = i + 1 == changes.size() || changes[i + 1].x != changes[i].x || changes[i + 1].y != changes[i].y || changes[i + 1].z != changes[i].z;
+		if(last){ changes[unique++] = changes[i]; }
+	}
+	changes.resize(unique);
+
+	auto frame = std::make_shared<std::vector<u8>>();
+	frame->reserve(FRAME_HEADER + 12 + changes.size() * 4);
+	ByteWriter out(*frame);
+
+	size_t start = out.begin(Message::BLOCK_DELTA);
+	out.put_s32(pos.x);
+	out.put_s32(pos.z);
+	out.put_varint(static_cast<u32>(changes.size()));
+	for(const auto& change : changes){
+		out.put_u8(static_cast<u8>((change.z & 15) << 4 | (change.x & 15)));
+		out.put_u8(static_cast<u8>(change.y));
+		out.put_varint(change.block);
+	}
+	out.end(start);
+	return frame;
+}
+
+bool apply_delta(ByteReader& in, world::ChunkStore& store){
+	world::ChunkPos pos;
+	pos.x = in.get_s32();
+	pos.z = in.get_s32();
+	u32 count = in.get_varint();
+	if(in.failed){ return false; }
+
+	// Decoded aside so a payload rejected halfway leaves the chunk untouched
+	std::vector<BlockChange> changes;
+	for(u32 i = 0; i < count; i++){
+		u8 xz = in.get_u8();
+		u8 y = in.get_u8();
+		u32 block = in.get_varint();
+		if(in.failed || block >= world::BLOCK_COUNT){ return false; }
+		changes.push_back({xz & 15, y, xz >> 4, static_cast<world::BlockId>(block)});
+	}
+	if(!in.done()){ return false; }
+
+	world::Chunk* chunk = store.get_chunk(pos);
+	if(chunk == nullptr){ return true; }
+	for(const BlockChange& change : changes){ chunk->set(change.x, change.y, change.z, change.block); }
+	return true;
+}
+
+}	// namespace net
+}	// namespace uni
@@ -0,0 +1,174 @@
+/**
+ * @file src/net/protocol.hpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#pragma once
+
+#include "world/chunk.hpp"
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace uni {
+namespace net {
+
+/*
+ * Every message is a frame: u32 payload size, u8 type, payload. All
+ * values are little endian, which every platform we ship on is.
+ */
+constexpr size_t FRAME_HEADER = 5;
+
+enum class Message : u8 {
+	CHUNK = 1,          // s32 cx, s32 cz, u16 section mask, paletted sections
+	UNLOAD = 2,         // s32 cx, s32 cz
+	BLOCK_DELTA = 3,    // s32 cx, s32 cz, varint count, (u8 xz, u8 y, varint block) sorted
+	POSITION = 16,      // client to server: f32 x, f32 z, u8 view distance
+};
+
+// Largest payload a client sends, the server drops anyone sending more
+constexpr u32 POSITION_BYTES = 9;
+constexpr u32 MAX_CLIENT_PAYLOAD = POSITION_BYTES;
+
+/**
+ * @brief Encoded frame shared by every connection that sends it
+ *
+ * Frames are immutable once built, a chunk sent to 50 clients is
+ * encoded once and queued 50 times.
+ */
+using Frame = std::shared_ptr<const std::vector<u8>>;
+
+/**
+ * @brief Change of one block, world coordinates
+ */
+struct BlockChange {
+	s32 x, y, z;
+	world::BlockId block;
+};
+
+class ByteWriter {
+public:
+	ByteWriter(std::vector<u8>& out) : out{out} {}
+
+	void put_u8(u8 v){ out.push_back(v); }
+	void put_u16(u16 v){ put_bytes(&v, sizeof(v)); }
+	void put_u32(u32 v){ put_bytes(&v, sizeof(v)); }
+	void put_s32(s32 v){ put_bytes(&v, sizeof(v)); }
+	void put_f32(f32 v){ put_bytes(&v, sizeof(v)); }
+	void put_u64(u64 v){ put_bytes(&v, sizeof(v)); }
+
+	void put_varint(u32 v){
+		while(v >= 0x80){
+			out.push_back(static_cast<u8>(v | 0x80));
+			v >>= 7;
+		}
+		out.push_back(static_cast<u8>(v));
+	}
+
+	void put_bytes(const void* data, size_t size){
+		const u8* p = static_cast<const u8*>(data);
+		out.insert(out.end(), p, p + size);
+	}
+
+	/**
+	 * @brief Starts a frame, the size is filled in by `end`
+	 * @return Offset of the frame to pass to `end`
+	 */
+	size_t begin(Message type){
+		size_t start = out.size();
+		put_u32(0);
+		put_u8(static_cast<u8>(type));
+		return start;
+	}
+
+	void end(size_t start){
+		u32 size = static_cast<u32>(out.size() - start - FRAME_HEADER);
+		std::memcpy(out.data() + start, &size, sizeof(size));
+	}
+
+private:
+	std::vector<u8>& out;
+};
+
+/**
+ * @brief Reads a payload, reads past the end return zero and set `failed`
+ */
+class ByteReader {
+public:
+	ByteReader(const u8* data, size_t size) : data{data}, size{size} {}
+
+	u8 get_u8(){ u8 v = 0; get_bytes(&v, sizeof(v)); return v; }
+	u16 get_u16(){ u16 v = 0; get_bytes(&v, sizeof(v)); return v; }
+	u32 get_u32(){ u32 v = 0; get_bytes(&v, sizeof(v)); return v; }
+	s32 get_s32(){ s32 v = 0; get_bytes(&v, sizeof(v)); return v; }
+	f32 get_f32(){ f32 v = 0.0f; get_bytes(&v, sizeof(v)); return v; }
+	u64 get_u64(){ u64 v = 0; get_bytes(&v, sizeof(v)); return v; }
+
+	u32 get_varint(){
+		u32 v = 0;
+		for(u32 shift = 0; shift < 35; shift += 7){
+			u8 b = get_u8();
+			v |= u32(b & 0x7f) << shift;
+			if(!(b & 0x80)){ return v; }
+		}
+		failed = true;
+		return 0;
+	}
+
+	void get_bytes(void* out, size_t n){
+		// Empty reads may come with a null `out`, which memcpy must not see
+		if(n == 0){ return; }
+		if(offset + n > size){
+			failed = true;
+			offset = size;
+			return;
+		}
+		std::memcpy(out, data + offset, n);
+		offset += n;
+	}
+
+	bool done() const { return offset == size; }
+
+	bool failed = false;
+
+private:
+	const u8* data;
+	size_t size;
+	size_t offset = 0;
+};
+
+/**
+ * @brief Encodes a chunk message, non air sections as paletted sections
+ * @param[in] chunk
+ * @return The frame
+ */
+Frame encode_chunk(const world::Chunk& chunk);
+
+/**
+ * @brief Replaces a chunk in `store` with the one in a chunk payload
+ * @return False on a malformed payload, `store` is then left as it was
+ */
+bool decode_chunk(ByteReader& in, world::ChunkStore& store);
+
+/**
+ * @brief Encodes every change to one chunk during a tick
+ *
+ * Later changes to the same block win, so a block toggled many times
+ * in one tick costs one entry.
+ *
+ * @param[in] pos
+ * @param[in,out] changes Changes inside `pos`, sorted in place
+ * @return The frame
+ */
+Frame encode_delta(world::ChunkPos pos, std::vector<BlockChange>& changes);
+
+/**
+ * @brief Applies a block delta payload to `store`
+ * @return False on a malformed payload
+ */
+bool apply_delta(ByteReader& in, world::ChunkStore& store);
+
+}	// namespace net
+}	// namespace uni
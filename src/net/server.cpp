@@ -0,0 +1,253 @@
+/**
+ * @file src/net/server.cpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#include "net/server.hpp"
+
+#include "util/util.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace uni {
+namespace net {
+
+namespace {
+
+// Cached chunk frames nobody asked for in this many ticks are dropped
+constexpr u64 CACHE_TICKS = 256;
+
+// Most buffers handed to one gathered send
+constexpr int MAX_GATHER = 64;
+
+}	// namespace
+
+Server::Server(world::ChunkStore& store, const world::Generator& generator, const ServerConfig& config)
+	: store{store}, generator{generator}, config{config}, listener{Socket::listen(config.port)} {
+	INFO("SERVER", "Listening on port " << listener.get_port() << ".");
+}
+
+bool Server::set_block(s32 x, s32 y, s32 z, world::BlockId block){
+	if(y < 0 || y >= world::CHUNK_HEIGHT){ return false; }
+	if(!store.set_block(x, y, z, block)){ return false; }
+	changes[{x >> 4, z >> 4}].push_back({x, y, z, block});
+	return true;
+}
+
+void Server::tick(){
+	tick_count++;
+	stats = {};
+
+	accept();
+	for(auto& client : clients){ receive(*client); }
+
+	// One frame per changed chunk, shared by everyone who has the chunk
+	std::vector<std::pair<world::ChunkPos, Frame>> deltas;
+	deltas.reserve(changes.size());
+	for(auto& [pos, list] : changes){
+		stats.changes += static_cast<u32>(list.size());
+		deltas.emplace_back(pos, encode_delta(pos, list));
+		stats.bytes_encoded += deltas.back().second->size();
+		chunk_cache.erase(pos);
+	}
+	changes.clear();
+
+	for(auto& client : clients){
+		if(client->closed){ continue; }
+		for(const auto& [pos, frame] : deltas){
+			if(client->loaded.count(pos)){
+				queue(*client, frame);
+				client->stats.deltas_sent++;
+			}
+		}
+		update_interest(*client);
+		flush(*client);
+	}
+
+	size_t before = clients.size();
+	clients.erase(std::remove_if(clients.begin(), clients.end(), [](const auto& c){ return c->closed; }), clients.end());
+	if(clients.size() != before){ INFO("SERVER", before - clients.size() << " client(s) disconnected."); }
+
+	if(tick_count % CACHE_TICKS == 0){
+		for(auto it = chunk_cache.begin(); it != chunk_cache.end();){
+			it = it->second.used + CACHE_TICKS < tick_count ? chunk_cache.erase(it) : std::next(it);
+		}
+	}
+	stats.clients = static_cast<u32>(clients.size());
+}
+
+void Server::accept(){
+	for(Socket socket = listener.accept(); socket.valid(); socket = listener.accept()){
+		auto client = std::make_unique<Connection>();
+		client->socket = std::move(socket);
+		clients.push_back(std::move(client));
+	}
+}
+
+void Server::receive(Connection& client){
+	// Parsed after every read, so at most one read and one partial frame are buffered
+	u8 buffer[4096];
+	for(;;){
+		ssize_t received = client.socket.receive(buffer, sizeof(buffer));
+		if(received < 0){ client.closed = true; return; }
+		if(received == 0){ return; }
+		client.received.insert(client.received.end(), buffer, buffer + received);
+		if(!parse(client)){
+			client.closed = true;
+			return;
+		}
+	}
+}
+
+bool Server::parse(Connection& client){
+	size_t offset = 0;
+	while(client.received.size() - offset >= FRAME_HEADER){
+		u32 size;
+		std::memcpy(&size, client.received.data() + offset, sizeof(size));
+		if(size > MAX_CLIENT_PAYLOAD){
+			WARNING("SERVER", "Dropping client sending a " << size << " byte message.");
+			return false;
+		}
+		if(client.received.size() - offset - FRAME_HEADER < size){ break; }
+
+		Message type = static_cast<Message>(client.received[offset + 4]);
+		ByteReader in(client.received.data() + offset + FRAME_HEADER, size);
+		offset += FRAME_HEADER + size;
+
+		if(type != Message::POSITION){
+			WARNING("SERVER", "Unexpected message " << static_cast<u32>(type) << " from client.");
+			continue;
+		}
+		f32 x = in.get_f32();
+		f32 z = in.get_f32();
+		u8 view_distance = std::min(in.get_u8(), config.max_view_distance);
+		if(in.failed){ continue; }
+
+		world::ChunkPos center = {static_cast<s32>(std::floor(x)) >> 4, static_cast<s32>(std::floor(z)) >> 4};
+		if(!client.positioned || center != client.center || view_distance != client.view_distance){
+			client.center = center;
+			client.view_distance = view_distance;
+			client.positioned = true;
+			client.moved = true;
+			client.complete = false;
+		}
+	}
+	client.received.erase(client.received.begin(), client.received.begin() + offset);
+	return true;
+}
+
+void Server::update_interest(Connection& client){
+	if(!client.positioned){ return; }
+	s32 r = client.view_distance;
+
+	// One chunk of slack so walking back and forth over a border is free
+	if(client.moved){
+		client.moved = false;
+		for(auto it = client.loaded.begin(); it != client.loaded.end();){
+			s32 d = std::max(std::abs(it->x - client.center.x), std::abs(it->z - client.center.z));
+			if(d <= r + 1){
+				++it;
+				continue;
+			}
+			auto frame = std::make_shared<std::vector<u8>>();
+			ByteWriter out(*frame);
+			size_t start = out.begin(Message::UNLOAD);
+			out.put_s32(it->x);
+			out.put_s32(it->z);
+			out.end(start);
+			queue(client, frame);
+			it = client.loaded.erase(it);
+		}
+	}
+
+	// Nearest first, ring by ring
+	if(!client.complete){
+		u32 budget = config.chunks_per_tick;
+		auto want = [&](s32 x, s32 z){
+			world::ChunkPos pos = {client.center.x + x, client.center.z + z};
+			if(client.loaded.count(pos)){ return true; }
+			if(budget == 0 || client.queued_bytes >= config.max_queued_bytes){ return false; }
+			queue(client, chunk_frame(pos));
+			client.loaded.insert(pos);
+			client.stats.chunks_sent++;
+			stats.chunks_sent++;
+			budget--;
+			return true;
+		};
+
+		client.complete = true;
+		for(s32 d = 0; d <= r && client.complete; d++){
+			for(s32 i = -d; i <= d && client.complete; i++){
+				client.complete = want(i, -d) && (d == 0 || want(i, d));
+			}
+			for(s32 j = -d + 1; j <= d - 1 && client.complete; j++){
+				client.complete = want(-d, j) && want(d, j);
+			}
+		}
+	}
+	client.stats.loaded = static_cast<u32>(client.loaded.size());
+}
+
+void Server::queue(Connection& client, const Frame& frame){
+	client.queue.push_back(frame);
+	client.queued_bytes += frame->size();
+}
+
+void Server::flush(Connection& client){
+	iovec buffers[MAX_GATHER];
+	while(!client.queue.empty()){
+		int count = 0;
+		for(auto it = client.queue.begin(); it != client.queue.end() && count < MAX_GATHER; ++it, ++count){
+			size_t skip = count == 0 ? client.sent_offset : 0;
+			buffers[count].iov_base = const_cast<u8*>((*it)->data() + skip);
+			buffers[count].iov_len = (*it)->size() - skip;
+		}
+
+		ssize_t sent = client.socket.send(buffers, count);
+		if(sent < 0){ client.closed = true; return; }
+		if(sent == 0){ return; }
+
+		client.stats.bytes_sent += sent;
+		stats.bytes_sent += sent;
+		client.queued_bytes -= sent;
+
+		size_t left = static_cast<size_t>(sent);
+		while(left > 0){
+			size_t remaining = client.queue.front()->size() - client.sent_offset;
+			if(left < remaining){
+				client.sent_offset += left;
+				break;
+			}
+			left -= remaining;
+			client.queue.pop_front();
+			client.sent_offset = 0;
+		}
+	}
+}
+
+const Frame& Server::chunk_frame(world::ChunkPos pos){
+	auto found = chunk_cache.find(pos);
+	if(found != chunk_cache.end()){
+		found->second.used = tick_count;
+		return found->second.frame;
+	}
+
+	world::Chunk* chunk = store.get_chunk(pos);
+	if(chunk == nullptr){
+		chunk = &store.create(pos);
+		generator.generate(*chunk);
+	}
+
+	CachedChunk& cached = chunk_cache[pos];
+	cached.frame = encode_chunk(*chunk);
+	cached.used = tick_count;
+	stats.chunks_encoded++;
+	stats.bytes_encoded += cached.frame->size();
+	return cached.frame;
+}
+
+}	// namespace net
+}	// namespace uni
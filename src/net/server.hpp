@@ -0,0 +1,130 @@
+/**
+ * @file src/net/server.hpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#pragma once
+
+#include "net/protocol.hpp"
+#include "net/socket.hpp"
+
+#include "world/generator.hpp"
+
+#include <deque>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace uni {
+namespace net {
+
+struct ServerConfig {
+	u16 port = 0;                       // 0 picks a free port
+	u8 max_view_distance = 16;          // in chunks, clients asking for more get this
+	u32 chunks_per_tick = 8;            // new chunks sent to one client per tick
+	size_t max_queued_bytes = 1 << 20;  // no new chunks for a client with this much unsent
+};
+
+struct ClientStats {
+	u64 bytes_sent = 0;
+	u64 chunks_sent = 0;
+	u64 deltas_sent = 0;
+	u32 loaded = 0;     // chunks the client currently has
+};
+
+struct ServerStats {
+	u32 clients = 0;
+	u64 bytes_sent = 0;         // this tick, over every client
+	u64 bytes_encoded = 0;      // this tick, frames built once and shared
+	u32 chunks_encoded = 0;
+	u32 chunks_sent = 0;
+	u32 changes = 0;            // block changes this tick
+};
+
+/**
+ * @brief Streams chunks and block updates to every connected client
+ *
+ * Headless, it only needs a chunk store and a generator for chunks that
+ * are not loaded yet. Each tick:
+ *  1. Accepts connections and reads client positions
+ *  2. Encodes one delta frame per chunk changed this tick
+ *  3. Per client, unloads chunks outside its view distance, queues the
+ *     deltas of chunks it has and queues the nearest missing chunks
+ *  4. Writes every client's queue with one gathered send
+ *
+ * Chunk frames are cached until the chunk changes and queued by
+ * reference, so a chunk near many players is encoded once and the send
+ * path never copies frame data.
+ */
+class Server {
+public:
+	Server(const Server&) = delete;
+	Server& operator=(const Server&) = delete;
+
+	Server(world::ChunkStore& store, const world::Generator& generator, const ServerConfig& config);
+
+	/**
+	 * @brief Sets a block and queues the change for the next tick
+	 * @return False when the chunk is not loaded
+	 */
+	bool set_block(s32 x, s32 y, s32 z, world::BlockId block);
+
+	void tick();
+
+	u16 get_port() const { return listener.get_port(); }
+	size_t client_count() const { return clients.size(); }
+	const ClientStats& get_client_stats(size_t index) const { return clients[index]->stats; }
+	const ServerStats& get_stats() const { return stats; }
+
+private:
+	struct Connection {
+		Socket socket;
+		ClientStats stats;
+
+		world::ChunkPos center = {0, 0};
+		u8 view_distance = 0;
+		bool positioned = false;
+		bool moved = false;         // center or view distance changed since the last tick
+		bool complete = false;      // every chunk in view has been queued
+		std::unordered_set<world::ChunkPos, world::ChunkPosHash> loaded;
+
+		std::deque<Frame> queue;
+		size_t sent_offset = 0;     // into queue.front()
+		size_t queued_bytes = 0;
+
+		std::vector<u8> received;
+		bool closed = false;
+	};
+
+	struct CachedChunk {
+		Frame frame;
+		u64 used;
+	};
+
+	void accept();
+	void receive(Connection& client);
+
+	/**
+	 * @brief Handles every complete message a client has sent
+	 * @return False when the client sent a message larger than any it may send
+	 */
+	bool parse(Connection& client);
+	void update_interest(Connection& client);
+	void queue(Connection& client, const Frame& frame);
+	void flush(Connection& client);
+	const Frame& chunk_frame(world::ChunkPos pos);
+
+	world::ChunkStore& store;
+	const world::Generator& generator;
+	ServerConfig config;
+	Socket listener;
+	std::vector<std::unique_ptr<Connection>> clients;
+
+	std::unordered_map<world::ChunkPos, std::vector<BlockChange>, world::ChunkPosHash> changes;
+	std::unordered_map<world::ChunkPos, CachedChunk, world::ChunkPosHash> chunk_cache;
+	u64 tick_count = 0;
+	ServerStats stats;
+};
+
+}	// namespace net
+}	// namespace uni
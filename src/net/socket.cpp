@@ -0,0 +1,134 @@
+/**
+ * @file src/net/socket.cpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#include "net/socket.hpp"
+
+#include "util/util.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <exception>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace uni {
+namespace net {
+
+namespace {
+
+void configure(int fd){
+	fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+	int one = 1;
+	setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+}
+
+bool would_block(){
+	return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+}
+
+}	// namespace
+
+Socket& Socket::operator=(Socket&& o){
+	if(this != &o){
+		if(fd >= 0){ close(fd); }
+		fd = o.fd;
+		o.fd = -1;
+	}
+	return *this;
+}
+
+Socket::~Socket(){
+	if(fd >= 0){ close(fd); }
+}
+
+Socket Socket::listen(u16 port){
+	int fd = socket(AF_INET, SOCK_STREAM, 0);
+	if(fd < 0){
+		ERROR("NET", "Failed to create socket: " << std::strerror(errno));
+		throw std::exception();
+	}
+	Socket result(fd);
+
+	int one = 1;
+	setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+	sockaddr_in address = {};
+	address.sin_family = AF_INET;
+	address.sin_addr.s_addr = htonl(INADDR_ANY);
+	address.sin_port = htons(port);
+	if(bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 || ::listen(fd, SOMAXCONN) < 0){
+		ERROR("NET", "Failed to listen on port " << port << ": " << std::strerror(errno));
+		throw std::exception();
+	}
+	fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+	return result;
+}
+
+Socket Socket::connect(const std::string& host, u16 port){
+	addrinfo hints = {};
+	hints.ai_family = AF_INET;
+	hints.ai_socktype = SOCK_STREAM;
+	addrinfo* info = nullptr;
+	if(getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &info) != 0 || info == nullptr){
+		ERROR("NET", "Failed to resolve " << host << ".");
+		throw std::exception();
+	}
+
+	int fd = socket(info->ai_family, info->ai_socktype, info->ai_protocol);
+	if(fd < 0 || ::connect(fd, info->ai_addr, info->ai_addrlen) < 0){
+		ERROR("NET", "Failed to connect to " << host << ":" << port << ": " << std::strerror(errno));
+		freeaddrinfo(info);
+		if(fd >= 0){ close(fd); }
+		throw std::exception();
+	}
+	freeaddrinfo(info);
+	configure(fd);
+	return Socket(fd);
+}
+
+Socket Socket::accept(){
+	int client = ::accept(fd, nullptr, nullptr);
+	if(client < 0){ return Socket(); }
+	configure(client);
+	return Socket(client);
+}
+
+ssize_t Socket::send(const iovec* buffers, int count){
+	msghdr message = {};
+	message.msg_iov = const_cast<iovec*>(buffers);
+	message.msg_iovlen = count;
+	ssize_t sent = sendmsg(fd, &message, MSG_NOSIGNAL);
+	if(sent < 0){ return would_block() ? 0 : -1; }
+	return sent;
+}
+
+ssize_t Socket::send(const void* data, size_t size){
+	iovec buffer = {const_cast<void*>(data), size};
+	return send(&buffer, 1);
+}
+
+ssize_t Socket::receive(void* data, size_t size){
+	ssize_t received = recv(fd, data, size, 0);
+	if(received == 0){ return -1; }
+	if(received < 0){ return would_block() ? 0 : -1; }
+	return received;
+}
+
+u16 Socket::get_port() const {
+	sockaddr_in address = {};
+	socklen_t length = sizeof(address);
+	getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length);
+	return ntohs(address.sin_port);
+}
+
+}	// namespace net
+}	// namespace uni
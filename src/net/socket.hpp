@@ -0,0 +1,76 @@
+/**
+ * @file src/net/socket.hpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#pragma once
+
+#include "util/types.hpp"
+
+#include <string>
+
+#include <sys/types.h>
+#include <sys/uio.h>
+
+namespace uni {
+namespace net {
+
+/**
+ * @brief Non blocking TCP socket
+ *
+ * Setup failures (listen, connect) log and throw. Once connected, sends
+ * and receives never block and report a closed or broken connection by
+ * returning -1.
+ */
+class Socket {
+public:
+	Socket() = default;
+	Socket(const Socket&) = delete;
+	Socket& operator=(const Socket&) = delete;
+	Socket(Socket&& o) : fd{o.fd} { o.fd = -1; }
+	Socket& operator=(Socket&& o);
+
+	~Socket();
+
+	/**
+	 * @brief Listens on every interface
+	 * @param[in] port 0 picks a free port, see `get_port`
+	 */
+	static Socket listen(u16 port);
+
+	/**
+	 * @brief Connects to a server, blocking until connected
+	 */
+	static Socket connect(const std::string& host, u16 port);
+
+	/**
+	 * @brief Accepts one pending connection
+	 * @return An invalid socket when none are pending
+	 */
+	Socket accept();
+
+	/**
+	 * @brief Sends from several buffers at once without joining them first
+	 * @return Bytes sent, 0 when the socket buffer is full, -1 when closed
+	 */
+	ssize_t send(const iovec* buffers, int count);
+
+	ssize_t send(const void* data, size_t size);
+
+	/**
+	 * @return Bytes received, 0 when nothing is pending, -1 when closed
+	 */
+	ssize_t receive(void* data, size_t size);
+
+	u16 get_port() const;
+	bool valid() const { return fd >= 0; }
+
+private:
+	explicit Socket(int fd) : fd{fd} {}
+
+	int fd = -1;
+};
+
+}	// namespace net
+}	// namespace uni
@@ -0,0 +1,45 @@
+/**
+ * @file src/server.cpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#include "net/server.hpp"
+
+#include "util/util.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+
+/**
+ * @brief Dedicated server, no window and no device
+ *
+ * Usage: server.bin [port] [seed]
+ */
+int main(int argc, char** argv){
+	uni::net::ServerConfig config;
+	config.port = argc > 1 ? static_cast<u16>(std::atoi(argv[1])) : 25565;
+	u64 seed = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 0;
+
+	uni::world::ChunkStore store;
+	uni::world::Generator generator(seed);
+	uni::net::Server server(store, generator, config);
+
+	// 20 ticks per second
+	using clock = std::chrono::steady_clock;
+	const auto tick_length = std::chrono::milliseconds(50);
+	auto next = clock::now();
+	for(u64 tick = 0;; tick++){
+		auto start = clock::now();
+		server.tick();
+		if(tick % 200 == 0){
+			const auto& stats = server.get_stats();
+			f64 ms = std::chrono::duration<f64, std::milli>(clock::now() - start).count();
+			INFO("SERVER", stats.clients << " clients, " << store.size() << " chunks, tick " << ms << " ms, " << stats.bytes_sent << " bytes sent.");
+		}
+		next += tick_length;
+		std::this_thread::sleep_until(next);
+	}
+	return 0;
+}
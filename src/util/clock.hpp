@@ -0,0 +1,58 @@
+/**
+ * @file util/clock.hpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#pragma once
+
+#include "util/types.hpp"
+
+#include <chrono>
+#include <thread>
+
+/**
+ * @brief Source of time in nanoseconds for anything that paces or timestamps
+ *
+ * Swapping in a `SimulatedClock` makes timing code run deterministically
+ * in tests.
+ */
+class Clock {
+public:
+	virtual ~Clock() = default;
+
+	virtual u64 now() const {
+		return static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+	}
+
+	/**
+	 * @brief Sleeps then spins for the last stretch, OS sleeps overshoot by up to a millisecond
+	 */
+	virtual void sleep_until(u64 time){
+		constexpr u64 SPIN = 1000000;
+		u64 current = now();
+		if(time > current + SPIN){
+			std::this_thread::sleep_for(std::chrono::nanoseconds(time - current - SPIN));
+		}
+		while(now() < time){ std::this_thread::yield(); }
+	}
+
+	static Clock& steady(){
+		static Clock clock;
+		return clock;
+	}
+};
+
+/**
+ * @brief Clock that only moves when told to, sleeping jumps straight to the deadline
+ * @note Not thread safe, meant for single threaded tests
+ */
+class SimulatedClock : public Clock {
+public:
+	u64 now() const override { return time; }
+	void sleep_until(u64 t) override { if(t > time){ time = t; } }
+	void advance(u64 ns){ time += ns; }
+
+private:
+	u64 time = 0;
+};
@@ -0,0 +1,121 @@
+/**
+ * @file util/math.hpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#pragma once
+
+#include "util/types.hpp"
+
+#include <cmath>
+
+struct Vec3 {
+	f32 x = 0.0f, y = 0.0f, z = 0.0f;
+
+	f32& operator[](int i){ return (&x)[i]; }
+	f32 operator[](int i) const { return (&x)[i]; }
+
+	Vec3 operator+(const Vec3& o) const { return {x + o.x, y + o.y, z + o.z}; }
+	Vec3 operator-(const Vec3& o) const { return {x - o.x, y - o.y, z - o.z}; }
+	Vec3 operator*(f32 s) const { return {x * s, y * s, z * s}; }
+	Vec3& operator+=(const Vec3& o){ x += o.x; y += o.y; z += o.z; return *this; }
+
+	f32 dot(const Vec3& o) const { return x * o.x + y * o.y + z * o.z; }
+	f32 length() const { return std::sqrt(dot(*this)); }
+	Vec3 normalized() const { f32 l = length(); return l > 0.0f ? *this * (1.0f / l) : *this; }
+};
+
+inline Vec3 cross(const Vec3& a, const Vec3& b){
+	return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+}
+
+/**
+ * @brief Column major 4x4 matrix, laid out the way GLSL reads a mat4
+ */
+struct Mat4 {
+	f32 m[16] = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+
+	f32& at(int row, int col){ return m[col * 4 + row]; }
+	f32 at(int row, int col) const { return m[col * 4 + row]; }
+
+	Mat4 operator*(const Mat4& o) const {
+		Mat4 r;
+		for(int col = 0; col < 4; col++){
+			for(int row = 0; row < 4; row++){
+				f32 sum = 0.0f;
+				for(int k = 0; k < 4; k++){ sum += at(row, k) * o.at(k, col); }
+				r.at(row, col) = sum;
+			}
+		}
+		return r;
+	}
+
+	/**
+	 * @brief Right handed perspective projection into Vulkan clip space
+	 *
+	 * Y points down in clip space and depth goes from 0 at `near` to 1 at `far`.
+	 */
+	static Mat4 perspective(f32 fov_y, f32 aspect, f32 near, f32 far){
+		f32 f = 1.0f / std::tan(fov_y * 0.5f);
+		Mat4 r;
+		r.at(0, 0) = f / aspect;
+		r.at(1, 1) = -f;
+		r.at(2, 2) = far / (near - far);
+		r.at(2, 3) = near * far / (near - far);
+		r.at(3, 2) = -1.0f;
+		r.at(3, 3) = 0.0f;
+		return r;
+	}
+
+	static Mat4 look_at(const Vec3& eye, const Vec3& target, const Vec3& up){
+		Vec3 f = (target - eye).normalized();
+		Vec3 s = cross(f, up).normalized();
+		Vec3 u = cross(s, f);
+		Mat4 r;
+		for(int i = 0; i < 3; i++){
+			r.at(0, i) = s[i];
+			r.at(1, i) = u[i];
+			r.at(2, i) = -f[i];
+		}
+		r.at(0, 3) = -s.dot(eye);
+		r.at(1, 3) = -u.dot(eye);
+		r.at(2, 3) = f.dot(eye);
+		return r;
+	}
+};
+
+/**
+ * @brief Six planes bounding what a view projection matrix can see
+ *
+ * Planes are (a, b, c, d) with the inside where a*x + b*y + c*z + d >= 0,
+ * in the order left, right, bottom, top, near, far.
+ */
+struct Frustum {
+	f32 planes[6][4];
+
+	static Frustum from(const Mat4& view_proj){
+		Frustum r;
+		for(int i = 0; i < 4; i++){
+			f32 row3 = view_proj.at(3, i);
+			r.planes[0][i] = row3 + view_proj.at(0, i);
+			r.planes[1][i] = row3 - view_proj.at(0, i);
+			r.planes[2][i] = row3 + view_proj.at(1, i);
+			r.planes[3][i] = row3 - view_proj.at(1, i);
+			r.planes[4][i] = view_proj.at(2, i);    // Vulkan depth starts at 0
+			r.planes[5][i] = row3 - view_proj.at(2, i);
+		}
+		for(auto& p : r.planes){
+			f32 l = std::sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+			for(int i = 0; i < 4; i++){ p[i] /= l; }
+		}
+		return r;
+	}
+
+	bool sphere_visible(const Vec3& center, f32 radius) const {
+		for(const auto& p : planes){
+			if(p[0] * center.x + p[1] * center.y + p[2] * center.z + p[3] < -radius){ return false; }
+		}
+		return true;
+	}
+};
@@ -0,0 +1,66 @@
+/**
+ * @file util/spsc_queue.hpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#pragma once
+
+#include "util/types.hpp"
+
+#include <array>
+#include <atomic>
+
+/**
+ * @brief Bounded lock free queue for one producer thread and one consumer thread
+ *
+ * Neither side ever blocks or allocates. `Capacity` must be a power of two.
+ */
+template<typename T, size_t Capacity>
+class SpscQueue {
+	static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+	/**
+	 * @brief Producer side
+	 * @return False when the queue is full, the value is dropped
+	 */
+	bool push(const T& value){
+		size_t t = tail.load(std::memory_order_relaxed);
+		if(t - head_cache == Capacity){
+			head_cache = head.load(std::memory_order_acquire);
+			if(t - head_cache == Capacity){ return false; }
+		}
+		items[t & (Capacity - 1)] = value;
+		tail.store(t + 1, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	 * @brief Consumer side
+	 * @return False when the queue is empty
+	 */
+	bool pop(T& value){
+		size_t h = head.load(std::memory_order_relaxed);
+		if(h == tail_cache){
+			tail_cache = tail.load(std::memory_order_acquire);
+			if(h == tail_cache){ return false; }
+		}
+		value = items[h & (Capacity - 1)];
+		head.store(h + 1, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	 * @brief Approximate, exact only when called from one side with the other idle
+	 */
+	size_t size() const { return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire); }
+
+private:
+	// Each side's index and its cached copy of the other's share a cache line
+	alignas(64) std::atomic<size_t> head{0};
+	size_t tail_cache = 0;
+	alignas(64) std::atomic<size_t> tail{0};
+	size_t head_cache = 0;
+	alignas(64) std::array<T, Capacity> items;
+};
@@ -0,0 +1,116 @@
+/**
+ * @file util/thread_pool.hpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#pragma once
+
+#include "util/types.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Fixed set of worker threads running one parallel loop at a time
+ *
+ * The calling thread takes part as worker 0, so a pool of size 1 has no
+ * threads and runs everything inline. Worker indices are stable which
+ * lets callers keep per worker scratch state.
+ */
+class ThreadPool {
+public:
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	/**
+	 * @param[in] size Total workers including the caller, 0 picks the core count
+	 */
+	explicit ThreadPool(u32 size = 0){
+		if(size == 0){ size = std::max(1u, std::thread::hardware_concurrency()); }
+		for(u32 i = 1; i < size; i++){
+			threads.emplace_back([this, i](){ worker_loop(i); });
+		}
+	}
+
+	~ThreadPool(){
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stop = true;
+		}
+		wake.notify_all();
+		for(auto& thread : threads){ thread.join(); }
+	}
+
+	u32 size() const { return static_cast<u32>(threads.size()) + 1; }
+
+	/**
+	 * @brief Calls `fn(index, worker)` for every index in [0, count)
+	 *
+	 * Indices are handed out dynamically so uneven work balances itself.
+	 * Returns once every call has finished.
+	 */
+	void parallel_for(size_t count, const std::function<void(size_t, u32)>& fn){
+		if(count == 0){ return; }
+		if(threads.empty() || count == 1){
+			for(size_t i = 0; i < count; i++){ fn(i, 0); }
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			job = &fn;
+			job_count = count;
+			next.store(0, std::memory_order_relaxed);
+			pending = threads.size();
+			generation++;
+		}
+		wake.notify_all();
+		run(0);
+
+		std::unique_lock<std::mutex> lock(mutex);
+		finished.wait(lock, [this](){ return pending == 0; });
+		job = nullptr;
+	}
+
+private:
+	void run(u32 worker){
+		for(size_t i = next.fetch_add(1, std::memory_order_relaxed); i < job_count; i = next.fetch_add(1, std::memory_order_relaxed)){
+			(*job)(i, worker);
+		}
+	}
+
+	void worker_loop(u32 worker){
+		u64 seen = 0;
+		for(;;){
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				wake.wait(lock, [&](){ return stop || generation != seen; });
+				if(stop){ return; }
+				seen = generation;
+			}
+			run(worker);
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				if(--pending == 0){ finished.notify_one(); }
+			}
+		}
+	}
+
+	std::vector<std::thread> threads;
+	std::mutex mutex;
+	std::condition_variable wake;
+	std::condition_variable finished;
+	bool stop = false;
+	u64 generation = 0;
+	size_t pending = 0;
+
+	const std::function<void(size_t, u32)>* job = nullptr;
+	size_t job_count = 0;
+	std::atomic<size_t> next{0};
+};
@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <cstdint>
+
 using u8 = uint8_t;
 using u16 = uint16_t;
 using u32 = uint32_t;
@@ -0,0 +1,67 @@
+/**
+ * @file src/world/block.hpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#pragma once
+
+#include "util/types.hpp"
+
+namespace uni {
+namespace world {
+
+using BlockId = u16;
+
+constexpr BlockId AIR = 0;
+constexpr BlockId STONE = 1;
+constexpr BlockId DIRT = 2;
+constexpr BlockId GRASS = 3;
+constexpr BlockId SAND = 4;
+constexpr BlockId WATER = 5;
+constexpr BlockId LOG = 6;
+constexpr BlockId LEAVES = 7;
+
+// Water that flowed from a source, FLOWING_WATER + level - 1 for levels 1..7
+constexpr BlockId FLOWING_WATER = 8;
+constexpr BlockId BLOCK_COUNT = FLOWING_WATER + 7;
+
+/**
+ * @brief If the block is water, source or flowing
+ */
+inline bool is_water(BlockId block){
+	return block == WATER || (block >= FLOWING_WATER && block < FLOWING_WATER + 7);
+}
+
+/**
+ * @brief Water level, 8 for a source, 1..7 for flowing water and 0 for anything else
+ */
+inline u8 water_level(BlockId block){
+	if(block == WATER){ return 8; }
+	return is_water(block) ? static_cast<u8>(block - FLOWING_WATER + 1) : 0;
+}
+
+/**
+ * @brief Block for a water level as returned by `water_level`
+ */
+inline BlockId water_block(u8 level){
+	if(level == 0){ return AIR; }
+	return level >= 8 ? WATER : static_cast<BlockId>(FLOWING_WATER + level - 1);
+}
+
+/**
+ * @brief If entities collide with the block
+ */
+inline bool is_solid(BlockId block){
+	return block != AIR && !is_water(block);
+}
+
+/**
+ * @brief If the block hides the faces of its neighbours
+ */
+inline bool is_opaque(BlockId block){
+	return is_solid(block) && block != LEAVES;
+}
+
+}	// namespace world
+}	// namespace uni
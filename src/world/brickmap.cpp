@@ -0,0 +1,316 @@
+/**
+ * @file src/world/brickmap.cpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#include "world/brickmap.hpp"
+
+#include "util/util.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <limits>
+
+namespace uni {
+namespace world {
+
+namespace {
+
+constexpr ChunkPos NO_OWNER = {INT_MIN, INT_MIN};
+constexpr f32 INF = std::numeric_limits<f32>::infinity();
+
+// Nudge into the next section so a ray on its boundary lands inside it
+constexpr f32 EPS = 1e-3f;
+
+u32 column_bytes(){
+	return CHUNK_SECTIONS * sizeof(u32) + sizeof(ChunkPos);
+}
+
+}	// namespace
+
+BlockId downsample_cell(const Section& section, s32 x, s32 y, s32 z){
+	for(s32 dy = FAR_CELL_SIZE - 1; dy >= 0; dy--){
+		for(s32 dz = 0; dz < FAR_CELL_SIZE; dz++){
+			for(s32 dx = 0; dx < FAR_CELL_SIZE; dx++){
+				BlockId block = section.get(x * FAR_CELL_SIZE + dx, y * FAR_CELL_SIZE + dy, z * FAR_CELL_SIZE + dz);
+				if(block != AIR){ return block; }
+			}
+		}
+	}
+	return AIR;
+}
+
+Brickmap::Brickmap(const BrickmapConfig& config) : config{config} {
+	if(config.grid_chunks == 0 || (config.grid_chunks & (config.grid_chunks - 1))){
+		ERROR("BRICKMAP", "Grid size " << config.grid_chunks << " is not a power of two.");
+		throw std::exception();
+	}
+	size_t columns = size_t(config.grid_chunks) * config.grid_chunks;
+	grid.assign(columns * CHUNK_SECTIONS, FAR_EMPTY);
+	owners.assign(columns, NO_OWNER);
+	column_dirty.assign(columns, 0);
+	bricks.resize(config.max_bricks);
+	brick_dirty.assign(config.max_bricks, 0);
+	free_bricks.reserve(config.max_bricks);
+	for(u32 i = config.max_bricks; i > 0; i--){ free_bricks.push_back(i - 1); }
+}
+
+bool Brickmap::update(const ChunkStore& store, ChunkPos pos){
+	const Chunk* chunk = store.get_chunk(pos);
+	if(chunk == nullptr){
+		remove(pos);
+		return true;
+	}
+
+	u32 column = column_of(pos);
+	if(owners[column] != pos){
+		if(owners[column] != NO_OWNER){ remove(owners[column]); }
+		owners[column] = pos;
+		stats.columns++;
+		dirty_column(column);
+	}
+
+	bool fits = true;
+	FarBrick brick;
+	for(s32 sy = 0; sy < CHUNK_SECTIONS; sy++){
+		u32 entry = column * CHUNK_SECTIONS + sy;
+		const Section* section = chunk->get_section(sy);
+		if(section == nullptr || section->empty()){
+			if(grid[entry] != FAR_EMPTY){
+				release(entry);
+				dirty_column(column);
+			}
+			continue;
+		}
+
+		brick = {};
+		u32 occupied = 0;
+		BlockId first = AIR;
+		bool uniform = true;
+		for(s32 y = 0, i = 0; y < FAR_BRICK_CELLS; y++){
+			for(s32 z = 0; z < FAR_BRICK_CELLS; z++){
+				for(s32 x = 0; x < FAR_BRICK_CELLS; x++, i++){
+					BlockId block = downsample_cell(*section, x, y, z);
+					if(i == 0){ first = block; }
+					uniform &= block == first;
+					if(block == AIR){ continue; }
+					brick.occupancy[i >> 5] |= 1u << (i & 31);
+					brick.materials[i >> 3] |= static_cast<u32>(block) << ((i & 7) * 4);
+					occupied++;
+				}
+			}
+		}
+		fits &= assign(entry, brick, occupied, first, uniform);
+	}
+	stats.bytes = u64(stats.bricks) * sizeof(FarBrick) + u64(stats.columns) * column_bytes();
+	return fits;
+}
+
+void Brickmap::remove(ChunkPos pos){
+	u32 column = column_of(pos);
+	if(owners[column] != pos){ return; }
+	for(s32 sy = 0; sy < CHUNK_SECTIONS; sy++){ release(column * CHUNK_SECTIONS + sy); }
+	owners[column] = NO_OWNER;
+	stats.columns--;
+	stats.bytes = u64(stats.bricks) * sizeof(FarBrick) + u64(stats.columns) * column_bytes();
+	dirty_column(column);
+}
+
+bool Brickmap::assign(u32 entry, const FarBrick& brick, u32 occupied, BlockId first, bool uniform){
+	u32 value;
+	if(occupied == 0){
+		value = FAR_EMPTY;
+	} else if(uniform){
+		value = FAR_UNIFORM | first;
+	} else {
+		u32 old = grid[entry];
+		if(old != FAR_EMPTY && !(old & FAR_UNIFORM)){
+			// Same slot, only upload when the contents changed
+			u32 slot = old - 1;
+			if(bricks[slot] != brick){
+				bricks[slot] = brick;
+				if(!brick_dirty[slot]){
+					brick_dirty[slot] = 1;
+					dirty_bricks.push_back(slot);
+				}
+			}
+			return true;
+		}
+		if(free_bricks.empty()){
+			release(entry);
+			dirty_column(entry / CHUNK_SECTIONS);
+			return false;
+		}
+		u32 slot = free_bricks.back();
+		free_bricks.pop_back();
+		bricks[slot] = brick;
+		if(!brick_dirty[slot]){
+			brick_dirty[slot] = 1;
+			dirty_bricks.push_back(slot);
+		}
+		release(entry);
+		grid[entry] = slot + 1;
+		stats.bricks++;
+		dirty_column(entry / CHUNK_SECTIONS);
+		return true;
+	}
+
+	if(grid[entry] != value){
+		release(entry);
+		grid[entry] = value;
+		if(value & FAR_UNIFORM){ stats.uniform++; }
+		dirty_column(entry / CHUNK_SECTIONS);
+	}
+	return true;
+}
+
+void Brickmap::release(u32 entry){
+	u32 value = grid[entry];
+	if(value == FAR_EMPTY){ return; }
+	if(value & FAR_UNIFORM){
+		stats.uniform--;
+	} else {
+		if(config.deferred_reuse){ released.push_back({value - 1, entry / CHUNK_SECTIONS}); }
+		else { free_bricks.push_back(value - 1); }
+		stats.bricks--;
+	}
+	grid[entry] = FAR_EMPTY;
+}
+
+void Brickmap::dirty_column(u32 column){
+	if(column_dirty[column]){ return; }
+	column_dirty[column] = 1;
+	dirty_columns.push_back(column);
+}
+
+size_t Brickmap::take_dirty_bricks(std::vector<u32>& out, size_t max){
+	size_t n = std::min(max, dirty_bricks.size());
+	for(size_t i = 0; i < n; i++){
+		brick_dirty[dirty_bricks[i]] = 0;
+		out.push_back(dirty_bricks[i]);
+	}
+	dirty_bricks.erase(dirty_bricks.begin(), dirty_bricks.begin() + n);
+	return dirty_bricks.size();
+}
+
+size_t Brickmap::take_dirty_columns(std::vector<u32>& out, size_t max){
+	size_t taken = 0, kept = 0;
+	for(u32 column : dirty_columns){
+		if(taken < max && column_ready(column)){
+			column_dirty[column] = 0;
+			out.push_back(column);
+			taken++;
+		} else {
+			dirty_columns[kept++] = column;
+		}
+	}
+	dirty_columns.resize(kept);
+	return kept;
+}
+
+void Brickmap::take_released_bricks(std::vector<u32>& out){
+	size_t kept = 0;
+	for(const auto& [slot, column] : released){
+		if(column_dirty[column]){
+			released[kept++] = {slot, column};
+		} else {
+			out.push_back(slot);
+		}
+	}
+	released.resize(kept);
+}
+
+void Brickmap::recycle_bricks(const std::vector<u32>& slots){
+	free_bricks.insert(free_bricks.end(), slots.begin(), slots.end());
+}
+
+bool Brickmap::column_ready(u32 column) const {
+	for(s32 sy = 0; sy < CHUNK_SECTIONS; sy++){
+		u32 value = grid[column * CHUNK_SECTIONS + sy];
+		if(value != FAR_EMPTY && !(value & FAR_UNIFORM) && brick_dirty[value - 1]){ return false; }
+	}
+	return true;
+}
+
+u32 Brickmap::lookup(s32 sx, s32 sy, s32 sz) const {
+	if(sy < 0 || sy >= CHUNK_SECTIONS){ return FAR_EMPTY; }
+	u32 column = column_of({sx, sz});
+	if(owners[column] != ChunkPos{sx, sz}){ return FAR_EMPTY; }
+	return grid[column * CHUNK_SECTIONS + sy];
+}
+
+FarHit Brickmap::march(const Ray& ray, f32 start) const {
+	const Vec3& o = ray.origin;
+	const Vec3& d = ray.direction;
+	FarHit result;
+
+	f32 t = start;
+	while(t < ray.max_distance){
+		// Section the ray is in just past t
+		s32 s[3];
+		for(int a = 0; a < 3; a++){ s[a] = static_cast<s32>(std::floor(o[a] + d[a] * (t + EPS))) >> 4; }
+
+		// Where the ray leaves that section
+		f32 exit = INF;
+		for(int a = 0; a < 3; a++){
+			if(d[a] > 0.0f){ exit = std::min(exit, ((s[a] + 1) * SECTION_SIZE - o[a]) / d[a]); }
+			else if(d[a] < 0.0f){ exit = std::min(exit, (s[a] * SECTION_SIZE - o[a]) / d[a]); }
+		}
+
+		u32 entry = lookup(s[0], s[1], s[2]);
+		if(entry & FAR_UNIFORM){
+			result.hit = true;
+			result.distance = t;
+			result.block = static_cast<BlockId>(entry & 0xffff);
+			return result;
+		}
+		if(entry != FAR_EMPTY){
+			// Cell DDA inside the section
+			const FarBrick& brick = bricks[entry - 1];
+			s32 cell[3], step[3];
+			f32 tmax[3], tdelta[3];
+			for(int a = 0; a < 3; a++){
+				f32 p = o[a] + d[a] * (t + EPS);
+				cell[a] = std::clamp(static_cast<s32>(std::floor(p / FAR_CELL_SIZE)) - s[a] * FAR_BRICK_CELLS, 0, FAR_BRICK_CELLS - 1);
+				f32 base = static_cast<f32>((s[a] * FAR_BRICK_CELLS + cell[a]) * FAR_CELL_SIZE);
+				if(d[a] > 0.0f){
+					step[a] = 1;
+					tdelta[a] = FAR_CELL_SIZE / d[a];
+					tmax[a] = (base + FAR_CELL_SIZE - o[a]) / d[a];
+				} else if(d[a] < 0.0f){
+					step[a] = -1;
+					tdelta[a] = -FAR_CELL_SIZE / d[a];
+					tmax[a] = (base - o[a]) / d[a];
+				} else {
+					step[a] = 0;
+					tdelta[a] = INF;
+					tmax[a] = INF;
+				}
+			}
+
+			f32 tc = t;
+			for(;;){
+				s32 i = (cell[1] * FAR_BRICK_CELLS + cell[2]) * FAR_BRICK_CELLS + cell[0];
+				if(brick.occupancy[i >> 5] & (1u << (i & 31))){
+					if(tc >= ray.max_distance){ return result; }
+					result.hit = true;
+					result.distance = tc;
+					result.block = brick.get(cell[0], cell[1], cell[2]);
+					return result;
+				}
+				int a = (tmax[0] <= tmax[1] && tmax[0] <= tmax[2]) ? 0 : (tmax[1] <= tmax[2] ? 1 : 2);
+				tc = tmax[a];
+				tmax[a] += tdelta[a];
+				cell[a] += step[a];
+				if(cell[a] < 0 || cell[a] >= FAR_BRICK_CELLS){ break; }
+			}
+		}
+		t = std::max(exit, t + EPS);
+	}
+	return result;
+}
+
+}	// namespace world
+}	// namespace uni
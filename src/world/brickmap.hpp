@@ -0,0 +1,217 @@
+/**
+ * @file src/world/brickmap.hpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#pragma once
+
+#include "world/chunk.hpp"
+#include "world/query.hpp"
+
+#include <array>
+#include <utility>
+#include <vector>
+
+namespace uni {
+namespace world {
+
+// Far field cells are 2x2x2 blocks, a brick holds the 8x8x8 cells of one section
+constexpr s32 FAR_CELL_SIZE = 2;
+constexpr s32 FAR_BRICK_CELLS = SECTION_SIZE / FAR_CELL_SIZE;
+constexpr s32 FAR_BRICK_VOLUME = FAR_BRICK_CELLS * FAR_BRICK_CELLS * FAR_BRICK_CELLS;
+
+static_assert(BLOCK_COUNT <= 16, "Far field materials are 4 bits");
+
+/**
+ * @brief Grid entry of a section, `FAR_EMPTY`, `FAR_UNIFORM | block` or brick index + 1
+ *
+ * Sections whose cells are all the same block, most of the ground, are
+ * stored in the grid entry alone and take no brick.
+ */
+constexpr u32 FAR_EMPTY = 0;
+constexpr u32 FAR_UNIFORM = 1u << 31;
+
+/**
+ * @brief Cells of one section, std430 layout
+ *
+ * Cell index is x fastest then z then y like `block_index`. `occupancy`
+ * has a bit per non air cell, `materials` a 4 bit block id per cell.
+ */
+struct FarBrick {
+	std::array<u32, FAR_BRICK_VOLUME / 32> occupancy{};
+	std::array<u32, FAR_BRICK_VOLUME / 8> materials{};
+
+	BlockId get(s32 x, s32 y, s32 z) const {
+		s32 i = (y * FAR_BRICK_CELLS + z) * FAR_BRICK_CELLS + x;
+		return static_cast<BlockId>((materials[i >> 3] >> ((i & 7) * 4)) & 15);
+	}
+
+	bool operator==(const FarBrick& o) const { return occupancy == o.occupancy && materials == o.materials; }
+	bool operator!=(const FarBrick& o) const { return !(*this == o); }
+};
+static_assert(sizeof(FarBrick) == 320, "FarBrick must match the shaders");
+
+/**
+ * @brief Block a far field cell shows, the highest non air block in it
+ *
+ * Taking the top block keeps grass on hills and water on lakes.
+ *
+ * @param[in] section
+ * @param[in] x Cell coordinates inside the section, 0..7
+ * @param[in] y
+ * @param[in] z
+ */
+BlockId downsample_cell(const Section& section, s32 x, s32 y, s32 z);
+
+struct BrickmapConfig {
+	u32 grid_chunks = 256;      // side of the grid in chunks, power of two, wraps around
+	u32 max_bricks = 1 << 16;
+	bool deferred_reuse = false;    // freed bricks wait for `recycle_bricks`, needed by a GPU copy
+};
+
+struct BrickmapStats {
+	u32 columns = 0;            // chunks in the grid
+	u32 bricks = 0;
+	u32 uniform = 0;            // sections stored in their grid entry alone
+	u64 bytes = 0;              // grid entries of the columns in use plus bricks
+};
+
+struct FarHit {
+	bool hit = false;
+	f32 distance = 0.0f;
+	BlockId block = AIR;
+};
+
+/**
+ * @brief Coarse copy of the chunk store for ray marching the far field
+ *
+ * A grid of `grid_chunks` squared chunk columns, addressed by chunk
+ * position modulo the grid so it follows the player without moving
+ * anything, holds one entry per section. Each column remembers which
+ * chunk owns it, lookups into a column owned by another chunk are empty.
+ *
+ * Bricks live in fixed size slots so a changed chunk rewrites only its
+ * own slots. Changed slots and columns are recorded for `eng::FarField`
+ * to upload. A copy that lags behind may still point at a freed slot,
+ * with `deferred_reuse` freed slots are handed to it and only reused
+ * once it gives them back.
+ */
+class Brickmap {
+public:
+	Brickmap(const Brickmap&) = delete;
+	Brickmap& operator=(const Brickmap&) = delete;
+
+	Brickmap(const BrickmapConfig& config);
+
+	/**
+	 * @brief Rebuilds a chunk's column from the store
+	 *
+	 * Evicts the chunk that owned the column before. A chunk that is not
+	 * loaded is removed.
+	 *
+	 * @param[in] store
+	 * @param[in] pos
+	 * @return False when out of bricks, the sections that did not fit are left empty
+	 */
+	bool update(const ChunkStore& store, ChunkPos pos);
+
+	/**
+	 * @brief Empties a chunk's column if the chunk owns it
+	 * @return void
+	 */
+	void remove(ChunkPos pos);
+
+	/**
+	 * @brief Marches a ray through the bricks
+	 *
+	 * Reference for the far field shader, which must hit the same cells.
+	 * Empty sections are crossed in one step.
+	 *
+	 * @param[in] ray
+	 * @param[in] start Distance along the ray to start at
+	 * @return First non air cell between `start` and `max_distance`
+	 */
+	FarHit march(const Ray& ray, f32 start) const;
+
+	/**
+	 * @brief Moves up to `max` changed bricks into `out`
+	 * @return Bricks still waiting after this call
+	 */
+	size_t take_dirty_bricks(std::vector<u32>& out, size_t max);
+
+	/**
+	 * @brief Moves up to `max` changed columns into `out`
+	 *
+	 * Columns pointing at bricks not taken yet are skipped and wait for
+	 * them, the rest go in the order they changed.
+	 *
+	 * @return Columns still waiting after this call
+	 */
+	size_t take_dirty_columns(std::vector<u32>& out, size_t max);
+
+	/**
+	 * @brief Moves freed bricks no column waiting to be taken points at into `out`
+	 *
+	 * Only with `deferred_reuse`. Copies of the columns taken before may
+	 * still point at them, see `recycle_bricks`.
+	 *
+	 * @return void
+	 */
+	void take_released_bricks(std::vector<u32>& out);
+
+	/**
+	 * @brief Makes bricks from `take_released_bricks` free again
+	 * @param[in] slots Once nothing reads a column copy older than their release
+	 * @return void
+	 */
+	void recycle_bricks(const std::vector<u32>& slots);
+
+	size_t get_dirty_brick_count() const { return dirty_bricks.size(); }
+	size_t get_dirty_column_count() const { return dirty_columns.size(); }
+
+	u32 column_of(ChunkPos pos) const {
+		u32 mask = config.grid_chunks - 1;
+		return (static_cast<u32>(pos.x) & mask) * config.grid_chunks + (static_cast<u32>(pos.z) & mask);
+	}
+
+	// CHUNK_SECTIONS entries per column
+	const std::vector<u32>& get_grid() const { return grid; }
+	const std::vector<ChunkPos>& get_owners() const { return owners; }
+	const std::vector<FarBrick>& get_bricks() const { return bricks; }
+	const BrickmapConfig& get_config() const { return config; }
+	const BrickmapStats& get_stats() const { return stats; }
+
+private:
+	u32 lookup(s32 sx, s32 sy, s32 sz) const;
+
+	/**
+	 * @brief Points a grid entry at new contents, reusing its brick slot
+	 * @return False when a brick was needed and none was free
+	 */
+	bool assign(u32 entry, const FarBrick& brick, u32 occupied, BlockId first, bool uniform);
+	void release(u32 entry);
+	void dirty_column(u32 column);
+
+	/**
+	 * @brief Whether every brick a column points at has been taken
+	 */
+	bool column_ready(u32 column) const;
+
+	BrickmapConfig config;
+	std::vector<u32> grid;
+	std::vector<ChunkPos> owners;
+	std::vector<FarBrick> bricks;
+	std::vector<u32> free_bricks;
+	std::vector<std::pair<u32, u32>> released;     // slot, column that pointed at it
+
+	std::vector<u8> brick_dirty;
+	std::vector<u8> column_dirty;
+	std::vector<u32> dirty_bricks;
+	std::vector<u32> dirty_columns;
+
+	BrickmapStats stats;
+};
+
+}	// namespace world
+}	// namespace uni
@@ -0,0 +1,110 @@
+/**
+ * @file src/world/chunk.cpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#include "world/chunk.hpp"
+
+namespace uni {
+namespace world {
+
+void Section::set(s32 x, s32 y, s32 z, BlockId block){
+	BlockId& current = blocks[block_index(x, y, z)];
+	if(current == block){ return; }
+
+	if(current == AIR){
+		non_air++;
+		occupancy |= brick_bit(x, y, z);
+		current = block;
+		return;
+	}
+
+	current = block;
+	if(block != AIR){ return; }
+	non_air--;
+
+	// Cleared a block, the brick may now be empty
+	s32 bx = x & ~3, by = y & ~3, bz = z & ~3;
+	for(s32 j = by; j < by + BRICK_SIZE; j++){
+		for(s32 k = bz; k < bz + BRICK_SIZE; k++){
+			for(s32 i = bx; i < bx + BRICK_SIZE; i++){
+				if(blocks[block_index(i, j, k)] != AIR){ return; }
+			}
+		}
+	}
+	occupancy &= ~brick_bit(x, y, z);
+}
+
+void Section::recount(){
+	non_air = 0;
+	occupancy = 0;
+	for(s32 i = 0; i < SECTION_VOLUME; i++){
+		if(blocks[i] == AIR){ continue; }
+		non_air++;
+		occupancy |= brick_bit(i & 15, i >> 8, (i >> 4) & 15);
+	}
+}
+
+BlockId Chunk::get(s32 x, s32 y, s32 z) const {
+	if(y < 0 || y >= CHUNK_HEIGHT){ return AIR; }
+	const Section* section = sections[y >> 4].get();
+	return section ? section->get(x, y & 15, z) : AIR;
+}
+
+void Chunk::set(s32 x, s32 y, s32 z, BlockId block){
+	if(y < 0 || y >= CHUNK_HEIGHT){ return; }
+	auto& section = sections[y >> 4];
+	if(!section){
+		if(block == AIR){ return; }
+		section = std::make_unique<Section>();
+	}
+	section->set(x, y & 15, z, block);
+}
+
+Section& Chunk::make_section(s32 index){
+	auto& section = sections[index];
+	if(!section){ section = std::make_unique<Section>(); }
+	return *section;
+}
+
+Chunk& ChunkStore::create(ChunkPos pos){
+	auto& chunk = chunks[pos];
+	chunk = std::make_unique<Chunk>(pos);
+	return *chunk;
+}
+
+void ChunkStore::remove(ChunkPos pos){
+	chunks.erase(pos);
+}
+
+Chunk* ChunkStore::get_chunk(ChunkPos pos){
+	auto it = chunks.find(pos);
+	return it == chunks.end() ? nullptr : it->second.get();
+}
+
+const Chunk* ChunkStore::get_chunk(ChunkPos pos) const {
+	auto it = chunks.find(pos);
+	return it == chunks.end() ? nullptr : it->second.get();
+}
+
+const Section* ChunkStore::get_section(s32 sx, s32 sy, s32 sz) const {
+	if(sy < 0 || sy >= CHUNK_SECTIONS){ return nullptr; }
+	const Chunk* chunk = get_chunk({sx, sz});
+	return chunk ? chunk->get_section(sy) : nullptr;
+}
+
+BlockId ChunkStore::get_block(s32 x, s32 y, s32 z) const {
+	const Chunk* chunk = get_chunk({x >> 4, z >> 4});
+	return chunk ? chunk->get(x & 15, y, z & 15) : AIR;
+}
+
+bool ChunkStore::set_block(s32 x, s32 y, s32 z, BlockId block){
+	Chunk* chunk = get_chunk({x >> 4, z >> 4});
+	if(!chunk){ return false; }
+	chunk->set(x & 15, y, z & 15, block);
+	return true;
+}
+
+}	// namespace world
+}	// namespace uni
@@ -0,0 +1,151 @@
+/**
+ * @file src/world/chunk.hpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#pragma once
+
+#include "world/block.hpp"
+
+#include <array>
+#include <memory>
+#include <unordered_map>
+
+namespace uni {
+namespace world {
+
+constexpr s32 SECTION_SIZE = 16;
+constexpr s32 SECTION_VOLUME = SECTION_SIZE * SECTION_SIZE * SECTION_SIZE;
+constexpr s32 CHUNK_SECTIONS = 16;
+constexpr s32 CHUNK_HEIGHT = SECTION_SIZE * CHUNK_SECTIONS;
+
+// Sections are split into 4x4x4 bricks, one occupancy bit per brick
+constexpr s32 BRICK_SIZE = 4;
+
+/**
+ * @brief Index of a block inside a section, x fastest then z then y
+ */
+inline s32 block_index(s32 x, s32 y, s32 z){
+	return (y * SECTION_SIZE + z) * SECTION_SIZE + x;
+}
+
+/**
+ * @brief Occupancy bit of the brick holding a block inside a section
+ */
+inline u64 brick_bit(s32 x, s32 y, s32 z){
+	return 1ull << (((y >> 2) * 4 + (z >> 2)) * 4 + (x >> 2));
+}
+
+/**
+ * @brief 16x16x16 cube of blocks
+ *
+ * `occupancy` has a bit set for every 4x4x4 brick holding at least one
+ * non air block so queries can skip empty space without touching blocks.
+ */
+struct Section {
+	std::array<BlockId, SECTION_VOLUME> blocks{};
+	u64 occupancy = 0;
+	u16 non_air = 0;
+
+	BlockId get(s32 x, s32 y, s32 z) const { return blocks[block_index(x, y, z)]; }
+
+	/**
+	 * @brief Sets a block and keeps `occupancy` and `non_air` up to date
+	 */
+	void set(s32 x, s32 y, s32 z, BlockId block);
+
+	bool empty() const { return non_air == 0; }
+
+	/**
+	 * @brief Recomputes `occupancy` and `non_air` after writing `blocks` directly
+	 */
+	void recount();
+};
+
+struct ChunkPos {
+	s32 x, z;
+
+	bool operator==(const ChunkPos& o) const { return x == o.x && z == o.z; }
+	bool operator!=(const ChunkPos& o) const { return !(*this == o); }
+};
+
+struct ChunkPosHash {
+	size_t operator()(const ChunkPos& p) const {
+		return static_cast<size_t>((static_cast<u64>(static_cast<u32>(p.x)) << 32 | static_cast<u32>(p.z)) * 0x9e3779b97f4a7c15ull);
+	}
+};
+
+/**
+ * @brief Column of sections, sections that are all air are not allocated
+ */
+class Chunk {
+public:
+	Chunk(ChunkPos pos) : pos{pos} {}
+
+	/**
+	 * @brief Gets a block in chunk local coordinates
+	 * @note y outside [0, CHUNK_HEIGHT) is air
+	 */
+	BlockId get(s32 x, s32 y, s32 z) const;
+
+	/**
+	 * @brief Sets a block in chunk local coordinates, allocating its section
+	 */
+	void set(s32 x, s32 y, s32 z, BlockId block);
+
+	const Section* get_section(s32 index) const { return sections[index].get(); }
+	Section* get_section(s32 index){ return sections[index].get(); }
+
+	/**
+	 * @brief Gets a section, allocating it as all air if needed
+	 */
+	Section& make_section(s32 index);
+	ChunkPos get_pos() const { return pos; }
+
+private:
+	ChunkPos pos;
+	std::array<std::unique_ptr<Section>, CHUNK_SECTIONS> sections;
+};
+
+/**
+ * @brief Every loaded chunk, addressed in world block coordinates
+ */
+class ChunkStore {
+public:
+	Chunk& create(ChunkPos pos);
+	void remove(ChunkPos pos);
+
+	Chunk* get_chunk(ChunkPos pos);
+	const Chunk* get_chunk(ChunkPos pos) const;
+
+	/**
+	 * @brief Gets the section holding a world block, null when unloaded or all air
+	 * @param[in] sx Section x, world x >> 4
+	 * @param[in] sy Section y, world y >> 4
+	 * @param[in] sz Section z, world z >> 4
+	 */
+	const Section* get_section(s32 sx, s32 sy, s32 sz) const;
+
+	/**
+	 * @brief Gets a block in world coordinates, air when not loaded
+	 */
+	BlockId get_block(s32 x, s32 y, s32 z) const;
+
+	/**
+	 * @brief Sets a block in world coordinates
+	 * @return False when the chunk is not loaded
+	 */
+	bool set_block(s32 x, s32 y, s32 z, BlockId block);
+
+	size_t size() const { return chunks.size(); }
+
+	auto begin() const { return chunks.begin(); }
+	auto end() const { return chunks.end(); }
+
+private:
+	std::unordered_map<ChunkPos, std::unique_ptr<Chunk>, ChunkPosHash> chunks;
+};
+
+}	// namespace world
+}	// namespace uni
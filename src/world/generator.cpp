@@ -0,0 +1,66 @@
+/**
+ * @file src/world/generator.cpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#include "world/generator.hpp"
+
+#include <cmath>
+
+namespace uni {
+namespace world {
+
+void Generator::generate(Chunk& chunk) const {
+	ChunkPos pos = chunk.get_pos();
+	for(s32 z = 0; z < SECTION_SIZE; z++){
+		for(s32 x = 0; x < SECTION_SIZE; x++){
+			s32 wx = pos.x * SECTION_SIZE + x;
+			s32 wz = pos.z * SECTION_SIZE + z;
+			s32 top = height(wx, wz);
+			bool beach = top <= SEA_LEVEL + 1;
+
+			for(s32 y = 0; y <= top; y++){
+				BlockId block = STONE;
+				if(y > top - 4){ block = beach ? SAND : DIRT; }
+				if(y == top && !beach){ block = GRASS; }
+				chunk.set(x, y, z, block);
+			}
+			for(s32 y = top + 1; y <= SEA_LEVEL; y++){
+				chunk.set(x, y, z, WATER);
+			}
+		}
+	}
+}
+
+s32 Generator::height(s32 x, s32 z) const {
+	// Two octaves, wide hills plus small bumps
+	f32 h = value_noise(x / 64.0f, z / 64.0f, 1) * 24.0f
+	      + value_noise(x / 16.0f, z / 16.0f, 2) * 6.0f;
+	return SEA_LEVEL - 6 + static_cast<s32>(h);
+}
+
+f32 Generator::value_noise(f32 x, f32 z, u64 salt) const {
+	s32 x0 = static_cast<s32>(std::floor(x));
+	s32 z0 = static_cast<s32>(std::floor(z));
+	f32 tx = x - x0, tz = z - z0;
+	tx = tx * tx * (3.0f - 2.0f * tx);
+	tz = tz * tz * (3.0f - 2.0f * tz);
+
+	f32 a = hash(x0, z0, salt), b = hash(x0 + 1, z0, salt);
+	f32 c = hash(x0, z0 + 1, salt), d = hash(x0 + 1, z0 + 1, salt);
+	return (a + (b - a) * tx) + ((c + (d - c) * tx) - (a + (b - a) * tx)) * tz;
+}
+
+f32 Generator::hash(s32 x, s32 z, u64 salt) const {
+	u64 h = seed ^ (salt * 0x9e3779b97f4a7c15ull);
+	h ^= static_cast<u32>(x) * 0xbf58476d1ce4e5b9ull;
+	h = (h ^ (h >> 31)) * 0x94d049bb133111ebull;
+	h ^= static_cast<u32>(z) * 0xd6e8feb86659fd93ull;
+	h = (h ^ (h >> 29)) * 0xbf58476d1ce4e5b9ull;
+	h ^= h >> 32;
+	return static_cast<f32>(h & 0xffffff) / static_cast<f32>(0xffffff);
+}
+
+}	// namespace world
+}	// namespace uni
@@ -0,0 +1,47 @@
+/**
+ * @file src/world/generator.hpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#pragma once
+
+#include "world/chunk.hpp"
+
+namespace uni {
+namespace world {
+
+constexpr s32 SEA_LEVEL = 62;
+
+/**
+ * @brief Deterministic terrain generator
+ *
+ * The same seed and chunk position always produce the same blocks,
+ * which tests and benchmarks rely on.
+ */
+class Generator {
+public:
+	Generator(u64 seed) : seed{seed} {}
+
+	/**
+	 * @brief Fills a freshly created chunk with terrain
+	 * @param[out] chunk
+	 * @return void
+	 */
+	void generate(Chunk& chunk) const;
+
+	/**
+	 * @brief Terrain height at a world column
+	 * @return y of the highest solid block
+	 */
+	s32 height(s32 x, s32 z) const;
+
+private:
+	f32 value_noise(f32 x, f32 z, u64 salt) const;
+	f32 hash(s32 x, s32 z, u64 salt) const;
+
+	u64 seed;
+};
+
+}	// namespace world
+}	// namespace uni
@@ -0,0 +1,230 @@
+/**
+ * @file src/world/mesh_cache.cpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#include "world/mesh_cache.hpp"
+
+#include "util/hash.hpp"
+#include "util/util.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace uni {
+namespace world {
+
+namespace {
+
+constexpr u32 PACK_MAGIC = 0x4b504d55;      // "UMPK"
+constexpr u32 INDEX_MAGIC = 0x58494d55;     // "UMIX"
+constexpr u32 FORMAT = 2;
+
+struct FileHeader {
+	u32 magic;
+	u32 format;
+	u32 mesher;
+	u32 pad;
+};
+
+struct IndexRecord {
+	u64 key;
+	u64 offset;     // bytes into the pack
+	u32 count;
+	u32 checksum;   // of the quads, see `checksum`
+};
+static_assert(sizeof(IndexRecord) == 24, "Index records are written as is");
+
+bool write_all(int fd, const void* data, size_t size, u64 offset){
+	const u8* p = static_cast<const u8*>(data);
+	while(size > 0){
+		ssize_t written = pwrite(fd, p, size, static_cast<off_t>(offset));
+		if(written < 0 && errno == EINTR){ continue; }
+		if(written <= 0){ return false; }
+		p += written;
+		size -= static_cast<size_t>(written);
+		offset += static_cast<u64>(written);
+	}
+	return true;
+}
+
+bool read_all(int fd, void* data, size_t size, u64 offset){
+	u8* p = static_cast<u8*>(data);
+	while(size > 0){
+		ssize_t got = pread(fd, p, size, static_cast<off_t>(offset));
+		if(got < 0 && errno == EINTR){ continue; }
+		if(got <= 0){ return false; }
+		p += got;
+		size -= static_cast<size_t>(got);
+		offset += static_cast<u64>(got);
+	}
+	return true;
+}
+
+bool valid_header(int fd, u64 size, u32 magic){
+	FileHeader header;
+	if(size < sizeof(header) || !read_all(fd, &header, sizeof(header), 0)){ return false; }
+	return header.magic == magic && header.format == FORMAT && header.mesher == MESHER_VERSION;
+}
+
+int open_file(const std::string& path){
+	int fd = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+	if(fd < 0){ ERROR("MESH CACHE", "Failed to open " << path << ": " << std::strerror(errno)); }
+	return fd;
+}
+
+u32 checksum(u64 key, const ChunkQuad* quads, u32 count){
+	return static_cast<u32>(xxh64(quads, u64(count) * sizeof(ChunkQuad), key));
+}
+
+u64 file_size(int fd){
+	struct stat st;
+	return fstat(fd, &st) == 0 ? static_cast<u64>(st.st_size) : 0;
+}
+
+}	// namespace
+
+u64 mesh_key(const SectionNeighbours& section){
+	std::array<BlockId, BORDER_BLOCKS> border;
+	write_border(section, border.data());
+	u64 h = MESHER_VERSION;
+	if(section.center != nullptr){ h = xxh64(section.center->blocks.data(), sizeof(section.center->blocks), h); }
+	return xxh64(border.data(), sizeof(border), h);
+}
+
+MeshCache::MeshCache(const MeshCacheConfig& config) : config{config} {
+	std::filesystem::path parent = std::filesystem::path(config.path).parent_path();
+	std::error_code error;
+	if(!parent.empty()){ std::filesystem::create_directories(parent, error); }
+
+	pack_fd = open_file(config.path);
+	index_fd = pack_fd < 0 ? -1 : open_file(config.path + ".idx");
+	if(index_fd < 0){
+		if(pack_fd >= 0){ close(pack_fd); }
+		throw std::exception();
+	}
+	pack_size = file_size(pack_fd);
+	index_size = file_size(index_fd);
+
+	if(!valid_header(pack_fd, pack_size, PACK_MAGIC) || !valid_header(index_fd, index_size, INDEX_MAGIC)){
+		if(pack_size > 0 || index_size > 0){ WARNING("MESH CACHE", "Discarding " << config.path << ", written by another version."); }
+		reset();
+	}
+
+	mapped = static_cast<const u8*>(mmap(nullptr, config.max_bytes, PROT_READ, MAP_SHARED, pack_fd, 0));
+	if(mapped == MAP_FAILED){
+		ERROR("MESH CACHE", "Failed to map " << config.path << ": " << std::strerror(errno));
+		close(pack_fd);
+		close(index_fd);
+		throw std::exception();
+	}
+
+	// Entries are appended after their quads, the first one that is torn or points past the pack ends the index
+	std::vector<IndexRecord> records((index_size - sizeof(FileHeader)) / sizeof(IndexRecord));
+	if(!records.empty() && !read_all(index_fd, records.data(), records.size() * sizeof(IndexRecord), sizeof(FileHeader))){ records.clear(); }
+	u64 end = sizeof(FileHeader);
+	size_t valid = 0;
+	for(const IndexRecord& record : records){
+		u64 last = record.offset + u64(record.count) * sizeof(ChunkQuad);
+		if(record.offset < sizeof(FileHeader) || record.offset % sizeof(ChunkQuad) != 0 || last > pack_size || last > config.max_bytes){ break; }
+		index[record.key] = {record.offset, record.count, record.checksum, false};
+		end = std::max(end, last);
+		valid++;
+	}
+
+	index_size = sizeof(FileHeader) + valid * sizeof(IndexRecord);
+	pack_size = end;
+	if(ftruncate(index_fd, static_cast<off_t>(index_size)) != 0 || ftruncate(pack_fd, static_cast<off_t>(pack_size)) != 0){
+		WARNING("MESH CACHE", "Failed to trim " << config.path << ": " << std::strerror(errno));
+	}
+
+	stats.entries = index.size();
+	stats.bytes = pack_size;
+	INFO("MESH CACHE", "Opened " << config.path << " with " << index.size() << " meshes.");
+}
+
+MeshCache::~MeshCache(){
+	munmap(const_cast<u8*>(mapped), config.max_bytes);
+	close(index_fd);
+	close(pack_fd);
+}
+
+void MeshCache::reset(){
+	FileHeader pack_header = {PACK_MAGIC, FORMAT, MESHER_VERSION, 0};
+	FileHeader index_header = {INDEX_MAGIC, FORMAT, MESHER_VERSION, 0};
+	if(ftruncate(pack_fd, 0) != 0 || ftruncate(index_fd, 0) != 0
+		|| !write_all(pack_fd, &pack_header, sizeof(pack_header), 0)
+		|| !write_all(index_fd, &index_header, sizeof(index_header), 0)){
+		ERROR("MESH CACHE", "Failed to create " << config.path << ": " << std::strerror(errno));
+		close(pack_fd);
+		close(index_fd);
+		throw std::exception();
+	}
+	pack_size = sizeof(FileHeader);
+	index_size = sizeof(FileHeader);
+}
+
+CachedMesh MeshCache::find(u64 key){
+	stats.lookups++;
+	auto it = index.find(key);
+	if(it == index.end()){ return {}; }
+	const ChunkQuad* quads = reinterpret_cast<const ChunkQuad*>(mapped + it->second.offset);
+
+	// Quads lost in a crash read back as whatever the disk holds, the next insert appends them again
+	if(!it->second.verified){
+		if(checksum(key, quads, it->second.count) != it->second.checksum){
+			WARNING("MESH CACHE", "Dropping corrupt mesh at " << it->second.offset << " in " << config.path);
+			index.erase(it);
+			stats.entries = index.size();
+			return {};
+		}
+		it->second.verified = true;
+	}
+	stats.hits++;
+	return {true, quads, it->second.count};
+}
+
+bool MeshCache::insert(u64 key, const std::vector<ChunkQuad>& quads){
+	if(index.count(key)){ return true; }
+	u64 bytes = quads.size() * sizeof(ChunkQuad);
+	if(pack_size + bytes > config.max_bytes){ return false; }
+
+	// A failed write leaves bytes past `pack_size` that the next insert overwrites
+	IndexRecord record = {key, pack_size, static_cast<u32>(quads.size()), checksum(key, quads.data(), static_cast<u32>(quads.size()))};
+	if(bytes > 0 && !write_all(pack_fd, quads.data(), bytes, pack_size)){ return false; }
+	if(!write_all(index_fd, &record, sizeof(record), index_size)){ return false; }
+
+	index[key] = {pack_size, record.count, record.checksum, true};
+	pack_size += bytes;
+	index_size += sizeof(record);
+	stats.inserts++;
+	stats.entries = index.size();
+	stats.bytes = pack_size;
+	return true;
+}
+
+CachedMesh MeshCache::mesh(const SectionNeighbours& section){
+	u64 key = mesh_key(section);
+	CachedMesh cached = find(key);
+	if(cached.hit){ return cached; }
+
+	mesh_section(section, scratch);
+	if(insert(key, scratch)){
+		const Entry& entry = index[key];
+		return {false, reinterpret_cast<const ChunkQuad*>(mapped + entry.offset), entry.count};
+	}
+	return {false, scratch.data(), static_cast<u32>(scratch.size())};
+}
+
+}	// namespace world
+}	// namespace uni
@@ -0,0 +1,132 @@
+/**
+ * @file src/world/mesh_cache.hpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#pragma once
+
+#include "world/mesher.hpp"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace uni {
+namespace world {
+
+/**
+ * @brief Key of a section's mesh, the XXH64 of everything the mesh depends on
+ *
+ * Hashes the section's blocks, the border slices of its neighbours and
+ * `MESHER_VERSION`. Sections with equal keys mesh to the same quads.
+ */
+u64 mesh_key(const SectionNeighbours& section);
+
+struct MeshCacheConfig {
+	std::string path = "cache/meshes.pack";     // the index is `path` + ".idx"
+	u64 max_bytes = 1ull << 30;                 // size the pack may grow to, mapped up front
+};
+
+struct MeshCacheStats {
+	u64 lookups = 0;
+	u64 hits = 0;
+	u64 inserts = 0;
+	u64 entries = 0;
+	u64 bytes = 0;              // pack file size
+
+	f64 hit_rate() const { return lookups ? f64(hits) / f64(lookups) : 0.0; }
+};
+
+/**
+ * @brief Quads of a cached mesh, pointing into the mapped pack
+ *
+ * Valid as long as the cache is.
+ */
+struct CachedMesh {
+	bool hit = false;
+	const ChunkQuad* quads = nullptr;
+	u32 count = 0;
+};
+
+/**
+ * @brief Section meshes kept on disk between sessions
+ *
+ * Meshes are appended to a pack file that is memory mapped read only,
+ * so a hit hands out the quads where they lie without copying or
+ * parsing them. An index file next to it lists the key, offset and quad
+ * count of every mesh and is loaded into a hash map on open.
+ *
+ * Both files are only ever appended to. A mesh is written to the pack
+ * before its index entry, an interrupted write leaves an index entry
+ * pointing past the pack or a torn entry, which are dropped on open
+ * together with the pack bytes nothing points to. Nothing is synced, so
+ * after a crash an entry may point at quads that never reached the disk.
+ * Each entry holds a checksum of its quads that the first hit verifies,
+ * a mismatch is a miss and the mesh is cached again. Files written by
+ * another mesher version are discarded.
+ *
+ * @note Not thread safe
+ */
+class MeshCache {
+public:
+	MeshCache(const MeshCache&) = delete;
+	MeshCache& operator=(const MeshCache&) = delete;
+
+	MeshCache(const MeshCacheConfig& config);
+
+	~MeshCache();
+
+	/**
+	 * @brief Looks up a mesh
+	 * @param[in] key From `mesh_key`
+	 */
+	CachedMesh find(u64 key);
+
+	/**
+	 * @brief Appends a mesh, a key that is already cached is left as is
+	 * @param[in] key
+	 * @param[in] quads
+	 * @return False when the pack is full or the write failed
+	 */
+	bool insert(u64 key, const std::vector<ChunkQuad>& quads);
+
+	/**
+	 * @brief Cached mesh of a section, meshing and caching it on a miss
+	 *
+	 * Misses are meshed with `mesh_section`. When the mesh cannot be
+	 * cached the result points at scratch memory valid until the next call.
+	 *
+	 * @param[in] section
+	 * @return `hit` tells whether meshing was skipped
+	 */
+	CachedMesh mesh(const SectionNeighbours& section);
+
+	const MeshCacheConfig& get_config() const { return config; }
+	const MeshCacheStats& get_stats() const { return stats; }
+
+private:
+	struct Entry {
+		u64 offset;
+		u32 count;
+		u32 checksum;
+		bool verified;      // quads matched the checksum once, or were written by this process
+	};
+
+	void reset();
+
+	MeshCacheConfig config;
+	int pack_fd = -1;
+	int index_fd = -1;
+	const u8* mapped = nullptr;
+	u64 pack_size = 0;
+	u64 index_size = 0;
+
+	std::unordered_map<u64, Entry> index;
+	std::vector<ChunkQuad> scratch;
+
+	MeshCacheStats stats;
+};
+
+}	// namespace world
+}	// namespace uni
@@ -0,0 +1,88 @@
+/**
+ * @file src/world/mesher.cpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#include "world/mesher.hpp"
+
+#include <algorithm>
+
+namespace uni {
+namespace world {
+
+namespace {
+
+constexpr s32 FACE_OFFSETS[6][3] = {
+	{-1, 0, 0}, {1, 0, 0},
+	{0, -1, 0}, {0, 1, 0},
+	{0, 0, -1}, {0, 0, 1},
+};
+
+}	// namespace
+
+SectionNeighbours gather_neighbours(const ChunkStore& store, s32 sx, s32 sy, s32 sz){
+	SectionNeighbours result;
+	result.center = store.get_section(sx, sy, sz);
+	for(s32 f = 0; f < 6; f++){
+		s32 ny = sy + FACE_OFFSETS[f][1];
+		if(ny < 0 || ny >= CHUNK_SECTIONS){ continue; }
+		result.sides[f] = store.get_section(sx + FACE_OFFSETS[f][0], ny, sz + FACE_OFFSETS[f][2]);
+	}
+	return result;
+}
+
+void write_border(const SectionNeighbours& section, BlockId* out){
+	std::fill(out, out + BORDER_BLOCKS, AIR);
+	for(s32 f = 0; f < 6; f++){
+		const Section* side = section.sides[f];
+		if(side == nullptr){ continue; }
+		s32 axis = f >> 1;
+		s32 c[3];
+		c[axis] = (f & 1) ? 0 : SECTION_SIZE - 1;
+		for(s32 v = 0; v < SECTION_SIZE; v++){
+			for(s32 u = 0; u < SECTION_SIZE; u++){
+				c[(axis + 1) % 3] = u;
+				c[(axis + 2) % 3] = v;
+				out[f * 256 + v * 16 + u] = side->get(c[0], c[1], c[2]);
+			}
+		}
+	}
+}
+
+u32 max_quads(const Section& section){
+	u32 transparent = 0;
+	for(BlockId block : section.blocks){ transparent += !is_opaque(block); }
+	u32 surface = 6 * SECTION_SIZE * SECTION_SIZE;
+	return std::min(6u * section.non_air, 6u * transparent + surface);
+}
+
+void mesh_section(const SectionNeighbours& section, std::vector<ChunkQuad>& quads){
+	quads.clear();
+	if(section.center == nullptr || section.center->empty()){ return; }
+	const Section& center = *section.center;
+
+	for(s32 y = 0; y < SECTION_SIZE; y++){
+		for(s32 z = 0; z < SECTION_SIZE; z++){
+			for(s32 x = 0; x < SECTION_SIZE; x++){
+				BlockId block = center.get(x, y, z);
+				if(block == AIR){ continue; }
+
+				for(s32 f = 0; f < 6; f++){
+					s32 nx = x + FACE_OFFSETS[f][0], ny = y + FACE_OFFSETS[f][1], nz = z + FACE_OFFSETS[f][2];
+					BlockId neighbour;
+					if(nx >= 0 && nx < SECTION_SIZE && ny >= 0 && ny < SECTION_SIZE && nz >= 0 && nz < SECTION_SIZE){
+						neighbour = center.get(nx, ny, nz);
+					} else {
+						const Section* side = section.sides[f];
+						neighbour = side ? side->get(nx & 15, ny & 15, nz & 15) : AIR;
+					}
+					if(face_visible(block, neighbour)){ quads.push_back(pack_quad(x, y, z, f, block)); }
+				}
+			}
+		}
+	}
+}
+
+}	// namespace world
+}	// namespace uni
@@ -0,0 +1,102 @@
+/**
+ * @file src/world/mesher.hpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#pragma once
+
+#include "world/chunk.hpp"
+
+#include <vector>
+
+namespace uni {
+namespace world {
+
+/**
+ * @brief Version of the meshers' output
+ *
+ * Must be bumped whenever either mesher emits different quads for the
+ * same blocks, meshes cached on disk under an older version are ignored.
+ */
+constexpr u32 MESHER_VERSION = 1;
+
+/**
+ * @brief One visible block face packed into 32 bits
+ *
+ * Bits 0..11 are the block's x, y and z inside its section, 12..14 the
+ * face (0..5 for -x, +x, -y, +y, -z, +z like `RayHit::face`) and
+ * 16..31 the block. The GPU mesher writes the exact same encoding.
+ */
+using ChunkQuad = u32;
+
+inline ChunkQuad pack_quad(s32 x, s32 y, s32 z, s32 face, BlockId block){
+	return static_cast<u32>(x) | static_cast<u32>(y) << 4 | static_cast<u32>(z) << 8 | static_cast<u32>(face) << 12 | static_cast<u32>(block) << 16;
+}
+
+/**
+ * @brief A section and the six it touches, in face order, null is all air
+ */
+struct SectionNeighbours {
+	const Section* center = nullptr;
+	const Section* sides[6] = {};
+};
+
+/**
+ * @brief Looks up a section and its neighbours
+ * @param[in] store
+ * @param[in] sx Section coordinates, world block coordinates >> 4
+ * @param[in] sy
+ * @param[in] sz
+ */
+SectionNeighbours gather_neighbours(const ChunkStore& store, s32 sx, s32 sy, s32 sz);
+
+// The layer of each neighbour touching a section, 16x16 blocks per face
+constexpr s32 BORDER_BLOCKS = 6 * SECTION_SIZE * SECTION_SIZE;
+
+/**
+ * @brief Copies the blocks of the neighbours that touch the section
+ *
+ * Face f lies along axis a = f / 2, block (u, v) of it is at index
+ * f * 256 + v * 16 + u with u and v the coordinates along axes a + 1
+ * and a + 2. Missing neighbours are air. Everything outside the section
+ * the mesh of a section depends on.
+ *
+ * @param[in] section
+ * @param[out] out `BORDER_BLOCKS` blocks
+ * @return void
+ */
+void write_border(const SectionNeighbours& section, BlockId* out);
+
+/**
+ * @brief Whether a block shows its face towards a neighbour
+ *
+ * Faces are hidden by opaque blocks and by the same transparent block,
+ * so water has no faces inside a lake, whatever the levels in it.
+ */
+inline bool face_visible(BlockId block, BlockId neighbour){
+	return block != AIR && !is_opaque(neighbour) && neighbour != block && !(is_water(block) && is_water(neighbour));
+}
+
+/**
+ * @brief Upper bound on the quads of a section, without meshing it
+ *
+ * Every face borders a block that is not opaque, so a section has at
+ * most six faces per block that is not opaque plus one per block on its
+ * surface.
+ */
+u32 max_quads(const Section& section);
+
+/**
+ * @brief Emits every visible face of a section
+ *
+ * The CPU reference mesher, faces are culled one by one with no merging.
+ *
+ * @param[in] section
+ * @param[out] quads Cleared first, in block index then face order
+ * @return void
+ */
+void mesh_section(const SectionNeighbours& section, std::vector<ChunkQuad>& quads);
+
+}	// namespace world
+}	// namespace uni
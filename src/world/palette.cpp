@@ -0,0 +1,73 @@
+/**
+ * @file src/world/palette.cpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#include "world/palette.hpp"
+
+namespace uni {
+namespace world {
+
+namespace {
+
+constexpr u16 NOT_IN_PALETTE = 0xffff;
+
+/**
+ * @brief Palette slot of every block id, kept all NOT_IN_PALETTE between calls
+ *
+ * Block ids are small, a flat table beats hashing 4096 times.
+ */
+std::array<u16, 1 << 16>& palette_lookup(){
+	static thread_local std::unique_ptr<std::array<u16, 1 << 16>> table;
+	if(!table){
+		table = std::make_unique<std::array<u16, 1 << 16>>();
+		table->fill(NOT_IN_PALETTE);
+	}
+	return *table;
+}
+
+}	// namespace
+
+void encode_section(const Section& section, PalettedSection& out){
+	out.palette.clear();
+	out.words.clear();
+
+	auto& lookup = palette_lookup();
+	std::array<u16, SECTION_VOLUME> indices;
+	for(s32 i = 0; i < SECTION_VOLUME; i++){
+		u16& slot = lookup[section.blocks[i]];
+		if(slot == NOT_IN_PALETTE){
+			slot = static_cast<u16>(out.palette.size());
+			out.palette.push_back(section.blocks[i]);
+		}
+		indices[i] = slot;
+	}
+	for(BlockId block : out.palette){ lookup[block] = NOT_IN_PALETTE; }
+
+	out.bits = palette_bits(out.palette.size());
+	if(out.bits == 0){ return; }
+
+	u32 per_word = 64 / out.bits;
+	out.words.assign(palette_words(out.bits), 0);
+	for(s32 i = 0; i < SECTION_VOLUME; i++){
+		out.words[i / per_word] |= u64(indices[i]) << ((i % per_word) * out.bits);
+	}
+}
+
+void decode_section(const PalettedSection& in, Section& section){
+	if(in.bits == 0){
+		section.blocks.fill(in.palette.empty() ? AIR : in.palette[0]);
+	} else {
+		u32 per_word = 64 / in.bits;
+		u64 mask = (u64(1) << in.bits) - 1;
+		for(s32 i = 0; i < SECTION_VOLUME; i++){
+			u64 index = (in.words[i / per_word] >> ((i % per_word) * in.bits)) & mask;
+			section.blocks[i] = index < in.palette.size() ? in.palette[index] : AIR;
+		}
+	}
+	section.recount();
+}
+
+}	// namespace world
+}	// namespace uni
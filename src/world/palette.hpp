@@ -0,0 +1,67 @@
+/**
+ * @file src/world/palette.hpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#pragma once
+
+#include "world/chunk.hpp"
+
+#include <vector>
+
+namespace uni {
+namespace world {
+
+/**
+ * @brief Section stored as a palette and packed palette indices
+ *
+ * Each block is an index into `palette` of `bits` bits. Indices are
+ * packed `64 / bits` to a word and never span two words, so any block
+ * can be unpacked with one shift and mask. A section of a single block
+ * type has `bits` 0 and no words.
+ */
+struct PalettedSection {
+	std::vector<BlockId> palette;
+	u8 bits = 0;
+	std::vector<u64> words;
+
+	size_t byte_size() const { return palette.size() * sizeof(BlockId) + words.size() * sizeof(u64); }
+};
+
+/**
+ * @brief Bits per index for a palette of `size` entries
+ */
+inline u8 palette_bits(size_t size){
+	u8 bits = 0;
+	while((size_t(1) << bits) < size){ bits++; }
+	return bits;
+}
+
+/**
+ * @brief Number of words holding a section's indices
+ */
+inline size_t palette_words(u8 bits){
+	if(bits == 0){ return 0; }
+	size_t per_word = 64 / bits;
+	return (SECTION_VOLUME + per_word - 1) / per_word;
+}
+
+/**
+ * @brief Compresses a section
+ * @param[in] section
+ * @param[out] out
+ * @return void
+ */
+void encode_section(const Section& section, PalettedSection& out);
+
+/**
+ * @brief Expands a section, `occupancy` and `non_air` are recomputed
+ * @param[in] in
+ * @param[out] section
+ * @return void
+ */
+void decode_section(const PalettedSection& in, Section& section);
+
+}	// namespace world
+}	// namespace uni
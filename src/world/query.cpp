@@ -0,0 +1,321 @@
+/**
+ * @file src/world/query.cpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#include "world/query.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <limits>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace uni {
+namespace world {
+
+namespace {
+
+constexpr f32 INF = std::numeric_limits<f32>::infinity();
+constexpr f32 EPS = 1e-5f;
+
+/**
+ * @brief Remembers the last chunk looked up
+ *
+ * Queries walk neighbouring blocks, nearly every lookup lands in the
+ * same chunk as the one before it.
+ */
+class SectionCache {
+public:
+	SectionCache(const ChunkStore& store) : store{&store} {}
+
+	const Section* section(s32 x, s32 y, s32 z){
+		if(y < 0 || y >= CHUNK_HEIGHT){ return nullptr; }
+		s32 cx = x >> 4, cz = z >> 4;
+		if(cx != last_x || cz != last_z){
+			chunk = store->get_chunk({cx, cz});
+			last_x = cx;
+			last_z = cz;
+		}
+		return chunk ? chunk->get_section(y >> 4) : nullptr;
+	}
+
+	/**
+	 * @brief Solid test that rejects empty bricks without reading blocks
+	 */
+	BlockId solid(s32 x, s32 y, s32 z){
+		const Section* s = section(x, y, z);
+		if(s == nullptr || !(s->occupancy & brick_bit(x & 15, y & 15, z & 15))){ return AIR; }
+		BlockId block = s->get(x & 15, y & 15, z & 15);
+		return is_solid(block) ? block : AIR;
+	}
+
+private:
+	const ChunkStore* store;
+	const Chunk* chunk = nullptr;
+	s32 last_x = INT_MIN, last_z = INT_MIN;
+};
+
+/**
+ * @brief Initial DDA state of one ray
+ *
+ * Shared by the scalar and batched paths so both do the exact same math.
+ */
+struct DdaSetup {
+	s32 pos[3];
+	s32 step[3];
+	f32 tmax[3];
+	f32 tdelta[3];
+};
+
+void setup_dda(const Ray& ray, DdaSetup& s){
+	for(int a = 0; a < 3; a++){
+		f32 o = ray.origin[a], d = ray.direction[a];
+		s.pos[a] = static_cast<s32>(std::floor(o));
+		if(d > 0.0f){
+			s.step[a] = 1;
+			s.tdelta[a] = 1.0f / d;
+			s.tmax[a] = (s.pos[a] + 1 - o) * s.tdelta[a];
+		} else if(d < 0.0f){
+			s.step[a] = -1;
+			s.tdelta[a] = -1.0f / d;
+			s.tmax[a] = (o - s.pos[a]) * s.tdelta[a];
+		} else {
+			s.step[a] = 0;
+			s.tdelta[a] = INF;
+			s.tmax[a] = INF;
+		}
+	}
+}
+
+inline s32 min_axis(f32 x, f32 y, f32 z){
+	return (x <= y && x <= z) ? 0 : (y <= z ? 1 : 2);
+}
+
+/**
+ * @brief Distance a box can travel along one axis before touching a solid block
+ * @param[in] d Desired travel, signed
+ * @return Allowed travel, same sign as `d` or zero
+ */
+f32 clip_axis(SectionCache& cache, const Aabb& box, int axis, f32 d){
+	if(d == 0.0f){ return 0.0f; }
+
+	int a1 = (axis + 1) % 3, a2 = (axis + 2) % 3;
+	s32 lo1 = static_cast<s32>(std::floor(box.min[a1] + EPS)), hi1 = static_cast<s32>(std::floor(box.max[a1] - EPS));
+	s32 lo2 = static_cast<s32>(std::floor(box.min[a2] + EPS)), hi2 = static_cast<s32>(std::floor(box.max[a2] - EPS));
+
+	auto row_blocked = [&](s32 i){
+		s32 p[3];
+		p[axis] = i;
+		for(p[a1] = lo1; p[a1] <= hi1; p[a1]++){
+			for(p[a2] = lo2; p[a2] <= hi2; p[a2]++){
+				if(cache.solid(p[0], p[1], p[2]) != AIR){ return true; }
+			}
+		}
+		return false;
+	};
+
+	if(d > 0.0f){
+		s32 start = static_cast<s32>(std::ceil(box.max[axis] - EPS));
+		s32 end = static_cast<s32>(std::ceil(box.max[axis] + d)) - 1;
+		for(s32 i = start; i <= end; i++){
+			if(row_blocked(i)){ return std::max(0.0f, i - box.max[axis]); }
+		}
+	} else {
+		s32 start = static_cast<s32>(std::floor(box.min[axis] + EPS)) - 1;
+		s32 end = static_cast<s32>(std::floor(box.min[axis] + d));
+		for(s32 i = start; i >= end; i--){
+			if(row_blocked(i)){ return std::min(0.0f, (i + 1) - box.min[axis]); }
+		}
+	}
+	return d;
+}
+
+void move_aabb(SectionCache& cache, AabbMove& move){
+	move.blocked = 0;
+	move.moved = {};
+	for(int axis : {1, 0, 2}){
+		f32 d = clip_axis(cache, move.box, axis, move.delta[axis]);
+		move.box.min[axis] += d;
+		move.box.max[axis] += d;
+		move.moved[axis] = d;
+		if(d != move.delta[axis]){ move.blocked |= 1 << axis; }
+	}
+}
+
+constexpr size_t L = RAY_LANES;
+typedef f32 f32xL __attribute__((vector_size(L * sizeof(f32))));
+typedef s32 s32xL __attribute__((vector_size(L * sizeof(s32))));
+
+/**
+ * @brief One bit per lane set where the comparison result is true
+ */
+inline u32 lane_mask(s32xL m){
+#if defined(__AVX__)
+	return static_cast<u32>(_mm256_movemask_ps(reinterpret_cast<__m256>(m)));
+#elif defined(__SSE2__)
+	return static_cast<u32>(_mm_movemask_ps(reinterpret_cast<__m128>(m)));
+#else
+	u32 mask = 0;
+	for(size_t l = 0; l < L; l++){ mask |= static_cast<u32>(m[l] != 0) << l; }
+	return mask;
+#endif
+}
+
+}	// namespace
+
+RayHit raycast(const ChunkStore& store, const Ray& ray){
+	SectionCache cache(store);
+	DdaSetup s;
+	setup_dda(ray, s);
+
+	RayHit result;
+	f32 t = 0.0f;
+	s8 face = -1;
+	for(;;){
+		BlockId block = cache.solid(s.pos[0], s.pos[1], s.pos[2]);
+		if(block != AIR){
+			result.hit = true;
+			result.x = s.pos[0];
+			result.y = s.pos[1];
+			result.z = s.pos[2];
+			result.face = face;
+			result.block = block;
+			result.distance = t;
+			return result;
+		}
+
+		s32 axis = min_axis(s.tmax[0], s.tmax[1], s.tmax[2]);
+		t = s.tmax[axis];
+		if(t > ray.max_distance){ return result; }
+		s.pos[axis] += s.step[axis];
+		s.tmax[axis] += s.tdelta[axis];
+		face = static_cast<s8>(axis * 2 + (s.step[axis] > 0 ? 0 : 1));
+	}
+}
+
+void raycast_batch(const ChunkStore& store, const Ray* rays, RayHit* hits, size_t count){
+	constexpr size_t L = RAY_LANES;
+
+	std::vector<SectionCache> caches(L, SectionCache(store));
+
+	for(size_t base = 0; base < count; base += L){
+		size_t n = std::min(L, count - base);
+
+		f32xL tmax[3], tdelta[3], t = {}, max_distance;
+		s32xL pos[3], step[3], face;
+		u32 active = 0;
+
+		for(size_t l = 0; l < L; l++){
+			DdaSetup s{};
+			if(l < n){
+				setup_dda(rays[base + l], s);
+				max_distance[l] = rays[base + l].max_distance;
+				hits[base + l] = {};
+				active |= 1u << l;
+			} else {
+				// Padding lanes never step anywhere and are never active
+				for(int a = 0; a < 3; a++){ s.tmax[a] = INF; }
+				max_distance[l] = -1.0f;
+			}
+			for(int a = 0; a < 3; a++){
+				pos[a][l] = s.pos[a];
+				step[a][l] = s.step[a];
+				tmax[a][l] = s.tmax[a];
+				tdelta[a][l] = s.tdelta[a];
+			}
+			face[l] = -1;
+		}
+
+		/*
+		 * Region each lane last found empty, a brick (shift 2) or a whole
+		 * section (shift 4). Lanes still inside it skip the block lookup.
+		 */
+		s32xL empty[3], shift;
+		for(int a = 0; a < 3; a++){ empty[a] = (pos[a] & 0) + INT_MIN; }
+		shift = pos[0] & 0;
+
+		const f32xL zero = {};
+		while(active){
+			s32xL same = ((pos[0] >> shift) == empty[0]) & ((pos[1] >> shift) == empty[1]) & ((pos[2] >> shift) == empty[2]);
+			u32 lookup = ~lane_mask(same) & ((1u << L) - 1);
+
+			// Gather, the only per lane scalar part
+			for(u32 bits = active & lookup; bits; bits &= bits - 1){
+				u32 l = __builtin_ctz(bits);
+				s32 x = pos[0][l], y = pos[1][l], z = pos[2][l];
+				const Section* section = caches[l].section(x, y, z);
+				if(section == nullptr){
+					shift[l] = 4;
+				} else if(!(section->occupancy & brick_bit(x & 15, y & 15, z & 15))){
+					shift[l] = 2;
+				} else {
+					shift[l] = 0;
+					BlockId block = section->get(x & 15, y & 15, z & 15);
+					if(is_solid(block)){
+						RayHit& hit = hits[base + l];
+						hit.hit = true;
+						hit.x = x;
+						hit.y = y;
+						hit.z = z;
+						hit.face = static_cast<s8>(face[l]);
+						hit.block = block;
+						hit.distance = t[l];
+						active &= ~(1u << l);
+					}
+				}
+				empty[0][l] = x >> shift[l];
+				empty[1][l] = y >> shift[l];
+				empty[2][l] = z >> shift[l];
+				if(shift[l] == 0){ empty[0][l] = INT_MIN; }
+			}
+			if(!active){ break; }
+
+			// Step every lane at once, same axis choice as `min_axis`
+			s32xL sx = (tmax[0] <= tmax[1]) & (tmax[0] <= tmax[2]);
+			s32xL sy = ~sx & (tmax[1] <= tmax[2]);
+			s32xL sz = ~(sx | sy);
+
+			t = sx ? tmax[0] : (sy ? tmax[1] : tmax[2]);
+			pos[0] += step[0] & sx;
+			pos[1] += step[1] & sy;
+			pos[2] += step[2] & sz;
+			tmax[0] += sx ? tdelta[0] : zero;
+			tmax[1] += sy ? tdelta[1] : zero;
+			tmax[2] += sz ? tdelta[2] : zero;
+
+			s32xL axis_step = (step[0] & sx) | (step[1] & sy) | (step[2] & sz);
+			face = (sy & 2) | (sz & 4) | (axis_step < 0 ? 1 : 0);
+
+			active &= ~lane_mask(t > max_distance);
+		}
+	}
+}
+
+void move_aabb(const ChunkStore& store, AabbMove& move){
+	SectionCache cache(store);
+	move_aabb(cache, move);
+}
+
+void move_aabb_batch(const ChunkStore& store, AabbMove* moves, size_t count){
+	// Visit entities chunk by chunk so the cache keeps hitting
+	std::vector<std::pair<u64, u32>> order(count);
+	for(size_t i = 0; i < count; i++){
+		s32 cx = static_cast<s32>(std::floor(moves[i].box.min.x)) >> 4;
+		s32 cz = static_cast<s32>(std::floor(moves[i].box.min.z)) >> 4;
+		order[i] = {static_cast<u64>(static_cast<u32>(cx)) << 32 | static_cast<u32>(cz), static_cast<u32>(i)};
+	}
+	std::sort(order.begin(), order.end());
+
+	SectionCache cache(store);
+	for(const auto& [key, index] : order){
+		move_aabb(cache, moves[index]);
+	}
+}
+
+}	// namespace world
+}	// namespace uni
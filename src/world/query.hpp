@@ -0,0 +1,112 @@
+/**
+ * @file src/world/query.hpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#pragma once
+
+#include "world/chunk.hpp"
+
+#include "util/math.hpp"
+
+#include <cstddef>
+
+namespace uni {
+namespace world {
+
+struct Ray {
+	Vec3 origin;
+	Vec3 direction;     // need not be normalized, distances are in units of its length
+	f32 max_distance;
+};
+
+/**
+ * @brief Result of a raycast
+ *
+ * `face` is the face of the hit block the ray entered through,
+ * 0..5 for -x, +x, -y, +y, -z, +z, or -1 when the ray starts inside it.
+ */
+struct RayHit {
+	bool hit = false;
+	s32 x = 0, y = 0, z = 0;
+	s8 face = -1;
+	BlockId block = AIR;
+	f32 distance = 0.0f;
+};
+
+struct Aabb {
+	Vec3 min;
+	Vec3 max;
+};
+
+/**
+ * @brief One entity's movement for `move_aabb_batch`
+ *
+ * `box` and `delta` are inputs, `box` is moved in place. `moved` is the
+ * movement actually applied and `blocked` has bit n set when axis n
+ * (x, y, z) was stopped by a block.
+ */
+struct AabbMove {
+	Aabb box;
+	Vec3 delta;
+	Vec3 moved;
+	u8 blocked = 0;
+};
+
+/**
+ * @brief Casts one ray through the voxel grid with a 3D DDA
+ *
+ * Scalar reference, `raycast_batch` must return identical results.
+ *
+ * @param[in] store
+ * @param[in] ray
+ * @return First solid block along the ray within `max_distance`
+ */
+RayHit raycast(const ChunkStore& store, const Ray& ray);
+
+/**
+ * @brief Casts many rays, stepping packets of rays side by side
+ *
+ * Rays are processed in packets of `RAY_LANES` with their DDA state in
+ * struct of arrays form so the stepping math runs across SIMD lanes.
+ *
+ * @param[in] store
+ * @param[in] rays
+ * @param[out] hits One per ray
+ * @param[in] count
+ * @return void
+ */
+void raycast_batch(const ChunkStore& store, const Ray* rays, RayHit* hits, size_t count);
+
+// One native vector of floats
+#ifdef __AVX__
+constexpr size_t RAY_LANES = 8;
+#else
+constexpr size_t RAY_LANES = 4;
+#endif
+
+/**
+ * @brief Moves a box through the world, stopping at solid blocks
+ *
+ * Axes are resolved one after the other, y first, so boxes slide along
+ * walls and floors. Bricks with a clear occupancy bit are skipped
+ * without reading blocks.
+ *
+ * @param[in] store
+ * @param[in,out] move
+ * @return void
+ */
+void move_aabb(const ChunkStore& store, AabbMove& move);
+
+/**
+ * @brief Moves many boxes, ordered by chunk so section lookups are shared
+ * @param[in] store
+ * @param[in,out] moves
+ * @param[in] count
+ * @return void
+ */
+void move_aabb_batch(const ChunkStore& store, AabbMove* moves, size_t count);
+
+}	// namespace world
+}	// namespace uni
@@ -0,0 +1,332 @@
+/**
+ * @file src/world/simulation.cpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#include "world/simulation.hpp"
+
+#include "util/util.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <tuple>
+
+namespace uni {
+namespace world {
+
+namespace {
+
+// Higher wins when two changes land on the same block
+constexpr u16 PRIORITY_FLUID = 0x100;   // plus the water level
+constexpr u16 PRIORITY_GROW = 0x200;
+constexpr u16 PRIORITY_FALL = 0x300;
+
+constexpr s32 HORIZONTAL[4][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+
+u64 mix(u64 z){
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+	return z ^ (z >> 31);
+}
+
+u64 section_key(s32 sx, s32 sy, s32 sz){
+	return static_cast<u64>(static_cast<u32>(sx) & 0x0fffffff) << 36 | static_cast<u64>(static_cast<u32>(sz) & 0x0fffffff) << 8 | static_cast<u32>(sy);
+}
+
+/**
+ * @brief Read only block access that remembers the last chunk
+ */
+class BlockReader {
+public:
+	BlockReader(const ChunkStore& store) : store{&store} {}
+
+	BlockId get(s32 x, s32 y, s32 z){
+		if(y < 0 || y >= CHUNK_HEIGHT){ return AIR; }
+		s32 cx = x >> 4, cz = z >> 4;
+		if(cx != last_x || cz != last_z){
+			chunk = store->get_chunk({cx, cz});
+			last_x = cx;
+			last_z = cz;
+		}
+		return chunk ? chunk->get(x & 15, y, z & 15) : AIR;
+	}
+
+private:
+	const ChunkStore* store;
+	const Chunk* chunk = nullptr;
+	s32 last_x = INT_MIN, last_z = INT_MIN;
+};
+
+/**
+ * @brief Water level a block should have given its neighbours
+ * @return The level, or -1 for blocks water cannot flow into
+ */
+s32 fluid_target(BlockReader& reader, s32 x, s32 y, s32 z, BlockId block){
+	if(block == WATER){ return 8; }
+	if(block != AIR && !is_water(block)){ return -1; }
+
+	s32 level = is_water(reader.get(x, y + 1, z)) ? 7 : 0;
+	for(const auto& d : HORIZONTAL){
+		BlockId neighbour = reader.get(x + d[0], y, z + d[1]);
+		s32 l = water_level(neighbour);
+		if(l < 2){ continue; }
+		// Flowing water only spreads sideways once it rests on something
+		if(neighbour == WATER || is_solid(reader.get(x + d[0], y - 1, z + d[1]))){
+			level = std::max(level, l - 1);
+		}
+	}
+	return level;
+}
+
+bool can_fall_into(BlockId block){
+	return block == AIR || is_water(block);
+}
+
+}	// namespace
+
+Simulation::Simulation(ChunkStore& store, ThreadPool& pool, const SimulationConfig& config) : store{store}, pool{pool}, config{config} {
+	if(config.region_chunks == 0 || (config.region_chunks & (config.region_chunks - 1))){
+		ERROR("SIMULATION", "Region size " << config.region_chunks << " is not a power of two.");
+		throw std::exception();
+	}
+	while((1u << region_shift) < config.region_chunks){ region_shift++; }
+}
+
+bool Simulation::set_block(s32 x, s32 y, s32 z, BlockId block){
+	if(!store.set_block(x, y, z, block)){ return false; }
+	notify(x, y, z);
+	return true;
+}
+
+void Simulation::notify(s32 x, s32 y, s32 z){
+	mark(x, y, z, &Dirty::updates);
+	for(s32 f = 0; f < 6; f++){
+		s32 d = (f & 1) ? 1 : -1;
+		mark(x + (f >> 1 == 0 ? d : 0), y + (f >> 1 == 1 ? d : 0), z + (f >> 1 == 2 ? d : 0), &Dirty::updates);
+	}
+}
+
+void Simulation::schedule(s32 x, s32 y, s32 z, u32 delay){
+	u64 due = time + std::max(delay, 1u);
+	wheel[due % WHEEL_SIZE].push_back({x, y, z, due});
+	stats.pending++;
+}
+
+void Simulation::mark(s32 x, s32 y, s32 z, Bitset Dirty::*set){
+	if(y < 0 || y >= CHUNK_HEIGHT){ return; }
+	s32 sx = x >> 4, sy = y >> 4, sz = z >> 4;
+	auto [it, inserted] = dirty.try_emplace(section_key(sx, sy, sz));
+	if(inserted){
+		it->second.sx = sx;
+		it->second.sy = sy;
+		it->second.sz = sz;
+	}
+	s32 index = block_index(x & 15, y & 15, z & 15);
+	(it->second.*set)[index >> 6] |= 1ull << (index & 63);
+}
+
+void Simulation::sample_random_ticks(){
+	if(config.random_ticks == 0){ return; }
+
+	/*
+	 * Every section draws the same number of positions from a counter
+	 * based hash, so the sampling is one branch free loop over all of
+	 * them. Only then are the few blocks that take random ticks looked at.
+	 */
+	std::vector<std::pair<const Section*, Dirty*>> sections;
+	std::vector<std::array<s32, 3>> coords;
+	for(const auto& [pos, chunk] : store){
+		for(s32 sy = 0; sy < CHUNK_SECTIONS; sy++){
+			const Section* section = chunk->get_section(sy);
+			if(section == nullptr || section->empty()){ continue; }
+			sections.emplace_back(section, nullptr);
+			coords.push_back({pos.x, sy, pos.z});
+		}
+	}
+
+	u32 k = config.random_ticks;
+	samples.resize(sections.size() * k);
+	u64 salt = mix(config.seed ^ time * 0x9e3779b97f4a7c15ull);
+	for(size_t i = 0; i < samples.size(); i++){
+		const auto& c = coords[i / k];
+		u64 h = mix(salt ^ section_key(c[0], c[1], c[2]) * 0xd6e8feb86659fd93ull ^ (i % k));
+		samples[i] = static_cast<u16>(h & (SECTION_VOLUME - 1));
+	}
+
+	for(size_t i = 0; i < samples.size(); i++){
+		const Section* section = sections[i / k].first;
+		u16 index = samples[i];
+		if(section->blocks[index] != GRASS){ continue; }
+		const auto& c = coords[i / k];
+		s32 x = index & 15, z = (index >> 4) & 15, y = index >> 8;
+		mark(c[0] * SECTION_SIZE + x, c[1] * SECTION_SIZE + y, c[2] * SECTION_SIZE + z, &Dirty::random);
+	}
+}
+
+void Simulation::tick(){
+	time++;
+	stats = {};
+	stats.tick = time;
+
+	// Due scheduled ticks, anything a lap or more away stays in its bucket
+	auto& bucket = wheel[time % WHEEL_SIZE];
+	size_t kept = 0;
+	for(const Scheduled& s : bucket){
+		if(s.due == time){
+			mark(s.x, s.y, s.z, &Dirty::scheduled);
+		} else {
+			bucket[kept++] = s;
+		}
+	}
+	bucket.resize(kept);
+	sample_random_ticks();
+
+	std::unordered_map<u64, Dirty> current;
+	current.swap(dirty);
+
+	// Group the work by region in a fixed order
+	std::unordered_map<u64, size_t> region_index;
+	regions.clear();
+	for(const auto& [key, d] : current){
+		u64 region = region_of(d.sx, d.sz);
+		auto [it, inserted] = region_index.try_emplace(region, regions.size());
+		if(inserted){
+			regions.emplace_back();
+			regions.back().region = region;
+		}
+		regions[it->second].sections.emplace_back(key, &d);
+	}
+	std::sort(regions.begin(), regions.end(), [](const RegionWork& a, const RegionWork& b){ return a.region < b.region; });
+	for(auto& r : regions){ std::sort(r.sections.begin(), r.sections.end()); }
+	stats.sections = static_cast<u32>(current.size());
+	stats.regions = static_cast<u32>(regions.size());
+
+	// Decide, every region reads the world as it was at the start of the tick
+	pool.parallel_for(regions.size(), [this](size_t i, u32){ run_region(regions[i]); });
+
+	// Hand every change to the region owning its block and settle conflicts
+	winners.clear();
+	for(auto& r : regions){
+		winners.insert(winners.end(), r.proposals.begin(), r.proposals.end());
+		stats.updates += r.updates;
+		stats.scheduled += r.scheduled;
+		stats.random += r.random;
+	}
+	std::sort(winners.begin(), winners.end(), [](const Proposal& a, const Proposal& b){
+		return std::tie(a.region, a.x, a.z, a.y, b.priority, b.block) < std::tie(b.region, b.x, b.z, b.y, a.priority, a.block);
+	});
+	size_t unique = 0;
+	for(size_t i = 0; i < winners.size(); i++){
+		const Proposal& p = winners[i];
+		if(unique > 0 && winners[unique - 1].x == p.x && winners[unique - 1].y == p.y && winners[unique - 1].z == p.z){
+			stats.conflicts++;
+			continue;
+		}
+		winners[unique++] = p;
+	}
+	winners.resize(unique);
+
+	// Apply, each region writes only its own chunks
+	std::vector<size_t> bounds;
+	for(size_t i = 0; i < winners.size(); i++){
+		if(i == 0 || winners[i].region != winners[i - 1].region){ bounds.push_back(i); }
+	}
+	bounds.push_back(winners.size());
+	std::vector<u8> applied(winners.size(), 0);
+	pool.parallel_for(bounds.size() - 1, [&](size_t r, u32){
+		for(size_t i = bounds[r]; i < bounds[r + 1]; i++){
+			const Proposal& p = winners[i];
+			Chunk* chunk = store.get_chunk({p.x >> 4, p.z >> 4});
+			if(chunk == nullptr || chunk->get(p.x & 15, p.y, p.z & 15) == p.block){ continue; }
+			chunk->set(p.x & 15, p.y, p.z & 15, p.block);
+			applied[i] = 1;
+		}
+	});
+
+	changes.clear();
+	for(size_t i = 0; i < winners.size(); i++){
+		if(!applied[i]){ continue; }
+		const Proposal& p = winners[i];
+		changes.push_back({p.x, p.y, p.z, p.block});
+		notify(p.x, p.y, p.z);
+	}
+	for(const auto& r : regions){
+		for(const Scheduled& s : r.schedules){ schedule(s.x, s.y, s.z, static_cast<u32>(s.due)); }
+	}
+	stats.changes = static_cast<u32>(changes.size());
+
+	stats.pending = 0;
+	for(const auto& b : wheel){ stats.pending += b.size(); }
+}
+
+void Simulation::run_region(RegionWork& work) const {
+	BlockReader reader(store);
+	work.proposals.clear();
+	work.schedules.clear();
+	work.updates = work.scheduled = work.random = 0;
+
+	auto propose = [&](s32 x, s32 y, s32 z, BlockId block, u16 priority){
+		work.proposals.push_back({region_of(x >> 4, z >> 4), x, y, z, block, priority});
+	};
+	// `due` holds the delay until the schedules are merged
+	auto later = [&](s32 x, s32 y, s32 z, u32 delay){
+		work.schedules.push_back({x, y, z, delay});
+	};
+
+	for(const auto& [key, d] : work.sections){
+		for(u32 w = 0; w < BITSET_WORDS; w++){
+			u64 any = d->updates[w] | d->scheduled[w] | d->random[w];
+			for(; any; any &= any - 1){
+				u32 bit = __builtin_ctzll(any);
+				u64 mask = 1ull << bit;
+				s32 index = static_cast<s32>(w * 64 + bit);
+				s32 x = d->sx * SECTION_SIZE + (index & 15);
+				s32 z = d->sz * SECTION_SIZE + ((index >> 4) & 15);
+				s32 y = d->sy * SECTION_SIZE + (index >> 8);
+				BlockId block = reader.get(x, y, z);
+
+				if(d->scheduled[w] & mask){
+					work.scheduled++;
+					s32 target = fluid_target(reader, x, y, z, block);
+					if(target >= 0 && target != water_level(block)){
+						propose(x, y, z, water_block(static_cast<u8>(target)), PRIORITY_FLUID + target);
+					}
+					if(block == SAND && can_fall_into(reader.get(x, y - 1, z)) && y > 0){
+						propose(x, y, z, AIR, PRIORITY_FALL);
+						propose(x, y - 1, z, SAND, PRIORITY_FALL);
+					}
+				}
+
+				if(d->updates[w] & mask){
+					work.updates++;
+					s32 target = fluid_target(reader, x, y, z, block);
+					if(target >= 0 && target != water_level(block)){ later(x, y, z, config.fluid_delay); }
+					if(block == SAND && can_fall_into(reader.get(x, y - 1, z)) && y > 0){ later(x, y, z, config.sand_delay); }
+				}
+
+				if((d->random[w] & mask) && block == GRASS){
+					work.random++;
+					if(is_opaque(reader.get(x, y + 1, z))){
+						propose(x, y, z, DIRT, PRIORITY_GROW);
+					} else {
+						u64 h = mix(config.seed ^ time * 0x9e3779b97f4a7c15ull ^ section_key(x, y, z));
+						s32 tx = x + static_cast<s32>(h % 3) - 1;
+						s32 ty = y + static_cast<s32>((h / 3) % 3) - 1;
+						s32 tz = z + static_cast<s32>((h / 9) % 3) - 1;
+						if(reader.get(tx, ty, tz) == DIRT && !is_opaque(reader.get(tx, ty + 1, tz))){
+							propose(tx, ty, tz, GRASS, PRIORITY_GROW);
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+u64 Simulation::region_of(s32 sx, s32 sz) const {
+	return static_cast<u64>(static_cast<u32>(sx >> region_shift)) << 32 | static_cast<u32>(sz >> region_shift);
+}
+
+}	// namespace world
+}	// namespace uni
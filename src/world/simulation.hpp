@@ -0,0 +1,164 @@
+/**
+ * @file src/world/simulation.hpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#pragma once
+
+#include "world/chunk.hpp"
+
+#include "util/thread_pool.hpp"
+
+#include <array>
+#include <unordered_map>
+#include <vector>
+
+namespace uni {
+namespace world {
+
+struct SimulationConfig {
+	u64 seed = 0;
+	u32 random_ticks = 3;       // samples per section per tick
+	u32 fluid_delay = 5;        // ticks flowing water waits before reacting to a neighbour
+	u32 sand_delay = 2;
+	u32 region_chunks = 4;      // side of a region in chunks, power of two
+};
+
+struct SimulationStats {
+	u64 tick = 0;
+	u32 sections = 0;           // sections with work this tick
+	u32 regions = 0;
+	u32 updates = 0;            // neighbour updates
+	u32 scheduled = 0;          // scheduled ticks that came due
+	u32 random = 0;             // random ticks that hit a block that takes them
+	u32 changes = 0;
+	u32 conflicts = 0;          // changes that lost to another change of the same block
+	u64 pending = 0;            // scheduled ticks still in the wheel
+};
+
+struct BlockChange {
+	s32 x, y, z;
+	BlockId block;
+};
+
+/**
+ * @brief Block ticks for everything that changes on its own
+ *
+ * Nothing scans the world. Blocks are visited only when marked in a
+ * section's dirty bitset, either by a neighbour changing, by a scheduled
+ * tick coming due in the timing wheel, or by random tick sampling.
+ *
+ * A tick runs in two phases over regions of `region_chunks` squared
+ * chunks. First every region decides its changes in parallel from the
+ * world as it was at the start of the tick, then changes are handed to
+ * the region owning the block, conflicts on the same block are settled
+ * by a fixed priority, and each region applies its own changes. Since no
+ * decision sees another made in the same tick, results are identical
+ * for any number of threads.
+ *
+ * Water spreads one level per block from sources, 8, down to 1 and
+ * falls straight down as level 7. Sand falls when nothing is under it.
+ * Grass spreads onto dirt next to it and dies under opaque blocks.
+ */
+class Simulation {
+public:
+	Simulation(const Simulation&) = delete;
+	Simulation& operator=(const Simulation&) = delete;
+
+	Simulation(ChunkStore& store, ThreadPool& pool, const SimulationConfig& config);
+
+	/**
+	 * @brief Sets a block and wakes it and its neighbours
+	 * @return False when the chunk is not loaded
+	 */
+	bool set_block(s32 x, s32 y, s32 z, BlockId block);
+
+	/**
+	 * @brief Wakes a block and its neighbours after it changed outside the simulation
+	 * @return void
+	 */
+	void notify(s32 x, s32 y, s32 z);
+
+	/**
+	 * @brief Ticks a block after `delay` ticks, at least 1
+	 * @return void
+	 */
+	void schedule(s32 x, s32 y, s32 z, u32 delay);
+
+	/**
+	 * @brief Advances the world by one tick
+	 * @return void
+	 */
+	void tick();
+
+	/**
+	 * @brief Blocks changed by the last tick, sorted by region then position
+	 */
+	const std::vector<BlockChange>& get_changes() const { return changes; }
+	const SimulationStats& get_stats() const { return stats; }
+
+private:
+	static constexpr u32 WHEEL_SIZE = 256;
+	static constexpr u32 BITSET_WORDS = SECTION_VOLUME / 64;
+
+	using Bitset = std::array<u64, BITSET_WORDS>;
+
+	struct Dirty {
+		s32 sx, sy, sz;
+		Bitset updates{};
+		Bitset scheduled{};
+		Bitset random{};
+	};
+
+	struct Scheduled {
+		s32 x, y, z;
+		u64 due;
+	};
+
+	/**
+	 * @brief A change a region decided on, the highest priority wins a block
+	 */
+	struct Proposal {
+		u64 region;     // owning the block, not the one that decided
+		s32 x, y, z;
+		BlockId block;
+		u16 priority;
+	};
+
+	struct RegionWork {
+		u64 region;
+		std::vector<std::pair<u64, const Dirty*>> sections;
+		std::vector<Proposal> proposals;
+		std::vector<Scheduled> schedules;
+		u32 updates = 0;
+		u32 scheduled = 0;
+		u32 random = 0;
+	};
+
+	/**
+	 * @brief Sets a block's bit in one of its section's bitsets
+	 */
+	void mark(s32 x, s32 y, s32 z, Bitset Dirty::*set);
+	void sample_random_ticks();
+	void run_region(RegionWork& work) const;
+
+	u64 region_of(s32 sx, s32 sz) const;
+
+	ChunkStore& store;
+	ThreadPool& pool;
+	SimulationConfig config;
+	u32 region_shift = 0;
+
+	u64 time = 0;
+	std::unordered_map<u64, Dirty> dirty;
+	std::array<std::vector<Scheduled>, WHEEL_SIZE> wheel;
+	std::vector<RegionWork> regions;
+	std::vector<BlockChange> changes;
+	std::vector<Proposal> winners;
+	std::vector<u16> samples;
+	SimulationStats stats;
+};
+
+}	// namespace world
+}	// namespace uni
@@ -0,0 +1,15 @@
+/**
+ * @file src/world/world.hpp
+ * @author Caleb Burke
+ * @date Oct 18, 2026
+ */
+
+#include "world/block.hpp"
+#include "world/chunk.hpp"
+#include "world/generator.hpp"
+#include "world/query.hpp"
+#include "world/palette.hpp"
+#include "world/mesher.hpp"
+#include "world/mesh_cache.hpp"
+#include "world/simulation.hpp"
+#include "world/brickmap.hpp"
@@ -5,9 +5,19 @@
  * @date Nov 18, 2023
  */
 
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <thread>
 
 #include "engine/engine.hpp"
+#include "world/world.hpp"
+#include "ecs/command_buffer.hpp"
+#include "ecs/components.hpp"
+#include "net/net.hpp"
+#include "util/hash.hpp"
 
 static int TESTS = 0;
 static int TESTS_PASSED = 0;
@@ -49,6 +59,1098 @@ int main(int argc, const char** argv){
 		uni::eng::Device device(window);
 	});
 
+	RUN_TEST("Testing free list allocator", [](){
+		uni::eng::FreeListAllocator allocator(100);
+		auto a = allocator.allocate(10);
+		auto b = allocator.allocate(20);
+		auto c = allocator.allocate(30);
+		TEST_ASSERT(a && b && c);
+		TEST_ASSERT(!allocator.allocate(50));
+		TEST_ASSERT(allocator.fragmentation() == 0.0f);
+
+		// Hole in the middle, free space now split in two
+		allocator.free(*b);
+		TEST_ASSERT(allocator.get_used() == 40);
+		TEST_ASSERT(allocator.fragmentation() > 0.0f);
+
+		// Coalescing gives back one block
+		allocator.free(*a);
+		allocator.free(*c);
+		TEST_ASSERT(allocator.get_largest_free() == 100);
+		TEST_ASSERT(allocator.fragmentation() == 0.0f);
+	});
+
+	RUN_TEST("Testing allocator compaction", [](){
+		uni::eng::FreeListAllocator allocator(100);
+		auto a = allocator.allocate(10);
+		auto b = allocator.allocate(10);
+		auto c = allocator.allocate(10);
+		allocator.free(*a);
+
+		// Pinned allocations and the budget are respected
+		TEST_ASSERT(allocator.compact(100, [](u64){ return false; }).empty());
+		TEST_ASSERT(allocator.compact(5, [](u64){ return true; }).empty());
+
+		auto moves = allocator.compact(100, [](u64){ return true; });
+		TEST_ASSERT(moves.size() == 1);
+		TEST_ASSERT(moves[0].src == *c && moves[0].dst == 0 && moves[0].size == 10);
+
+		// Source stays allocated until the caller frees it
+		TEST_ASSERT(allocator.get_used() == 30);
+		allocator.free(*c);
+		TEST_ASSERT(allocator.get_used() == 20);
+		TEST_ASSERT(allocator.fragmentation() == 0.0f);
+		(void)b;
+	});
+
+	RUN_TEST("Testing allocator compaction over frames", [](){
+		uni::eng::FreeListAllocator allocator(100);
+		auto a = allocator.allocate(30);
+		auto b = allocator.allocate(10);
+		allocator.free(*a);
+
+		// Frame one moves b down, its source stays allocated until freed
+		auto moves = allocator.compact(100, [](u64){ return true; });
+		TEST_ASSERT(moves.size() == 1 && moves[0].src == *b && moves[0].dst == 0);
+
+		// Frame two finds a hole below the source but must not move it again
+		TEST_ASSERT(allocator.compact(100, [](u64){ return true; }).empty());
+		allocator.free(*b);
+		TEST_ASSERT(allocator.get_used() == 10);
+
+		// Once freed the offset is an ordinary allocation again
+		auto c = allocator.allocate(20);
+		auto d = allocator.allocate(10);
+		TEST_ASSERT(c && d && *c == 10 && *d == 30);
+		allocator.free(*c);
+		moves = allocator.compact(100, [](u64){ return true; });
+		TEST_ASSERT(moves.size() == 1 && moves[0].src == *d && moves[0].dst == 10);
+	});
+
+	RUN_TEST("Testing chunk storage", [](){
+		using namespace uni::world;
+		ChunkStore store;
+		store.create({0, 0});
+		TEST_ASSERT(store.get_block(3, 70, 5) == AIR);
+		TEST_ASSERT(store.get_chunk({0, 0})->get_section(4) == nullptr);
+
+		TEST_ASSERT(store.set_block(3, 70, 5, STONE));
+		TEST_ASSERT(!store.set_block(-1, 70, 5, STONE));
+		TEST_ASSERT(store.get_block(3, 70, 5) == STONE);
+
+		const Section* section = store.get_section(0, 4, 0);
+		TEST_ASSERT(section != nullptr && section->non_air == 1);
+		TEST_ASSERT(section->occupancy == brick_bit(3, 70 & 15, 5));
+
+		store.set_block(3, 70, 5, AIR);
+		TEST_ASSERT(section->empty() && section->occupancy == 0);
+	});
+
+	RUN_TEST("Testing generator", [](){
+		using namespace uni::world;
+		ChunkStore a, b;
+		Generator(42).generate(a.create({1, -2}));
+		Generator(42).generate(b.create({1, -2}));
+		for(s32 y = 0; y < CHUNK_HEIGHT; y++){
+			TEST_ASSERT(a.get_block(20, y, -25) == b.get_block(20, y, -25));
+		}
+		TEST_ASSERT(is_solid(a.get_block(16, 0, -32)));
+	});
+
+	RUN_TEST("Testing raycast", [](){
+		using namespace uni::world;
+		ChunkStore store;
+		store.create({0, 0});
+		for(s32 x = 0; x < 16; x++){
+			for(s32 z = 0; z < 16; z++){ store.set_block(x, 10, z, STONE); }
+		}
+
+		RayHit hit = raycast(store, {{4.5f, 20.0f, 4.5f}, {0.0f, -1.0f, 0.0f}, 64.0f});
+		TEST_ASSERT(hit.hit && hit.x == 4 && hit.y == 10 && hit.z == 4);
+		TEST_ASSERT(hit.face == 3 && hit.distance == 9.0f);
+
+		// Out of range and pointing away
+		TEST_ASSERT(!raycast(store, {{4.5f, 20.0f, 4.5f}, {0.0f, -1.0f, 0.0f}, 5.0f}).hit);
+		TEST_ASSERT(!raycast(store, {{4.5f, 20.0f, 4.5f}, {0.0f, 1.0f, 0.0f}, 64.0f}).hit);
+	});
+
+	RUN_TEST("Testing batched raycast matches scalar", [](){
+		using namespace uni::world;
+		ChunkStore store;
+		Generator generator(7);
+		for(s32 cx = -2; cx < 2; cx++){
+			for(s32 cz = -2; cz < 2; cz++){ generator.generate(store.create({cx, cz})); }
+		}
+
+		// Fixed pseudo random rays, 37 so the last packet is partial
+		std::vector<Ray> rays;
+		u32 state = 1;
+		auto next = [&](){ state = state * 1664525u + 1013904223u; return (state >> 8) / f32(1 << 24); };
+		for(int i = 0; i < 37; i++){
+			Vec3 origin = {next() * 64.0f - 32.0f, 70.0f + next() * 20.0f, next() * 64.0f - 32.0f};
+			Vec3 direction = {next() - 0.5f, -next(), next() - 0.5f};
+			rays.push_back({origin, direction.normalized(), 96.0f});
+		}
+
+		std::vector<RayHit> hits(rays.size());
+		raycast_batch(store, rays.data(), hits.data(), rays.size());
+		for(size_t i = 0; i < rays.size(); i++){
+			RayHit expected = raycast(store, rays[i]);
+			TEST_ASSERT(hits[i].hit == expected.hit);
+			TEST_ASSERT(hits[i].x == expected.x && hits[i].y == expected.y && hits[i].z == expected.z);
+			TEST_ASSERT(hits[i].face == expected.face && hits[i].block == expected.block);
+		}
+	});
+
+	RUN_TEST("Testing aabb collision", [](){
+		using namespace uni::world;
+		ChunkStore store;
+		store.create({0, 0});
+		for(s32 x = 0; x < 16; x++){
+			for(s32 z = 0; z < 16; z++){ store.set_block(x, 10, z, STONE); }
+		}
+		store.set_block(8, 11, 5, STONE);
+
+		// Falls onto the floor
+		AabbMove fall;
+		fall.box = {{4.7f, 12.0f, 4.7f}, {5.3f, 13.8f, 5.3f}};
+		fall.delta = {0.0f, -3.0f, 0.0f};
+		move_aabb(store, fall);
+		TEST_ASSERT(fall.blocked == 2);
+		TEST_ASSERT(fall.box.min.y == 11.0f && fall.moved.y == -1.0f);
+
+		// Walks into the wall at x = 8 and slides along z
+		AabbMove walk;
+		walk.box = fall.box;
+		walk.delta = {4.0f, 0.0f, 0.5f};
+		std::vector<AabbMove> batch = {walk, fall};
+		move_aabb_batch(store, batch.data(), batch.size());
+		TEST_ASSERT(batch[0].blocked == 1);
+		TEST_ASSERT(batch[0].box.max.x == 8.0f && batch[0].moved.z == 0.5f);
+	});
+
+	RUN_TEST("Testing ecs registry", [](){
+		using namespace uni::ecs;
+		Registry registry;
+		Entity a = registry.create(Position{{1.0f, 2.0f, 3.0f}}, Velocity{{0.0f, -1.0f, 0.0f}});
+		Entity b = registry.create(Position{{4.0f, 5.0f, 6.0f}});
+		TEST_ASSERT(registry.size() == 2 && registry.archetype_count() == 2);
+		TEST_ASSERT(registry.get<Velocity>(b) == nullptr);
+		TEST_ASSERT(registry.get<Position>(a)->value.y == 2.0f);
+
+		// Moving between archetypes keeps the shared components
+		registry.add(b, Velocity{{1.0f, 0.0f, 0.0f}});
+		TEST_ASSERT(registry.get<Position>(b)->value.z == 6.0f);
+		TEST_ASSERT(registry.get<Velocity>(b)->value.x == 1.0f);
+		registry.remove<Velocity>(a);
+		TEST_ASSERT(registry.get<Velocity>(a) == nullptr && registry.get<Position>(a)->value.x == 1.0f);
+
+		registry.destroy(a);
+		TEST_ASSERT(!registry.alive(a) && registry.alive(b));
+		Entity c = registry.create(Position{});
+		TEST_ASSERT(c.index == a.index && c != a);
+
+		// A row larger than a chunk is refused before any entity is made
+		struct Huge { u8 bytes[CHUNK_BYTES]; };
+		bool thrown = false;
+		try { registry.create(Huge{}); } catch(std::exception&){ thrown = true; }
+		TEST_ASSERT(thrown && registry.size() == 2);
+	});
+
+	RUN_TEST("Testing ecs iteration and command buffers", [](){
+		using namespace uni::ecs;
+		Registry registry;
+		for(int i = 0; i < 5000; i++){
+			registry.create(Position{{0.0f, static_cast<f32>(i), 0.0f}}, Velocity{{0.0f, -1.0f, 0.0f}});
+		}
+		for(int i = 0; i < 100; i++){ registry.create(Position{}); }
+
+		ThreadPool pool(4);
+		std::vector<CommandBuffer> commands(pool.size());
+		std::atomic<bool> aligned{true};
+		registry.par_each_chunk<Position, Velocity>(pool, [&](u32 worker, u32 count, const Entity* entities, Position* p, Velocity* v){
+			if(reinterpret_cast<uintptr_t>(p) % CACHE_LINE != 0){ aligned = false; }
+			for(u32 i = 0; i < count; i++){
+				p[i].value += v[i].value;
+				if(p[i].value.y < 0.0f){ commands[worker].destroy(entities[i]); }
+			}
+		});
+		for(auto& buffer : commands){ buffer.flush(registry); }
+		TEST_ASSERT(aligned && registry.size() == 5099);
+
+		size_t moving = 0;
+		f32 sum = 0.0f;
+		registry.each<Position, Velocity>([&](Entity, Position& p, Velocity&){
+			moving++;
+			sum += p.value.y;
+		});
+		TEST_ASSERT(moving == 4999 && sum == 4999.0f * 4998.0f / 2.0f);
+
+		CommandBuffer spawn;
+		spawn.create(Position{}, DroppedItem{uni::world::DIRT, 1, 0.0f});
+		TEST_ASSERT(registry.size() == 5099);
+		spawn.flush(registry);
+		TEST_ASSERT(registry.size() == 5100 && spawn.empty());
+	});
+
+	RUN_TEST("Testing frustum culling", [](){
+		Mat4 view_proj = Mat4::perspective(1.2f, 16.0f / 9.0f, 0.1f, 512.0f) * Mat4::look_at({0, 80, 0}, {0, 80, 1}, {0, 1, 0});
+		Frustum frustum = Frustum::from(view_proj);
+		TEST_ASSERT(frustum.sphere_visible({0, 80, 10}, 0.5f));
+		TEST_ASSERT(!frustum.sphere_visible({0, 80, -10}, 0.5f));
+		TEST_ASSERT(!frustum.sphere_visible({0, 80, 600}, 0.5f));
+		TEST_ASSERT(!frustum.sphere_visible({100, 80, 10}, 0.5f));
+
+		// A sphere just outside a plane is kept while its radius reaches in
+		TEST_ASSERT(!frustum.sphere_visible({0, 80, 0.05f}, 0.01f));
+		TEST_ASSERT(frustum.sphere_visible({0, 80, 0.05f}, 0.1f));
+
+		// Planes agree with the projection, points inside clip space are inside
+		for(f32 x : {-1.5f, -0.5f, 0.5f, 1.5f}){
+			for(f32 z : {1.0f, 50.0f, 400.0f}){
+				Vec3 p = {x * z, 80.0f, z};
+				f32 cx = 0.0f, cw = 0.0f;
+				for(int k = 0; k < 3; k++){
+					cx += view_proj.at(0, k) * p[k];
+					cw += view_proj.at(3, k) * p[k];
+				}
+				cx += view_proj.at(0, 3);
+				cw += view_proj.at(3, 3);
+				TEST_ASSERT(frustum.sphere_visible(p, 0.0f) == (std::fabs(cx) <= cw));
+			}
+		}
+	});
+
+	RUN_TEST("Testing palette compression", [](){
+		using namespace uni::world;
+		Section section;
+		PalettedSection paletted;
+
+		// All one block needs no indices at all
+		section.blocks.fill(STONE);
+		encode_section(section, paletted);
+		TEST_ASSERT(paletted.palette.size() == 1 && paletted.bits == 0 && paletted.words.empty());
+
+		for(s32 i = 0; i < SECTION_VOLUME; i++){ section.blocks[i] = static_cast<BlockId>((i * 7 + i / 13) % 5); }
+		section.recount();
+		encode_section(section, paletted);
+		TEST_ASSERT(paletted.palette.size() == 5 && paletted.bits == 3);
+		TEST_ASSERT(paletted.byte_size() < sizeof(section.blocks) / 4);
+
+		Section decoded;
+		decode_section(paletted, decoded);
+		TEST_ASSERT(decoded.blocks == section.blocks);
+		TEST_ASSERT(decoded.occupancy == section.occupancy && decoded.non_air == section.non_air);
+	});
+
+	RUN_TEST("Testing chunk replication over loopback", [](){
+		using namespace uni::world;
+		using namespace uni::net;
+		ChunkStore store;
+		Generator generator(7);
+		ServerConfig config;
+		config.chunks_per_tick = 4;
+		Server server(store, generator, config);
+
+		Client near("127.0.0.1", server.get_port());
+		Client far("127.0.0.1", server.get_port());
+		near.send_position(8.0f, 8.0f, 2);
+		far.send_position(1000.0f, 1000.0f, 1);
+
+		auto run = [&](auto done){
+			for(int i = 0; i < 500 && !done(); i++){
+				server.tick();
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				near.poll();
+				far.poll();
+			}
+		};
+		run([&](){ return near.get_store().size() == 25 && far.get_store().size() == 9; });
+		TEST_ASSERT(server.client_count() == 2);
+		TEST_ASSERT(near.get_store().size() == 25 && far.get_store().size() == 9);
+
+		// Every chunk arrives exactly as the server has it
+		for(const auto& [pos, chunk] : near.get_store()){
+			for(s32 y = 0; y < CHUNK_HEIGHT; y += 3){
+				for(s32 i = 0; i < 256; i += 5){
+					TEST_ASSERT(chunk->get(i & 15, y, i >> 4) == store.get_chunk(pos)->get(i & 15, y, i >> 4));
+				}
+			}
+		}
+
+		// Deltas only go to clients that have the chunk
+		u64 far_bytes = far.get_bytes_received();
+		TEST_ASSERT(server.set_block(3, 100, 4, LOG));
+		TEST_ASSERT(server.set_block(3, 100, 4, DIRT));
+		TEST_ASSERT(server.set_block(5, 101, 4, SAND));
+		run([&](){ return near.get_store().get_block(5, 101, 4) == SAND; });
+		TEST_ASSERT(near.get_store().get_block(3, 100, 4) == DIRT);
+		TEST_ASSERT(server.get_client_stats(0).deltas_sent == 1);
+		TEST_ASSERT(far.get_bytes_received() == far_bytes);
+
+		// Moving away unloads what is out of view
+		near.send_position(8.0f + 16 * 10, 8.0f, 1);
+		run([&](){ return near.get_store().get_chunk({0, 0}) == nullptr && near.get_store().size() == 9; });
+		TEST_ASSERT(near.get_store().size() == 9 && near.get_store().get_chunk({10, 0}));
+	});
+
+	RUN_TEST("Testing malformed network input", [](){
+		using namespace uni::world;
+		using namespace uni::net;
+		ChunkStore store;
+		store.create({0, 0}).set(1, 2, 3, LOG);
+
+		// A bad block id or a truncated payload leaves the chunk the client has
+		Chunk chunk({0, 0});
+		chunk.set(0, 0, 0, DIRT);
+		std::vector<u8> frame = *encode_chunk(chunk);
+		std::vector<u8> bad = frame;
+		bad[FRAME_HEADER + 11] = static_cast<u8>(BLOCK_COUNT);
+		ByteReader bad_in(bad.data() + FRAME_HEADER, bad.size() - FRAME_HEADER);
+		TEST_ASSERT(!decode_chunk(bad_in, store));
+		ByteReader short_in(frame.data() + FRAME_HEADER, frame.size() - FRAME_HEADER - 1);
+		TEST_ASSERT(!decode_chunk(short_in, store));
+		TEST_ASSERT(store.get_block(1, 2, 3) == LOG && store.get_block(0, 0, 0) == AIR);
+		ByteReader in(frame.data() + FRAME_HEADER, frame.size() - FRAME_HEADER);
+		TEST_ASSERT(decode_chunk(in, store));
+		TEST_ASSERT(store.get_block(1, 2, 3) == AIR && store.get_block(0, 0, 0) == DIRT);
+
+		// A delta rejected at its last change applies none of them
+		std::vector<uni::net::BlockChange> changes = {{4, 10, 4, STONE}, {5, 10, 5, GRASS}};
+		std::vector<u8> delta = *encode_delta({0, 0}, changes);
+		delta[FRAME_HEADER + 14] = static_cast<u8>(BLOCK_COUNT);
+		ByteReader delta_in(delta.data() + FRAME_HEADER, delta.size() - FRAME_HEADER);
+		TEST_ASSERT(!apply_delta(delta_in, store));
+		TEST_ASSERT(store.get_block(4, 10, 4) == AIR && store.get_block(5, 10, 5) == AIR);
+
+		// A client announcing a message larger than any it may send is dropped
+		Generator generator(7);
+		Server server(store, generator, {});
+		Socket socket = Socket::connect("127.0.0.1", server.get_port());
+		u8 header[FRAME_HEADER] = {0xff, 0xff, 0xff, 0x7f, static_cast<u8>(Message::POSITION)};
+		TEST_ASSERT(socket.send(header, sizeof(header)) == static_cast<ssize_t>(sizeof(header)));
+		server.tick();
+		for(int i = 0; i < 100 && server.client_count() > 0; i++){
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			server.tick();
+		}
+		TEST_ASSERT(server.client_count() == 0);
+	});
+
+	RUN_TEST("Testing headless input and frame pacing", [](){
+		using namespace uni::eng;
+		SimulatedClock clock;
+		Window window(100, 100, "testing", WindowMode::HEADLESS);
+		FramePacer pacer(clock, {100.0});
+		TEST_ASSERT(window.is_headless() && pacer.get_interval() == 10000000);
+
+		// Cursor sampled at 1kHz, 3ms of frame building then 1ms to present
+		u64 next_input = 0, events = 0;
+		for(int frame = 0; frame < 200; frame++){
+			pacer.wait();
+			for(; next_input <= clock.now(); next_input += 1000000){
+				window.inject({InputEvent::CURSOR, 0, 0, next_input * 1e-6, 0.0, next_input});
+			}
+			InputEvent event;
+			while(window.next_event(event)){ events++; }
+
+			clock.advance(3000000);
+			pacer.latch(window.latch_cursor().time);
+			clock.advance(1000000);
+			pacer.presented();
+		}
+		const FrameStats& stats = pacer.get_stats();
+		TEST_ASSERT(stats.frames == 200 && stats.missed == 0);
+		TEST_ASSERT(std::fabs(stats.frame_ms - 10.0) < 0.05);    // only the first frame starts early
+		TEST_ASSERT(events == next_input / 1000000 && window.get_dropped_events() == 0);
+
+		// Frames start late, input is at most one sample older than the 4ms of work
+		TEST_ASSERT(stats.latency_ms >= 4.0 && stats.latency_max_ms <= 5.0);
+
+		// A slow frame is counted and the schedule restarts from it
+		pacer.wait();
+		clock.advance(25000000);
+		pacer.presented();
+		TEST_ASSERT(pacer.get_stats().missed == 1 && pacer.get_deadline() == clock.now() + pacer.get_interval());
+
+		// Resizes from the input thread are never seen half applied
+		bool torn = false;
+		std::thread input([&window](){
+			for(s32 i = 1; i <= 10000; i++){ window.inject({InputEvent::RESIZE, i, i * 2, 0.0, 0.0, 0}); }
+		});
+		for(s32 i = 0; i < 10000; i++){
+			VkExtent2D extent = window.get_extent();
+			if(extent.height != extent.width * 2 && extent.width != 100){ torn = true; }
+			InputEvent event;
+			while(window.next_event(event)){}
+		}
+		input.join();
+		TEST_ASSERT(!torn && window.get_width() == 10000 && window.get_height() == 20000);
+
+		window.inject({InputEvent::CLOSE, 0, 0, 0.0, 0.0, clock.now()});
+		TEST_ASSERT(window.should_close());
+	});
+
+	RUN_TEST("Testing cpu mesher", [](){
+		using namespace uni::world;
+		std::vector<ChunkQuad> quads;
+		Section section, above;
+		SectionNeighbours neighbours;
+		neighbours.center = &section;
+
+		section.set(5, 5, 5, STONE);
+		mesh_section(neighbours, quads);
+		TEST_ASSERT(quads.size() == 6 && quads[3] == pack_quad(5, 5, 5, 3, STONE));
+
+		// Touching opaque blocks hide the faces between them
+		section.set(6, 5, 5, DIRT);
+		mesh_section(neighbours, quads);
+		TEST_ASSERT(quads.size() == 10);
+
+		// Transparent blocks show what is behind them but not their own kind
+		section.set(5, 6, 5, WATER);
+		section.set(6, 6, 5, WATER);
+		mesh_section(neighbours, quads);
+		TEST_ASSERT(quads.size() == 8 + 10);
+
+		// Faces on the section edge look into the neighbour
+		section.set(0, 15, 0, STONE);
+		mesh_section(neighbours, quads);
+		TEST_ASSERT(quads.size() == 18 + 6);
+		above.set(0, 0, 0, STONE);
+		neighbours.sides[3] = &above;
+		mesh_section(neighbours, quads);
+		TEST_ASSERT(quads.size() == 18 + 5);
+
+		// The bound holds on real terrain
+		ChunkStore store;
+		Generator generator(3);
+		for(s32 cx = -1; cx <= 1; cx++){
+			for(s32 cz = -1; cz <= 1; cz++){ generator.generate(store.create({cx, cz})); }
+		}
+		for(s32 sy = 0; sy < CHUNK_SECTIONS; sy++){
+			SectionNeighbours n = gather_neighbours(store, 0, sy, 0);
+			mesh_section(n, quads);
+			TEST_ASSERT(quads.size() <= (n.center ? max_quads(*n.center) : 0));
+		}
+	});
+
+	RUN_TEST("Testing gpu meshing matches cpu", [](){
+		using namespace uni;
+		world::ChunkStore store;
+		world::Generator generator(3);
+		for(s32 cx = -1; cx <= 1; cx++){
+			for(s32 cz = -1; cz <= 1; cz++){ generator.generate(store.create({cx, cz})); }
+		}
+		// Transparent blocks across a section border
+		for(s32 x = 0; x < 4; x++){
+			store.set_block(x, 95, 0, world::WATER);
+			store.set_block(x, 96, 0, world::LEAVES);
+		}
+
+		eng::Window window(100, 100, "testing");
+		eng::Device device(window);
+		eng::StagingRing staging(device, 4 << 20);
+		eng::GpuMesherConfig config;
+		config.max_sections = 64;
+		config.quad_capacity = 1 << 20;
+		eng::GpuMesher mesher(device, staging, config);
+
+		staging.begin_frame(0);
+		mesher.begin_frame(0);
+		// Column x = 0 meshed by the shader, x = 1 uploaded already meshed
+		eng::MeshId ids[2][world::CHUNK_SECTIONS];
+		std::vector<world::ChunkQuad> expected;
+		bool queued = true;
+		for(s32 sy = 0; sy < world::CHUNK_SECTIONS; sy++){
+			ids[0][sy] = ids[1][sy] = eng::NO_MESH;
+			queued = queued && mesher.mesh(ids[0][sy], world::gather_neighbours(store, 0, sy, 0), 0, sy, 0);
+			world::mesh_section(world::gather_neighbours(store, 1, sy, 0), expected);
+			queued = queued && mesher.upload(ids[1][sy], expected.data(), static_cast<u32>(expected.size()), 1, sy, 0);
+		}
+		TEST_ASSERT(queued);
+
+		// Out of jobs or quads: refused sections keep their ids and old meshes
+		world::SectionNeighbours first = world::gather_neighbours(store, 0, 5, 0);
+		eng::GpuMesherConfig tiny = config;
+		tiny.quad_capacity = world::max_quads(*first.center);
+		tiny.jobs_per_frame = 1;
+		eng::GpuMesher full(device, staging, tiny);
+		full.begin_frame(0);
+		eng::MeshId a = eng::NO_MESH, b = eng::NO_MESH;
+		TEST_ASSERT(full.mesh(a, first, 0, 5, 0) && a != eng::NO_MESH);
+		TEST_ASSERT(!full.mesh(b, world::gather_neighbours(store, 0, 6, 0), 0, 6, 0) && b == eng::NO_MESH);
+		eng::MeshId old = a;
+		std::vector<world::ChunkQuad> first_quads;
+		world::mesh_section(first, first_quads);
+		TEST_ASSERT(!first_quads.empty());
+		TEST_ASSERT(!full.upload(a, first_quads.data(), static_cast<u32>(first_quads.size()), 0, 5, 0) && a == old);
+		TEST_ASSERT(full.get_stats().deferred == 2);
+
+		VkDeviceSize quad_bytes = config.quad_capacity * sizeof(world::ChunkQuad);
+		VkDeviceSize draw_bytes = config.max_sections * sizeof(eng::SectionDraw);
+		VkBuffer readback;
+		VkDeviceMemory readback_memory;
+		device.create_buffer(quad_bytes + draw_bytes, VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, readback, readback_memory);
+
+		VkCommandBuffer command_buffer = device.begin_single_time_commands();
+		mesher.record(command_buffer);
+		VkBufferCopy quad_copy = {0, 0, quad_bytes};
+		VkBufferCopy draw_copy = {0, quad_bytes, draw_bytes};
+		vkCmdCopyBuffer(command_buffer, mesher.get_quad_buffer(), readback, 1, &quad_copy);
+		vkCmdCopyBuffer(command_buffer, mesher.get_draw_buffer(), readback, 1, &draw_copy);
+		device.end_single_time_commands(command_buffer);
+
+		u8* mapped;
+		vkMapMemory(device.get_device(), readback_memory, 0, VK_WHOLE_SIZE, 0, reinterpret_cast<void**>(&mapped));
+		const world::ChunkQuad* quads = reinterpret_cast<const world::ChunkQuad*>(mapped);
+		const eng::SectionDraw* draws = reinterpret_cast<const eng::SectionDraw*>(mapped + quad_bytes);
+
+		bool equal = true;
+		for(s32 sx = 0; sx < 2; sx++){
+			for(s32 sy = 0; sy < world::CHUNK_SECTIONS; sy++){
+				world::mesh_section(world::gather_neighbours(store, sx, sy, 0), expected);
+				std::vector<world::ChunkQuad> actual;
+				eng::MeshId id = ids[sx][sy];
+				if(id != eng::NO_MESH){
+					const eng::SectionDraw& draw = draws[id];
+					actual.assign(quads + draw.command.firstVertex / 6, quads + (draw.command.firstVertex + draw.command.vertexCount) / 6);
+					equal = equal && draw.origin[0] == sx * world::SECTION_SIZE && draw.origin[1] == sy * world::SECTION_SIZE && draw.command.firstInstance == id;
+				}
+				std::sort(expected.begin(), expected.end());
+				std::sort(actual.begin(), actual.end());
+				equal = equal && actual == expected;
+			}
+		}
+		vkUnmapMemory(device.get_device(), readback_memory);
+		vkDestroyBuffer(device.get_device(), readback, nullptr);
+		device.free_memory(readback_memory);
+		TEST_ASSERT(equal);
+	});
+
+	RUN_TEST("Testing block simulation", [](){
+		using namespace uni::world;
+
+		// Grass floor at y 10 with a dirt patch, a water source and a hanging sand column
+		auto build = [](ChunkStore& store){
+			for(s32 cx = -2; cx <= 1; cx++){
+				for(s32 cz = -2; cz <= 1; cz++){
+					Chunk& chunk = store.create({cx, cz});
+					for(s32 x = 0; x < 16; x++){
+						for(s32 z = 0; z < 16; z++){ chunk.set(x, 10, z, cx == -1 && cz == -1 ? DIRT : GRASS); }
+					}
+				}
+			}
+		};
+		auto seed = [](Simulation& sim){
+			sim.set_block(0, 11, 0, WATER);
+			for(s32 y = 20; y < 23; y++){ sim.set_block(20, y, 5, SAND); }
+		};
+
+		SimulationConfig config;
+		config.seed = 7;
+		config.random_ticks = 64;
+		config.region_chunks = 1;
+		ThreadPool serial(1), parallel(3);
+		ChunkStore a, b;
+		build(a);
+		build(b);
+		Simulation sa(a, serial, config), sb(b, parallel, config);
+		seed(sa);
+		seed(sb);
+
+		u32 changes = 0;
+		for(s32 t = 0; t < 100; t++){
+			sa.tick();
+			sb.tick();
+			TEST_ASSERT(sa.get_changes().size() == sb.get_changes().size());
+			TEST_ASSERT(sa.get_stats().conflicts == sb.get_stats().conflicts);
+			changes += sa.get_stats().changes;
+		}
+		TEST_ASSERT(changes > 0);
+
+		// Identical for any number of threads
+		for(const auto& [pos, chunk] : a){
+			const Chunk* other = b.get_chunk(pos);
+			for(s32 sy = 0; sy < CHUNK_SECTIONS; sy++){
+				const Section* s = chunk->get_section(sy);
+				const Section* o = other->get_section(sy);
+				TEST_ASSERT((s == nullptr) == (o == nullptr));
+				TEST_ASSERT(s == nullptr || s->blocks == o->blocks);
+			}
+		}
+
+		// Water loses one level per block on a solid floor
+		TEST_ASSERT(a.get_block(0, 11, 0) == WATER);
+		for(s32 d = 1; d < 8; d++){
+			TEST_ASSERT(water_level(a.get_block(d, 11, 0)) == 8 - d);
+			TEST_ASSERT(water_level(a.get_block(-d, 11, 0)) == 8 - d);
+			TEST_ASSERT(water_level(a.get_block(0, 11, d)) == 8 - d);
+		}
+		TEST_ASSERT(a.get_block(8, 11, 0) == AIR);
+		TEST_ASSERT(a.get_block(4, 11, 4) == AIR);
+
+		// Sand falls as a column and comes to rest on the floor
+		for(s32 y = 11; y < 14; y++){ TEST_ASSERT(a.get_block(20, y, 5) == SAND); }
+		TEST_ASSERT(a.get_block(20, 14, 5) == AIR);
+
+		// Removing the source drains the flowing water
+		sa.set_block(0, 11, 0, AIR);
+		for(s32 t = 0; t < 100; t++){ sa.tick(); }
+		for(s32 d = 0; d < 8; d++){ TEST_ASSERT(a.get_block(d, 11, 0) == AIR); }
+		TEST_ASSERT(sa.get_stats().pending == 0);
+	});
+
+	RUN_TEST("Testing far field brickmap", [](){
+		using namespace uni::world;
+		ChunkStore store;
+		for(s32 cx = -2; cx < 2; cx++){
+			for(s32 cz = -2; cz < 2; cz++){
+				Chunk& chunk = store.create({cx, cz});
+				for(s32 x = 0; x < 16; x++){
+					for(s32 z = 0; z < 16; z++){
+						s32 height = 40 + static_cast<s32>(((static_cast<u32>(cx * 16 + x) * 73856093u ^ static_cast<u32>(cz * 16 + z) * 19349663u) >> 7) % 24);
+						for(s32 y = 0; y < height; y++){ chunk.set(x, y, z, y + 1 == height ? GRASS : STONE); }
+					}
+				}
+			}
+		}
+
+		BrickmapConfig config;
+		config.grid_chunks = 8;
+		config.max_bricks = 1024;
+		Brickmap map(config);
+		for(const auto& [pos, chunk] : store){ TEST_ASSERT(map.update(store, pos)); }
+		TEST_ASSERT(map.get_stats().columns == 16);
+
+		// The solid sections below the terrain need no brick
+		TEST_ASSERT(map.get_stats().uniform == 16 * 2);
+		TEST_ASSERT(map.get_stats().bricks == 16 * 2);
+		std::vector<u32> dirty;
+		TEST_ASSERT(map.take_dirty_bricks(dirty, 1000) == 0 && dirty.size() == 32);
+		dirty.clear();
+		TEST_ASSERT(map.take_dirty_columns(dirty, 10) == 6 && dirty.size() == 10);
+		map.take_dirty_columns(dirty, 1000);
+
+		// Cells cover every block in them, hits are never late and land on a cell holding a block
+		u32 state = 1;
+		auto next = [&state](){ state = state * 1664525u + 1013904223u; return (state >> 8) / f32(1 << 24); };
+		for(s32 i = 0; i < 500; i++){
+			Ray ray;
+			ray.origin = {next() * 60.0f - 30.0f, 90.0f, next() * 60.0f - 30.0f};
+			ray.direction = Vec3{next() * 2.0f - 1.0f, -0.2f - next(), next() * 2.0f - 1.0f}.normalized();
+			ray.max_distance = 200.0f;
+			RayHit exact = raycast(store, ray);
+			FarHit far = map.march(ray, 0.0f);
+			if(exact.hit){ TEST_ASSERT(far.hit && far.distance <= exact.distance + 1e-3f); }
+			if(!far.hit){ continue; }
+			TEST_ASSERT(far.block == GRASS || far.block == STONE);
+			Vec3 p = ray.origin + ray.direction * (far.distance + 1e-3f);
+			s32 cell[3] = {static_cast<s32>(std::floor(p.x / 2)) * 2, static_cast<s32>(std::floor(p.y / 2)) * 2, static_cast<s32>(std::floor(p.z / 2)) * 2};
+			bool occupied = false;
+			for(s32 c = 0; c < 8; c++){ occupied |= store.get_block(cell[0] + (c & 1), cell[1] + (c >> 1 & 1), cell[2] + (c >> 2)) != AIR; }
+			TEST_ASSERT(occupied);
+		}
+
+		// A changed chunk rewrites only its own entries
+		store.set_block(5, 200, 5, STONE);
+		TEST_ASSERT(map.update(store, {0, 0}));
+		dirty.clear();
+		map.take_dirty_bricks(dirty, 1000);
+		TEST_ASSERT(dirty.size() == 1 && map.get_stats().bricks == 33);
+		dirty.clear();
+		map.take_dirty_columns(dirty, 1000);
+		TEST_ASSERT(dirty.size() == 1 && dirty[0] == map.column_of({0, 0}));
+
+		Ray down = {{5.5f, 250.0f, 5.5f}, {0.0f, -1.0f, 0.0f}, 100.0f};
+		FarHit hit = map.march(down, 0.0f);
+		TEST_ASSERT(hit.hit && hit.block == STONE && std::abs(hit.distance - 48.0f) < 1e-3f);
+		TEST_ASSERT(!map.march(down, 51.0f).hit);
+
+		// Columns wait only for their own bricks, freed bricks wait for the GPU copy
+		BrickmapConfig deferred = config;
+		deferred.deferred_reuse = true;
+		Brickmap lagging(deferred);
+		for(const auto& [pos, chunk] : store){ lagging.update(store, pos); }
+		dirty.clear();
+		lagging.take_dirty_bricks(dirty, 1);
+		TEST_ASSERT(lagging.take_dirty_columns(dirty, 1000) == 16 && dirty.size() == 1);
+		lagging.take_dirty_bricks(dirty, 1000);
+		lagging.take_dirty_columns(dirty, 1000);
+
+		u32 bricks = lagging.get_stats().bricks;
+		lagging.remove({0, 0});
+		std::vector<u32> released;
+		lagging.take_released_bricks(released);
+		TEST_ASSERT(released.empty());
+		lagging.take_dirty_columns(dirty, 1000);
+		lagging.take_released_bricks(released);
+		TEST_ASSERT(released.size() == bricks - lagging.get_stats().bricks);
+		lagging.update(store, {0, 0});
+		dirty.clear();
+		lagging.take_dirty_bricks(dirty, 1000);
+		for(u32 slot : dirty){ TEST_ASSERT(std::find(released.begin(), released.end(), slot) == released.end()); }
+		lagging.recycle_bricks(released);
+
+		// A chunk wrapping onto the same column evicts the old one
+		store.create({8, 0});
+		map.update(store, {8, 0});
+		TEST_ASSERT(map.get_stats().columns == 16 && map.get_stats().bricks == 30);
+		TEST_ASSERT(!map.march(down, 0.0f).hit);
+	});
+
+	RUN_TEST("Testing far field shader matches march", [](){
+		using namespace uni;
+		world::ChunkStore store;
+		world::Generator generator(5);
+		for(s32 cx = -2; cx < 2; cx++){
+			for(s32 cz = -2; cz < 2; cz++){ generator.generate(store.create({cx, cz})); }
+		}
+		world::BrickmapConfig map_config;
+		map_config.grid_chunks = 8;
+		map_config.max_bricks = 1024;
+		map_config.deferred_reuse = true;
+		world::Brickmap map(map_config);
+		for(const auto& [pos, chunk] : store){ TEST_ASSERT(map.update(store, pos)); }
+
+		eng::Window window(100, 100, "testing");
+		eng::Device device(window);
+		eng::StagingRing staging(device, 4 << 20);
+		eng::FarFieldConfig config;
+		config.frames_in_flight = 1;
+		eng::FarField far(device, staging, map, config);
+
+		// Depth cleared to nothing drawn, color cleared to alpha 0 so misses stay 0
+		constexpr u32 SIZE = 64;
+		const VkFormat formats[2] = {VK_FORMAT_R8G8B8A8_UNORM, VK_FORMAT_D32_SFLOAT};
+		const VkImageUsageFlags usages[2] = {
+			VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT,
+			VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT
+		};
+		const VkImageAspectFlags aspects[2] = {VK_IMAGE_ASPECT_COLOR_BIT, VK_IMAGE_ASPECT_DEPTH_BIT};
+		const VkImageLayout layouts[2] = {VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL};
+		VkImage images[2];
+		VkDeviceMemory memory[2];
+		VkImageView views[2];
+		for(int i = 0; i < 2; i++){
+			VkImageCreateInfo info = {};
+			info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+			info.imageType = VK_IMAGE_TYPE_2D;
+			info.format = formats[i];
+			info.extent = {SIZE, SIZE, 1};
+			info.mipLevels = 1;
+			info.arrayLayers = 1;
+			info.samples = VK_SAMPLE_COUNT_1_BIT;
+			info.tiling = VK_IMAGE_TILING_OPTIMAL;
+			info.usage = usages[i];
+			info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+			info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+			device.create_image(info, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, images[i], memory[i]);
+			views[i] = device.create_image_view(images[i], formats[i], aspects[i]);
+		}
+		VkBuffer readback;
+		VkDeviceMemory readback_memory;
+		device.create_buffer(SIZE * SIZE * 4, VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, readback, readback_memory);
+
+		const Vec3 eye = {-40.0f, 110.0f, -40.0f};
+		const Vec3 target = {8.0f, 60.0f, 8.0f};
+		eng::FarFieldView view;
+		view.eye = eye;
+		view.forward = (target - eye).normalized();
+		view.right = cross(view.forward, {0.0f, 1.0f, 0.0f}).normalized() * std::tan(0.6f);
+		view.up = cross(view.right, view.forward).normalized() * std::tan(0.6f);
+		view.near = 0.1f;
+		view.far = 256.0f;
+		view.start = 0.0f;
+		view.end = 256.0f;
+		view.width = SIZE;
+		view.height = SIZE;
+
+		staging.begin_frame(0);
+		far.begin_frame(0);
+		far.upload(map);
+		TEST_ASSERT(map.get_dirty_brick_count() == 0 && map.get_dirty_column_count() == 0);
+
+		VkCommandBuffer command_buffer = device.begin_single_time_commands();
+		VkImageMemoryBarrier barriers[2] = {};
+		for(int i = 0; i < 2; i++){
+			barriers[i].sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+			barriers[i].dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+			barriers[i].oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+			barriers[i].newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+			barriers[i].srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+			barriers[i].dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+			barriers[i].image = images[i];
+			barriers[i].subresourceRange = {aspects[i], 0, 1, 0, 1};
+		}
+		vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 2, barriers);
+		VkClearColorValue clear_color = {{0.0f, 0.0f, 0.0f, 0.0f}};
+		VkClearDepthStencilValue clear_depth = {1.0f, 0};
+		vkCmdClearColorImage(command_buffer, images[0], VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, &clear_color, 1, &barriers[0].subresourceRange);
+		vkCmdClearDepthStencilImage(command_buffer, images[1], VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, &clear_depth, 1, &barriers[1].subresourceRange);
+		for(int i = 0; i < 2; i++){
+			barriers[i].srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+			barriers[i].dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+			barriers[i].oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+			barriers[i].newLayout = layouts[i];
+		}
+		vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 2, barriers);
+
+		far.record(command_buffer, view, views[1], views[0]);
+
+		VkMemoryBarrier barrier = {};
+		barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+		barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+		barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+		vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+		VkBufferImageCopy region = {};
+		region.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+		region.imageExtent = {SIZE, SIZE, 1};
+		vkCmdCopyImageToBuffer(command_buffer, images[0], VK_IMAGE_LAYOUT_GENERAL, readback, 1, &region);
+		device.end_single_time_commands(command_buffer);
+
+		// Same rays as the shader, a hit writes alpha 1
+		u8* mapped;
+		vkMapMemory(device.get_device(), readback_memory, 0, VK_WHOLE_SIZE, 0, reinterpret_cast<void**>(&mapped));
+		u32 hits = 0, misses = 0, mismatches = 0;
+		for(u32 y = 0; y < SIZE; y++){
+			for(u32 x = 0; x < SIZE; x++){
+				f32 nx = (x + 0.5f) / SIZE * 2.0f - 1.0f;
+				f32 ny = (y + 0.5f) / SIZE * 2.0f - 1.0f;
+				world::Ray ray = {eye, (view.forward + view.right * nx - view.up * ny).normalized(), view.end};
+				bool hit = map.march(ray, view.start).hit;
+				bool drawn = mapped[(y * SIZE + x) * 4 + 3] == 255;
+				(hit ? hits : misses)++;
+				mismatches += hit != drawn;
+			}
+		}
+		vkUnmapMemory(device.get_device(), readback_memory);
+		vkDestroyBuffer(device.get_device(), readback, nullptr);
+		device.free_memory(readback_memory);
+		for(int i = 0; i < 2; i++){
+			vkDestroyImageView(device.get_device(), views[i], nullptr);
+			vkDestroyImage(device.get_device(), images[i], nullptr);
+			device.free_memory(memory[i]);
+		}
+
+		// Rays grazing a cell edge may round either way
+		TEST_ASSERT(hits > SIZE * SIZE / 10 && misses > SIZE * SIZE / 10);
+		TEST_ASSERT(mismatches <= SIZE * SIZE / 100);
+	});
+
+	RUN_TEST("Testing mesh cache", [](){
+		using namespace uni::world;
+		TEST_ASSERT(xxh64("", 0) == 0xef46db3751d8e999ull);
+		TEST_ASSERT(xxh64("abc", 3) == 0x44bc2cf5ad770999ull);
+
+		ChunkStore store;
+		Generator generator(7);
+		for(s32 cx = -1; cx <= 1; cx++){
+			for(s32 cz = -1; cz <= 1; cz++){ generator.generate(store.create({cx, cz})); }
+		}
+		std::vector<SectionNeighbours> sections;
+		std::vector<s32> levels;
+		for(s32 sy = 0; sy < CHUNK_SECTIONS; sy++){
+			SectionNeighbours n = gather_neighbours(store, 0, sy, 0);
+			if(n.center && !n.center->empty()){
+				sections.push_back(n);
+				levels.push_back(sy);
+			}
+		}
+
+		MeshCacheConfig config;
+		config.path = (std::filesystem::temp_directory_path() / "unicraft_test_meshes.pack").string();
+		config.max_bytes = 1 << 24;
+		std::filesystem::remove(config.path);
+		std::filesystem::remove(config.path + ".idx");
+
+		std::vector<ChunkQuad> expected;
+		auto matches = [&expected](const CachedMesh& mesh){
+			return mesh.count == expected.size() && std::equal(expected.begin(), expected.end(), mesh.quads);
+		};
+		u64 entries;
+		{
+			MeshCache cache(config);
+			for(const auto& section : sections){
+				mesh_section(section, expected);
+				TEST_ASSERT(matches(cache.mesh(section)));
+			}
+			entries = cache.get_stats().entries;
+			TEST_ASSERT(entries > 0 && cache.get_stats().inserts == entries);
+		}
+
+		// Every section hits after reopening, without meshing
+		{
+			MeshCache cache(config);
+			TEST_ASSERT(cache.get_stats().entries == entries);
+			for(const auto& section : sections){
+				mesh_section(section, expected);
+				CachedMesh mesh = cache.mesh(section);
+				TEST_ASSERT(mesh.hit && matches(mesh));
+			}
+			TEST_ASSERT(cache.get_stats().hit_rate() == 1.0);
+
+			// A block in the neighbour's border changes the key, one inside it does not
+			u64 key = mesh_key(sections[0]);
+			Section* side = store.get_chunk({1, 0})->get_section(levels[0]);
+			BlockId before = side->get(0, 5, 5);
+			side->set(0, 5, 5, before == AIR ? STONE : AIR);
+			TEST_ASSERT(mesh_key(sections[0]) != key);
+			side->set(0, 5, 5, before);
+			side->set(1, 5, 5, side->get(1, 5, 5) == AIR ? STONE : AIR);
+			TEST_ASSERT(mesh_key(sections[0]) == key);
+		}
+
+		// A torn write at the end of both files is dropped
+		{
+			std::ofstream(config.path, std::ios::binary | std::ios::app) << "torn quads";
+			std::ofstream(config.path + ".idx", std::ios::binary | std::ios::app) << "torn";
+			MeshCache cache(config);
+			TEST_ASSERT(cache.get_stats().entries == entries);
+			mesh_section(sections[0], expected);
+			TEST_ASSERT(matches(cache.mesh(sections[0])));
+			TEST_ASSERT(std::filesystem::file_size(config.path + ".idx") == 16 + entries * 24);
+		}
+
+		// Quads that never reached the disk fail their checksum and are meshed again
+		size_t first = 0;
+		for(mesh_section(sections[first], expected); expected.empty(); mesh_section(sections[++first], expected)){}
+		{
+			std::fstream file(config.path, std::ios::binary | std::ios::in | std::ios::out);
+			file.seekp(16);
+			std::vector<char> zeros(sizeof(ChunkQuad));
+			file.write(zeros.data(), zeros.size());
+		}
+		{
+			MeshCache cache(config);
+			CachedMesh mesh = cache.mesh(sections[first]);
+			TEST_ASSERT(!mesh.hit && matches(mesh) && cache.get_stats().inserts == 1);
+			TEST_ASSERT(cache.mesh(sections[first]).hit);
+		}
+		{
+			MeshCache cache(config);
+			CachedMesh mesh = cache.mesh(sections[first]);
+			TEST_ASSERT(mesh.hit && matches(mesh));
+		}
+
+		// Files of another mesher version are thrown away
+		{
+			std::fstream file(config.path, std::ios::binary | std::ios::in | std::ios::out);
+			file.seekp(8);
+			u32 version = MESHER_VERSION + 1;
+			file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+		}
+		{
+			MeshCache cache(config);
+			TEST_ASSERT(cache.get_stats().entries == 0);
+			TEST_ASSERT(!cache.mesh(sections[0]).hit);
+		}
+		std::filesystem::remove(config.path);
+		std::filesystem::remove(config.path + ".idx");
+	});
+
+	RUN_TEST("Testing memory budget", [](){
+		using namespace uni;
+		eng::Window window(100, 100, "testing");
+		eng::Device device(window);
+		auto allocated = [&device](){
+			VkDeviceSize total = 0;
+			for(const auto& heap : device.poll_memory().heaps){ total += heap.allocated; }
+			return total;
+		};
+		bool local = false;
+		for(const auto& heap : device.poll_memory().heaps){ local = local || (heap.device_local && heap.budget > 0); }
+		TEST_ASSERT(local);
+
+		VkDeviceSize before = allocated();
+		VkBuffer buffer;
+		VkDeviceMemory memory;
+		device.create_buffer(16 << 20, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, buffer, memory, 1.0f);
+		TEST_ASSERT(allocated() >= before + (16 << 20));
+
+		// Watermarks 4 and 8 MiB under the current usage, evictors free into a pool
+		eng::MemoryBudget probe(device, {});
+		probe.begin_frame();
+		f64 heap_budget = static_cast<f64>(probe.get_stats().budget);
+		VkDeviceSize usage = probe.get_stats().usage;
+		eng::MemoryBudgetConfig config;
+		config.high_watermark = static_cast<f32>((usage - (4 << 20)) / heap_budget);
+		config.low_watermark = static_cast<f32>((usage - (8 << 20)) / heap_budget);
+		config.evict_per_frame = 1 << 20;
+		eng::MemoryBudget budget(device, config);
+		VkDeviceSize pool = 0;
+		std::vector<VkDeviceSize> asked;
+		budget.add_pool([&pool](){ return pool; });
+		budget.add_evictor([&asked, &pool](VkDeviceSize bytes){ asked.push_back(bytes); pool += bytes / 2; return bytes / 2; });
+		budget.add_evictor([&asked, &pool](VkDeviceSize bytes){ asked.push_back(bytes); pool += bytes; return bytes; });
+
+		budget.begin_frame();
+		TEST_ASSERT(budget.is_evicting() && budget.get_stats().episodes == 1);
+		TEST_ASSERT(asked.size() == 2 && asked[0] == (1 << 20) && asked[1] == (1 << 19));
+		TEST_ASSERT(budget.get_stats().evicted == (1 << 20));
+
+		// Pooled free space ends the crossing even though the driver's usage never drops
+		for(u32 frame = 0; frame < 100 && budget.is_evicting(); frame++){ budget.begin_frame(); }
+		TEST_ASSERT(!budget.is_evicting() && budget.get_stats().episodes == 1);
+		TEST_ASSERT(budget.get_stats().total_evicted >= (7 << 20) && budget.get_stats().total_evicted <= (9 << 20));
+		budget.begin_frame();
+		TEST_ASSERT(!budget.is_evicting() && budget.get_stats().evicted == 0);
+
+		// Filling the pool again starts the next crossing
+		pool = 0;
+		budget.begin_frame();
+		TEST_ASSERT(budget.is_evicting() && budget.get_stats().episodes == 2);
+
+		vkDestroyBuffer(device.get_device(), buffer, nullptr);
+		device.free_memory(memory);
+		TEST_ASSERT(allocated() == before);
+	});
+
+	RUN_TEST("Testing render targets", [](){
+		using namespace uni;
+		eng::Window window(100, 100, "testing");
+		eng::Device device(window);
+		VkFormat depth = device.find_depth_format();
+		VkFormatProperties properties;
+		vkGetPhysicalDeviceFormatProperties(device.get_physical_device(), depth, &properties);
+		TEST_ASSERT(properties.optimalTilingFeatures & VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT);
+
+		bool threw = false;
+		eng::RenderTargets targets(device);
+		try { targets.add({VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_USAGE_SAMPLED_BIT, VK_SAMPLE_COUNT_1_BIT, 0, 0, true}); } catch(...){ threw = true; }
+		TEST_ASSERT(threw);
+
+		// Pass 0 draws into color and depth, then resolves; pass 1 only needs scratch, which reuses pass 0's memory
+		eng::TargetId color = targets.add({VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT, VK_SAMPLE_COUNT_1_BIT, 0, 0, true});
+		eng::TargetId z = targets.add({depth, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, VK_SAMPLE_COUNT_1_BIT, 0, 0, true});
+		eng::TargetId resolve = targets.add({VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, VK_SAMPLE_COUNT_1_BIT, 0, 1, false});
+		eng::TargetId scratch = targets.add({VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT, VK_SAMPLE_COUNT_1_BIT, 1, 1, true});
+		targets.build(256, 256);
+		const eng::RenderTargetStats& stats = targets.get_stats();
+		TEST_ASSERT(stats.memory_blocks == 3 && stats.allocated_bytes < stats.dedicated_bytes);
+		TEST_ASSERT(targets.get_view(color) != VK_NULL_HANDLE && targets.get_view(scratch) != VK_NULL_HANDLE);
+
+		VkAttachmentDescription transient = targets.describe(z, 0, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
+		TEST_ASSERT(transient.loadOp == VK_ATTACHMENT_LOAD_OP_CLEAR && transient.storeOp == VK_ATTACHMENT_STORE_OP_DONT_CARE);
+		TEST_ASSERT(transient.initialLayout == VK_IMAGE_LAYOUT_UNDEFINED);
+
+		// The persistent resolve is cleared by pass 0 only, pass 1 loads what it left
+		VkAttachmentDescription written = targets.describe(resolve, 0, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+		VkAttachmentDescription loaded = targets.describe(resolve, 1, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+		TEST_ASSERT(written.loadOp == VK_ATTACHMENT_LOAD_OP_CLEAR && written.storeOp == VK_ATTACHMENT_STORE_OP_STORE);
+		TEST_ASSERT(loaded.loadOp == VK_ATTACHMENT_LOAD_OP_LOAD && loaded.initialLayout == VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+		TEST_ASSERT(loaded.storeOp == VK_ATTACHMENT_STORE_OP_STORE);
+
+		// A transient target over two passes is only dropped after the second
+		eng::RenderTargets spanning(device);
+		eng::TargetId both = spanning.add({depth, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, VK_SAMPLE_COUNT_1_BIT, 0, 1, true});
+		TEST_ASSERT(spanning.describe(both, 0, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL).storeOp == VK_ATTACHMENT_STORE_OP_STORE);
+		TEST_ASSERT(spanning.describe(both, 1, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL).loadOp == VK_ATTACHMENT_LOAD_OP_LOAD);
+		TEST_ASSERT(spanning.describe(both, 1, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL).storeOp == VK_ATTACHMENT_STORE_OP_DONT_CARE);
+
+		targets.build(512, 512);
+		TEST_ASSERT(targets.get_extent().width == 512 && targets.get_stats().memory_blocks == 3);
+	});
 	RUN_TEST("Testing pipeline", [](){
 
 	});